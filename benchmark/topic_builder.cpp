@@ -0,0 +1,509 @@
+/*
+
+MQTT TOPIC BUILDER HOST BENCHMARK
+
+Compares topic assembling via Arduino String replacements with assembling
+from cached prefixes into fixed buffer, as used in firmware/fastybird.api.ino
+
+Build & run on host:
+    g++ -O2 -std=c++11 -o topic_builder benchmark/topic_builder.cpp && ./topic_builder
+
+Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
+
+*/
+
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+#define FASTYBIRD_MQTT_BASE_TOPIC                           "/fb/v1"
+#define FASTYBIRD_TOPIC_PART_CHANNEL                        "$channel"
+#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY                    "$property"
+#define FASTYBIRD_TOPIC_SUFFIX_NAME                         "/$name"
+#define FASTYBIRD_TOPIC_SUFFIX_DATA_TYPE                    "/$datatype"
+#define FASTYBIRD_TOPIC_MAX_LENGTH                          128
+
+#define OLD_TOPIC_CHANNEL_PROPERTY_NAME                     "$channel/{channel}/$property/{property}/$name"
+#define OLD_TOPIC_CHANNEL_PROPERTY_DATA_TYPE                "$channel/{channel}/$property/{property}/$datatype"
+
+#define BENCHMARK_ITERATIONS                                200000
+
+// -----------------------------------------------------------------------------
+// Heap allocations counter
+// -----------------------------------------------------------------------------
+
+uint32_t _benchmark_allocations = 0;
+
+void * _benchmarkRealloc(
+    void * buffer,
+    size_t size
+) {
+    _benchmark_allocations++;
+
+    return realloc(buffer, size);
+}
+
+// -----------------------------------------------------------------------------
+// Minimal Arduino String replica, heap buffer is reallocated on every growth
+// -----------------------------------------------------------------------------
+
+class String {
+    public:
+        String() : _buffer(NULL), _length(0) {
+            _copy("", 0);
+        }
+
+        String(const char * value) : _buffer(NULL), _length(0) {
+            _copy(value, strlen(value));
+        }
+
+        String(const String & value) : _buffer(NULL), _length(0) {
+            _copy(value._buffer, value._length);
+        }
+
+        ~String() {
+            free(_buffer);
+        }
+
+        String & operator = (const String & value) {
+            if (this != &value) {
+                _copy(value._buffer, value._length);
+            }
+
+            return *this;
+        }
+
+        String & operator += (const String & value) {
+            _concat(value._buffer, value._length);
+
+            return *this;
+        }
+
+        String & operator += (const char * value) {
+            _concat(value, strlen(value));
+
+            return *this;
+        }
+
+        friend String operator + (const String & left, const String & right) {
+            String result(left);
+
+            result += right;
+
+            return result;
+        }
+
+        friend String operator + (const String & left, const char * right) {
+            String result(left);
+
+            result += right;
+
+            return result;
+        }
+
+        friend String operator + (const char * left, const String & right) {
+            String result(left);
+
+            result += right;
+
+            return result;
+        }
+
+        bool endsWith(const String & suffix) const {
+            return _length >= suffix._length && strcmp(_buffer + _length - suffix._length, suffix._buffer) == 0;
+        }
+
+        void toLowerCase() {
+            for (size_t i = 0; i < _length; i++) {
+                _buffer[i] = tolower(_buffer[i]);
+            }
+        }
+
+        void replace(const String & find, const String & replace) {
+            char * found = strstr(_buffer, find._buffer);
+
+            while (found != NULL) {
+                size_t position = found - _buffer;
+                size_t length = _length - find._length + replace._length;
+
+                char * buffer = (char *) _benchmarkRealloc(NULL, length + 1);
+
+                memcpy(buffer, _buffer, position);
+                memcpy(buffer + position, replace._buffer, replace._length);
+                strcpy(buffer + position + replace._length, found + find._length);
+
+                free(_buffer);
+
+                _buffer = buffer;
+                _length = length;
+
+                found = strstr(_buffer + position + replace._length, find._buffer);
+            }
+        }
+
+        const char * c_str() const {
+            return _buffer;
+        }
+
+    private:
+        void _copy(const char * value, size_t length) {
+            _buffer = (char *) _benchmarkRealloc(_buffer, length + 1);
+            memcpy(_buffer, value, length);
+            _buffer[length] = '\0';
+            _length = length;
+        }
+
+        void _concat(const char * value, size_t length) {
+            _buffer = (char *) _benchmarkRealloc(_buffer, _length + length + 1);
+            memcpy(_buffer + _length, value, length);
+            _length += length;
+            _buffer[_length] = '\0';
+        }
+
+        char * _buffer;
+        size_t _length;
+};
+
+// -----------------------------------------------------------------------------
+// String based topic builder
+// -----------------------------------------------------------------------------
+
+String _oldCreateTopic(
+    String topic
+) {
+    String topic_prefix = FASTYBIRD_MQTT_BASE_TOPIC;
+
+    if (!topic_prefix.endsWith("/")) {
+        topic_prefix = topic_prefix + "/";
+    }
+
+    return topic_prefix + topic;
+}
+
+String _oldCreateDeviceTopic(
+    const char * deviceId
+) {
+    String topic = _oldCreateTopic(String(deviceId));
+
+    if (!topic.endsWith("/")) {
+        topic = topic + "/";
+    }
+
+    topic.toLowerCase();
+
+    return topic;
+}
+
+String _oldCreateChannelTopicString(
+    const char * deviceId,
+    const char * channel,
+    String topic
+) {
+    topic.replace("{channel}", channel);
+
+    return _oldCreateDeviceTopic(deviceId) + topic;
+}
+
+String _oldCreateChannelTopicString(
+    const char * deviceId,
+    const char * channel,
+    String topic,
+    String replace,
+    String replaceWith
+) {
+    topic = _oldCreateChannelTopicString(deviceId, channel, topic);
+    topic.replace("{" + replace + "}", replaceWith);
+
+    return topic;
+}
+
+// -----------------------------------------------------------------------------
+// Cached prefixes topic builder
+// -----------------------------------------------------------------------------
+
+typedef struct {
+    char value[FASTYBIRD_TOPIC_MAX_LENGTH];
+    uint16_t length;
+} fastybird_topic_t;
+
+fastybird_topic_t _fastybird_topic_device_prefix;
+fastybird_topic_t _fastybird_topic_channel_prefix;
+
+uint16_t _fastybird_topic_channel_device_length = 0;
+
+uint16_t _newTopicBaseLength()
+{
+    uint16_t length = strlen(FASTYBIRD_MQTT_BASE_TOPIC);
+
+    if (length > 0 && FASTYBIRD_MQTT_BASE_TOPIC[length - 1] == '/') {
+        return length;
+    }
+
+    return length + 1;
+}
+
+bool _newTopicIsValid(
+    const fastybird_topic_t & topic
+) {
+    return topic.length < FASTYBIRD_TOPIC_MAX_LENGTH;
+}
+
+void _newTopicCopy(
+    fastybird_topic_t & topic,
+    const fastybird_topic_t & prefix
+) {
+    topic.length = prefix.length;
+
+    if (_newTopicIsValid(prefix)) {
+        memcpy(topic.value, prefix.value, prefix.length + 1);
+    }
+}
+
+bool _newTopicAppend(
+    fastybird_topic_t & topic,
+    const char * part,
+    const uint16_t length,
+    const bool lowercase
+) {
+    if ((topic.length + length) >= FASTYBIRD_TOPIC_MAX_LENGTH) {
+        topic.length = FASTYBIRD_TOPIC_MAX_LENGTH;
+
+        return false;
+    }
+
+    if (lowercase) {
+        for (uint16_t i = 0; i < length; i++) {
+            topic.value[topic.length + i] = tolower(part[i]);
+        }
+
+    } else {
+        memcpy(topic.value + topic.length, part, length);
+    }
+
+    topic.length += length;
+    topic.value[topic.length] = '\0';
+
+    return true;
+}
+
+bool _newTopicAppend(
+    fastybird_topic_t & topic,
+    const char * part
+) {
+    return _newTopicAppend(topic, part, strlen(part), false);
+}
+
+bool _newTopicIsDevicePrefix(
+    const fastybird_topic_t & prefix,
+    const char * deviceId
+) {
+    uint16_t base_length = _newTopicBaseLength();
+    uint16_t length = strlen(deviceId);
+
+    uint16_t expected_length = base_length + length + ((length > 0 && deviceId[length - 1] == '/') ? 0 : 1);
+
+    return prefix.length == expected_length
+        && strncasecmp(prefix.value + base_length, deviceId, length) == 0;
+}
+
+void _newTopicCreateDevicePrefix(
+    fastybird_topic_t & prefix,
+    const char * deviceId
+) {
+    prefix.length = 0;
+    prefix.value[0] = '\0';
+
+    _newTopicAppend(prefix, FASTYBIRD_MQTT_BASE_TOPIC, strlen(FASTYBIRD_MQTT_BASE_TOPIC), true);
+
+    if (prefix.length != _newTopicBaseLength()) {
+        _newTopicAppend(prefix, "/");
+    }
+
+    _newTopicAppend(prefix, deviceId, strlen(deviceId), true);
+
+    if (_newTopicIsValid(prefix) && prefix.value[prefix.length - 1] != '/') {
+        _newTopicAppend(prefix, "/");
+    }
+}
+
+const fastybird_topic_t & _newTopicDevicePrefix(
+    const char * deviceId
+) {
+    if (!_newTopicIsDevicePrefix(_fastybird_topic_device_prefix, deviceId)) {
+        _newTopicCreateDevicePrefix(_fastybird_topic_device_prefix, deviceId);
+    }
+
+    return _fastybird_topic_device_prefix;
+}
+
+const fastybird_topic_t & _newTopicChannelPrefix(
+    const char * deviceId,
+    const char * channel
+) {
+    const fastybird_topic_t & device_prefix = _newTopicDevicePrefix(deviceId);
+
+    uint16_t channel_length = strlen(channel);
+    uint16_t part_length = strlen(FASTYBIRD_TOPIC_PART_CHANNEL);
+
+    if (
+        _fastybird_topic_channel_device_length == device_prefix.length
+        && _fastybird_topic_channel_prefix.length == (device_prefix.length + part_length + channel_length + 2)
+        && memcmp(_fastybird_topic_channel_prefix.value, device_prefix.value, device_prefix.length) == 0
+        && memcmp(_fastybird_topic_channel_prefix.value + device_prefix.length + part_length + 1, channel, channel_length) == 0
+    ) {
+        return _fastybird_topic_channel_prefix;
+    }
+
+    _newTopicCopy(_fastybird_topic_channel_prefix, device_prefix);
+
+    _newTopicAppend(_fastybird_topic_channel_prefix, FASTYBIRD_TOPIC_PART_CHANNEL, part_length, false);
+    _newTopicAppend(_fastybird_topic_channel_prefix, "/");
+    _newTopicAppend(_fastybird_topic_channel_prefix, channel, channel_length, false);
+    _newTopicAppend(_fastybird_topic_channel_prefix, "/");
+
+    _fastybird_topic_channel_device_length = device_prefix.length;
+
+    return _fastybird_topic_channel_prefix;
+}
+
+bool _newCreateChannelTopic(
+    fastybird_topic_t & topic,
+    const char * deviceId,
+    const char * channel,
+    const char * part,
+    const char * name,
+    const char * suffix
+) {
+    _newTopicCopy(topic, _newTopicChannelPrefix(deviceId, channel));
+
+    _newTopicAppend(topic, part);
+    _newTopicAppend(topic, "/");
+    _newTopicAppend(topic, name);
+    _newTopicAppend(topic, suffix);
+
+    return _newTopicIsValid(topic);
+}
+
+// -----------------------------------------------------------------------------
+// Benchmark
+// -----------------------------------------------------------------------------
+
+// Advertisement like sequence, several topics for each channel property
+const char * _benchmark_devices[] = { "A1B2C3D4", "node-serial-01" };
+const char * _benchmark_channels[] = { "switch", "sensor" };
+const char * _benchmark_properties[] = { "state", "temperature", "humidity" };
+
+uint32_t _benchmark_checksum = 0;
+
+void _benchmarkConsume(
+    const char * topic
+) {
+    _benchmark_checksum += (uint8_t) topic[strlen(topic) - 1];
+}
+
+template<typename builder_f>
+double _benchmarkRun(
+    const char * name,
+    builder_f builder
+) {
+    _benchmark_allocations = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    uint32_t topics = 0;
+
+    for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        const char * device = _benchmark_devices[(i / 12) % 2];
+        const char * channel = _benchmark_channels[(i / 6) % 2];
+        const char * property = _benchmark_properties[(i / 2) % 3];
+
+        builder(device, channel, property, (i % 2) == 0);
+
+        topics++;
+    }
+
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    printf(
+        "%-24s %10.1f ns/topic %10.2f allocations/topic\n",
+        name,
+        elapsed / topics,
+        (double) _benchmark_allocations / topics
+    );
+
+    return elapsed;
+}
+
+int main()
+{
+    // Both builders have to create same topics
+    for (uint8_t i = 0; i < 2; i++) {
+        String old_topic = _oldCreateChannelTopicString(
+            _benchmark_devices[i],
+            _benchmark_channels[i],
+            OLD_TOPIC_CHANNEL_PROPERTY_NAME,
+            "property",
+            _benchmark_properties[i]
+        );
+
+        fastybird_topic_t new_topic;
+
+        _newCreateChannelTopic(
+            new_topic,
+            _benchmark_devices[i],
+            _benchmark_channels[i],
+            FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+            _benchmark_properties[i],
+            FASTYBIRD_TOPIC_SUFFIX_NAME
+        );
+
+        if (strcmp(old_topic.c_str(), new_topic.value) != 0) {
+            printf("Topics differ: %s <> %s\n", old_topic.c_str(), new_topic.value);
+
+            return 1;
+        }
+
+        printf("%s\n", new_topic.value);
+    }
+
+    double old_elapsed = _benchmarkRun(
+        "String replace",
+        [](const char * device, const char * channel, const char * property, bool name) {
+            String topic = _oldCreateChannelTopicString(
+                device,
+                channel,
+                name ? OLD_TOPIC_CHANNEL_PROPERTY_NAME : OLD_TOPIC_CHANNEL_PROPERTY_DATA_TYPE,
+                "property",
+                property
+            );
+
+            _benchmarkConsume(topic.c_str());
+        }
+    );
+
+    double new_elapsed = _benchmarkRun(
+        "Cached prefix buffer",
+        [](const char * device, const char * channel, const char * property, bool name) {
+            fastybird_topic_t topic;
+
+            if (_newCreateChannelTopic(
+                topic,
+                device,
+                channel,
+                FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+                property,
+                name ? FASTYBIRD_TOPIC_SUFFIX_NAME : FASTYBIRD_TOPIC_SUFFIX_DATA_TYPE
+            )) {
+                _benchmarkConsume(topic.value);
+            }
+        }
+    );
+
+    printf("Speedup: %.1fx (checksum %u)\n", old_elapsed / new_elapsed, _benchmark_checksum);
+
+    return 0;
+}
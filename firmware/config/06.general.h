@@ -85,6 +85,10 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
     #define LOADAVG_INTERVAL                30000                               // Interval between calculating load average (in ms)
 #endif
 
+#ifndef LOOPRATE_INTERVAL
+    #define LOOPRATE_INTERVAL               1000                                // Interval between calculating loop rate (in ms)
+#endif
+
 // -----------------------------------------------------------------------------
 // SPIFFS
 // -----------------------------------------------------------------------------
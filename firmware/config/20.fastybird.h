@@ -87,6 +87,8 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 #define FASTYBIRD_PROPERTY_BUTTON                           "button"
 #define FASTYBIRD_PROPERTY_SWITCH                           "switch"
 #define FASTYBIRD_PROPERTY_STATE                            "state"
+#define FASTYBIRD_PROPERTY_TIMESTAMP                        "timestamp"
+#define FASTYBIRD_PROPERTY_POLL_INTERVAL                    "poll-interval"
 
 #define FASTYBIRD_HARDWARE_MAC_ADDRESS                      "mac-address"
 
@@ -232,51 +234,73 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
 // -----------------------------------------------------------------------------
 // FASTYBIRD - MQTT API device topics
+// Relative to device prefix: <base>/<device>/
 // -----------------------------------------------------------------------------
 
 #define FASTYBIRD_TOPIC_DEVICE_NAME                         "$name"
 #define FASTYBIRD_TOPIC_DEVICE_PARENT                       "$parent"
 #define FASTYBIRD_TOPIC_DEVICE_PROPERTIES_STRUCTURE         "$properties"
-#define FASTYBIRD_TOPIC_DEVICE_HW_INFO                      "$hw/{hw}"
-#define FASTYBIRD_TOPIC_DEVICE_FW_INFO                      "$fw/{fw}"
+#define FASTYBIRD_TOPIC_DEVICE_HW_INFO                      "$hw"                   // $hw/<field>
+#define FASTYBIRD_TOPIC_DEVICE_FW_INFO                      "$fw"                   // $fw/<field>
 #define FASTYBIRD_TOPIC_DEVICE_CHANNELS                     "$channels"
 #define FASTYBIRD_TOPIC_DEVICE_STATE                        "$state"
 
-#define FASTYBIRD_TOPIC_DEVICE_PROPERTY                     "$property/{property}"
-#define FASTYBIRD_TOPIC_DEVICE_PROPERTY_NAME                "$property/{property}/$name"
-#define FASTYBIRD_TOPIC_DEVICE_PROPERTY_SETTABLE            "$property/{property}/$settable"
-#define FASTYBIRD_TOPIC_DEVICE_PROPERTY_QUERYABLE           "$property/{property}/$queryable"
-#define FASTYBIRD_TOPIC_DEVICE_PROPERTY_DATA_TYPE           "$property/{property}/$data-type"
-#define FASTYBIRD_TOPIC_DEVICE_PROPERTY_FORMAT              "$property/{property}/$format"
-#define FASTYBIRD_TOPIC_DEVICE_PROPERTY_RECEIVE             "$property/{property}/set"
-#define FASTYBIRD_TOPIC_DEVICE_PROPERTY_QUERY               "$property/{property}/query"
-
-#define FASTYBIRD_TOPIC_DEVICE_CONTROL                      "$control"
-#define FASTYBIRD_TOPIC_DEVICE_CONTROL_DATA                 "$control/{control}"
-#define FASTYBIRD_TOPIC_DEVICE_CONTROL_SCHEMA               "$control/{control}/$schema"
-#define FASTYBIRD_TOPIC_DEVICE_CONTROL_RECEIVE              "$control/{control}/set"
+#define FASTYBIRD_TOPIC_DEVICE_PROPERTY                     "$property"             // $property/<property>
+#define FASTYBIRD_TOPIC_DEVICE_CONTROL                      "$control"              // $control/<control>
 
 // -----------------------------------------------------------------------------
 // FASTYBIRD - MQTT API channel topics
+// Relative to channel prefix: <base>/<device>/$channel/<channel>/
 // -----------------------------------------------------------------------------
 
-#define FASTYBIRD_TOPIC_CHANNEL_NAME		                "$channel/{channel}/$name"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTIES		            "$channel/{channel}/$properties"
+#define FASTYBIRD_TOPIC_CHANNEL_NAME                        "$name"
+#define FASTYBIRD_TOPIC_CHANNEL_PROPERTIES                  "$properties"
+
+#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY                    "$property"             // $property/<property>
+#define FASTYBIRD_TOPIC_CHANNEL_CONTROL                     "$control"              // $control/<control>
 
-#define FASTYBIRD_TOPIC_CHANNEL_CONTROL                     "$channel/{channel}/$control"
-#define FASTYBIRD_TOPIC_CHANNEL_CONTROL_DATA                "$channel/{channel}/$control/{control}"
-#define FASTYBIRD_TOPIC_CHANNEL_CONTROL_SCHEMA              "$channel/{channel}/$control/{control}/$schema"
-#define FASTYBIRD_TOPIC_CHANNEL_CONTROL_RECEIVE             "$channel/{channel}/$control/{control}/set"
+// -----------------------------------------------------------------------------
+// FASTYBIRD - MQTT API topics suffixes
+// Appended after property or control name
+// -----------------------------------------------------------------------------
 
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY                    "$channel/{channel}/$property/{property}"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY_NAME               "$channel/{channel}/$property/{property}/$name"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY_SETTABLE           "$channel/{channel}/$property/{property}/$settable"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY_QUERYABLE          "$channel/{channel}/$property/{property}/$queryable"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY_DATA_TYPE          "$channel/{channel}/$property/{property}/$datatype"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY_FORMAT             "$channel/{channel}/$property/{property}/$format"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY_UNIT               "$channel/{channel}/$property/{property}/$unit"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY_RECEIVE            "$channel/{channel}/$property/{property}/set"
-#define FASTYBIRD_TOPIC_CHANNEL_PROPERTY_QUERY              "$channel/{channel}/$property/{property}/query"
+#define FASTYBIRD_TOPIC_SUFFIX_NONE                         ""
+#define FASTYBIRD_TOPIC_SUFFIX_NAME                         "/$name"
+#define FASTYBIRD_TOPIC_SUFFIX_SETTABLE                     "/$settable"
+#define FASTYBIRD_TOPIC_SUFFIX_QUERYABLE                    "/$queryable"
+#define FASTYBIRD_TOPIC_SUFFIX_DATA_TYPE                    "/$datatype"
+#define FASTYBIRD_TOPIC_SUFFIX_FORMAT                       "/$format"
+#define FASTYBIRD_TOPIC_SUFFIX_UNIT                         "/$unit"
+#define FASTYBIRD_TOPIC_SUFFIX_SCHEMA                       "/$schema"
+#define FASTYBIRD_TOPIC_SUFFIX_RECEIVE                      "/set"
+#define FASTYBIRD_TOPIC_SUFFIX_QUERY                        "/query"
+
+#ifndef FASTYBIRD_TOPIC_MAX_LENGTH
+    #define FASTYBIRD_TOPIC_MAX_LENGTH                      128                     // Size of topic buffer including terminating character
+#endif
+
+// -----------------------------------------------------------------------------
+// FASTYBIRD - MQTT API in topic keywords
+// Identifiers of keywords in received topic parts
+// -----------------------------------------------------------------------------
+
+#define FASTYBIRD_TOPIC_KEYWORD_NONE                        0
+#define FASTYBIRD_TOPIC_KEYWORD_BROADCAST                   1
+#define FASTYBIRD_TOPIC_KEYWORD_PROPERTY                    2
+#define FASTYBIRD_TOPIC_KEYWORD_CONTROL                     3
+#define FASTYBIRD_TOPIC_KEYWORD_CHANNEL                     4
+#define FASTYBIRD_TOPIC_KEYWORD_SET                         5
+#define FASTYBIRD_TOPIC_KEYWORD_QUERY                       6
+#define FASTYBIRD_TOPIC_KEYWORD_INIT                        7
+
+#define FASTYBIRD_TOPIC_KEYWORDS_TABLE_MAX_SIZE             64                      // Keywords hash table is searched for collision free size up to this limit
+
+// -----------------------------------------------------------------------------
+// FASTYBIRD - Registries name lookup indexes
+// -----------------------------------------------------------------------------
+
+#define FASTYBIRD_INDEX_EMPTY                               0xFFFF                  // Not used slot of name lookup index
+#define FASTYBIRD_INDEX_MIN_SIZE                            8                       // Index size is power of two and index is kept at most half full
 
 // -----------------------------------------------------------------------------
 // FASTYBIRD - MQTT API in topic part count
@@ -286,6 +310,7 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 #define FASTYBIRD_TOPIC_PART_COUNT_DEVICE_CONTROL           6
 #define FASTYBIRD_TOPIC_PART_COUNT_CHANNEL_PROPERTY         8
 #define FASTYBIRD_TOPIC_PART_COUNT_CHANNEL_CONTROL          8
+#define FASTYBIRD_TOPIC_PART_COUNT_MAX                      8                       // Longer topics are not handled
 
 // -----------------------------------------------------------------------------
 // FASTYBIRD - MQTT API in topic part positions
@@ -391,8 +416,6 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 // -----------------------------------------------------------------------------
 
 #if FASTYBIRD_SUPPORT
-    #include <Regexp.h>
-
     // PROPERTIES
     typedef std::function<void(const uint8_t, const uint8_t, const char *)> fastybird_properties_process_payload_f;
     typedef std::function<void(const uint8_t, const uint8_t)> fastybird_properties_process_query_f;
@@ -410,6 +433,8 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
         fastybird_properties_process_payload_f payload_callback;
         fastybird_properties_process_query_f query_callback;
+
+        uint32_t hash; // Lowercase name hash used by lookups
     } fastybird_property_t;
 
 // -----------------------------------------------------------------------------
@@ -429,6 +454,8 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
         // Properties mapping via array indexes
         std::vector<uint8_t> properties;
+
+        uint32_t hash; // Lowercase name hash used by lookups
     } fastybird_channel_t;
 
 // -----------------------------------------------------------------------------
@@ -470,6 +497,8 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
             fastybird_node_properties_process_payload_f payload_callback;
             fastybird_node_properties_process_query_f query_callback;
+
+            uint32_t hash; // Lowercase name hash used by lookups
         } fastybird_node_property_t;
 
 // -----------------------------------------------------------------------------
@@ -480,6 +509,8 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
             // Properties mapping via array indexes
             std::vector<uint8_t> properties;
+
+            uint32_t hash; // Lowercase name hash used by lookups
         } fastybird_node_channel_t;
         
 // -----------------------------------------------------------------------------
@@ -515,6 +546,8 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
             // Node channels
             std::vector<uint8_t> channels;
+
+            uint32_t hash; // Lowercase serial number hash used by lookups
         } fastybird_node_t;
     #else
         #define fastybird_node_t void *
@@ -524,4 +557,25 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
         #define fastybird_node_properties_process_payload_f void *
         #define fastybird_node_properties_process_query_f void *
     #endif // FASTYBIRD_NODES_SUPPORT
+
+// -----------------------------------------------------------------------------
+
+    // NAME LOOKUP INDEX
+    // Open addressing table keyed by stored names hashes, slots hold entry index or owner & entry index pair
+    typedef std::vector<uint16_t> fastybird_index_t;
+
+// -----------------------------------------------------------------------------
+
+    // MQTT TOPIC
+    typedef struct {
+        char value[FASTYBIRD_TOPIC_MAX_LENGTH];
+        uint16_t length; // FASTYBIRD_TOPIC_MAX_LENGTH when topic did not fit into buffer
+    } fastybird_topic_t;
+
+    // RECEIVED MQTT TOPIC PART
+    typedef struct {
+        const char * value; // Points into received topic, is not null terminated
+        uint8_t length;
+        uint8_t keyword;    // FASTYBIRD_TOPIC_KEYWORD_* identifier
+    } fastybird_topic_part_t;
 #endif
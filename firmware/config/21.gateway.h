@@ -28,8 +28,32 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
     #define FB_GATEWAY_MASTER_ID                    254
 #endif
 
+#ifndef FB_GATEWAY_RX_BUFFER_SIZE
+    #define FB_GATEWAY_RX_BUFFER_SIZE               256             // Bus bytes buffered by serial RX interrupt between two gateway loops
+#endif
+
+#ifndef FB_GATEWAY_RECEIVE_ATTEMPTS
+    #define FB_GATEWAY_RECEIVE_ATTEMPTS             4               // Maximum bus reception attempts in one gateway loop
+#endif
+
 #ifndef FB_GATEWAY_MAX_NODES
-    #define FB_GATEWAY_MAX_NODES                    10              // Define maximum slave nodes count that could connect to the master
+    #define FB_GATEWAY_MAX_NODES                    250             // Define maximum slave nodes count that could connect to the master
+#endif
+
+#ifndef FB_GATEWAY_MAX_ADDRESS
+    #define FB_GATEWAY_MAX_ADDRESS                  253             // Highest bus address which could be assigned to node
+#endif
+
+#ifndef FB_GATEWAY_NODE_RAM_BUDGET
+    #define FB_GATEWAY_NODE_RAM_BUDGET              64              // Static RAM in bytes reserved for one node slot
+#endif
+
+#ifndef FB_GATEWAY_NODE_DETAILS_RAM_BUDGET
+    #define FB_GATEWAY_NODE_DETAILS_RAM_BUDGET      288             // Heap RAM in bytes allocated for connected node details (registers values excluded)
+#endif
+
+#ifndef FB_GATEWAY_RAM_BUDGET
+    #define FB_GATEWAY_RAM_BUDGET                   16384           // Static RAM in bytes reserved for all node slots & address map
 #endif
 
 #ifndef FB_GATEWAY_MAX_SENDING_FAILURES
@@ -37,11 +61,27 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 #endif
 
 #ifndef FB_GATEWAY_LOST_DELAY
-    #define FB_GATEWAY_LOST_DELAY                   15000           // Delay in ms after reaching maximum packet sendings attempts
+    #define FB_GATEWAY_LOST_DELAY                   15000           // Maximal delay in ms between lost node probes
+#endif
+
+#ifndef FB_GATEWAY_LOST_DELAY_MIN
+    #define FB_GATEWAY_LOST_DELAY_MIN               500             // Delay in ms before first lost node probe, doubled with every next probe
+#endif
+
+#ifndef FB_GATEWAY_SEARCH_SLOT_LENGTH
+    #define FB_GATEWAY_SEARCH_SLOT_LENGTH           25              // Length in ms of one reply slot after GATEWAY_PACKET_SEARCH_NODES broadcast
+#endif
+
+#ifndef FB_GATEWAY_SEARCH_SLOTS_MIN
+    #define FB_GATEWAY_SEARCH_SLOTS_MIN             4               // Minimal count of reply slots in one searching round
+#endif
+
+#ifndef FB_GATEWAY_SEARCH_SLOTS_MAX
+    #define FB_GATEWAY_SEARCH_SLOTS_MAX             64              // Maximal count of reply slots in one searching round
 #endif
 
-#ifndef FB_GATEWAY_SEARCH_NODES_BROADCAST_TIME
-    #define FB_GATEWAY_SEARCH_NODES_BROADCAST_TIME  1000            // Master reception time during GATEWAY_ACQUIRE_ADDRESS_LIST broadcast (250 milliseconds)
+#ifndef FB_GATEWAY_ADDRESS_CONFIRM_TIME
+    #define FB_GATEWAY_ADDRESS_CONFIRM_TIME         500             // Time reserved for node to store and confirm assigned address
 #endif
 
 #ifndef FB_GATEWAY_NODES_BUFFER_FULL
@@ -64,6 +104,122 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
     #define FB_GATEWAY_SEARCHING_WAITING_TIMEOUT    4000            // After timeout is reached, gateway discard node reserved slot
 #endif
 
+#ifndef FB_GATEWAY_RESPONSE_TIMEOUT
+    #define FB_GATEWAY_RESPONSE_TIMEOUT             100             // Initial time in ms reserved for node reply, before node round-trip time is measured
+#endif
+
+#ifndef FB_GATEWAY_RESPONSE_TIMEOUT_MIN
+    #define FB_GATEWAY_RESPONSE_TIMEOUT_MIN         20              // Lower limit of computed node reply timeout
+#endif
+
+#ifndef FB_GATEWAY_RESPONSE_TIMEOUT_MAX
+    #define FB_GATEWAY_RESPONSE_TIMEOUT_MAX         1000            // Upper limit of computed node reply timeout
+#endif
+
+#ifndef FB_GATEWAY_RETRY_BACKOFF_MAX
+    #define FB_GATEWAY_RETRY_BACKOFF_MAX            4               // Maximal exponent of retry delay backoff (timeout * 2^n)
+#endif
+
+#ifndef FB_GATEWAY_MAX_IN_FLIGHT
+    #define FB_GATEWAY_MAX_IN_FLIGHT                4               // Maximum count of requests waiting for reply at the same time
+#endif
+
+#ifndef FB_GATEWAY_RESERVED_IN_FLIGHT
+    #define FB_GATEWAY_RESERVED_IN_FLIGHT           1               // Requests in flight slots kept free for control writes & queries
+#endif
+
+#ifndef FB_GATEWAY_REQUESTS_QUEUE_SIZE
+    #define FB_GATEWAY_REQUESTS_QUEUE_SIZE          16              // Maximum count of nodes waiting for control write or query in each priority class
+#endif
+
+#ifndef FB_GATEWAY_READING_PROBES
+    #define FB_GATEWAY_READING_PROBES               2               // Unanswered combined or changes reading requests before node is read space by space
+#endif
+
+#ifndef FB_GATEWAY_SEQUENCING_PROBES
+    #define FB_GATEWAY_SEQUENCING_PROBES            2               // Unanswered sequencing PING probes before node is handled as not echoing sequence byte
+#endif
+
+#ifndef FB_GATEWAY_DELTA_READING
+    #define FB_GATEWAY_DELTA_READING                1               // Read only registers changed since last reading from nodes supporting it
+#endif
+
+#ifndef FB_GATEWAY_REPORT_INTERVAL
+    #define FB_GATEWAY_REPORT_INTERVAL              250             // Interval in ms between windows for changes pushed by nodes, 0 disables reporting
+#endif
+
+#ifndef FB_GATEWAY_REPORT_SLOT_LENGTH
+    #define FB_GATEWAY_REPORT_SLOT_LENGTH           10              // Length in ms of one node slot in reporting window
+#endif
+
+#ifndef FB_GATEWAY_REPORT_SLOTS_MAX
+    #define FB_GATEWAY_REPORT_SLOTS_MAX             16              // Maximal count of nodes slots in one reporting window
+#endif
+
+#ifndef FB_GATEWAY_WRITE_QUEUE_SIZE
+    #define FB_GATEWAY_WRITE_QUEUE_SIZE             8               // Maximum count of different registers waiting for writing into one node
+#endif
+
+#ifndef FB_GATEWAY_SEND_TIMEOUT
+    #define FB_GATEWAY_SEND_TIMEOUT                 500             // Time in ms for queued packet to be transmitted & acknowledged on bus
+#endif
+
+#ifndef FB_GATEWAY_IDLE_INTERVAL
+    #define FB_GATEWAY_IDLE_INTERVAL                1000            // Interval in ms for checking nodes without any pending job
+#endif
+
+#ifndef FB_GATEWAY_POLL_INTERVAL_DI
+    #define FB_GATEWAY_POLL_INTERVAL_DI             100             // Default & minimal polling interval in ms for digital inputs registers
+#endif
+
+#ifndef FB_GATEWAY_POLL_INTERVAL_DO
+    #define FB_GATEWAY_POLL_INTERVAL_DO             250             // Default & minimal polling interval in ms for digital outputs registers
+#endif
+
+#ifndef FB_GATEWAY_POLL_INTERVAL_AI
+    #define FB_GATEWAY_POLL_INTERVAL_AI             1000            // Default & minimal polling interval in ms for analog inputs registers
+#endif
+
+#ifndef FB_GATEWAY_POLL_INTERVAL_AO
+    #define FB_GATEWAY_POLL_INTERVAL_AO             1000            // Default & minimal polling interval in ms for analog outputs registers
+#endif
+
+#ifndef FB_GATEWAY_POLL_INTERVAL_EV
+    #define FB_GATEWAY_POLL_INTERVAL_EV             100             // Default & minimal polling interval in ms for event inputs registers
+#endif
+
+#ifndef FB_GATEWAY_POLL_ADAPTIVE
+    #define FB_GATEWAY_POLL_ADAPTIVE                1               // Slow down polling of registers spaces which are not changing
+#endif
+
+#ifndef FB_GATEWAY_POLL_INTERVAL_MAX
+    #define FB_GATEWAY_POLL_INTERVAL_MAX            10000           // Maximal adaptive polling interval in ms
+#endif
+
+#ifndef FB_GATEWAY_POLL_INTERVAL_GROWTH
+    #define FB_GATEWAY_POLL_INTERVAL_GROWTH         50              // Adaptive polling interval growth in % after reading without any change
+#endif
+
+#ifndef FB_GATEWAY_DEADBAND_ABSOLUTE
+    #define FB_GATEWAY_DEADBAND_ABSOLUTE            0               // Default absolute change of analog register value to be reported, 0 reports every change
+#endif
+
+#ifndef FB_GATEWAY_DEADBAND_PERCENT
+    #define FB_GATEWAY_DEADBAND_PERCENT             0               // Default change in % of last reported analog register value to be reported
+#endif
+
+#ifndef FB_GATEWAY_DEADBAND_MIN_INTERVAL
+    #define FB_GATEWAY_DEADBAND_MIN_INTERVAL        0               // Default minimal interval in ms between two reports of analog register
+#endif
+
+#ifndef FB_GATEWAY_DEADBAND_MAX_INTERVAL
+    #define FB_GATEWAY_DEADBAND_MAX_INTERVAL        0               // Default interval in ms for reporting unchanged analog register as heartbeat, 0 disables heartbeat
+#endif
+
+#ifndef FB_GATEWAY_DEADBAND_CHECK_INTERVAL
+    #define FB_GATEWAY_DEADBAND_CHECK_INTERVAL      100             // Interval in ms for checking postponed & heartbeat reports of analog registers
+#endif
+
 #ifndef FB_GATEWAY_WEB_API_CONFIGURATION
     #define FB_GATEWAY_WEB_API_CONFIGURATION        "/control/gateway-configuration"    //
 #endif
@@ -93,8 +249,6 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 #define GATEWAY_PACKET_NODE_ADDRESS_CONFIRM         0x04
 #define GATEWAY_PACKET_ADDRESS_DISCARD              0x05
 
-#define GATEWAY_PACKET_SEARCH_MAX                   5
-
 // Node initialization
 #define GATEWAY_PACKET_HW_MODEL                     0x11
 #define GATEWAY_PACKET_HW_MANUFACTURER              0x12
@@ -106,8 +260,6 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 #define GATEWAY_PACKET_AI_REGISTERS_STRUCTURE       0x18
 #define GATEWAY_PACKET_AO_REGISTERS_STRUCTURE       0x19
 
-#define GATEWAY_PACKET_NODE_INIT_MAX                9
-
 // Registers reading
 #define GATEWAY_PACKET_READ_SINGLE_DI               0x21   // Master requested DI one regiter reading
 #define GATEWAY_PACKET_READ_MULTI_DI                0x22   // Master requested DI multiple regiters reading
@@ -119,8 +271,15 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 #define GATEWAY_PACKET_READ_MULTI_AO                0x28   // Master requested AO multiple regiters reading
 #define GATEWAY_PACKET_READ_SINGLE_EV               0x29   // Master requested EV one regiter reading
 #define GATEWAY_PACKET_READ_MULTI_EV                0x2A   // Master requested EV multiple regiters reading
+#define GATEWAY_PACKET_READ_COMBINED                0x2B   // Master requested registers ranges reading from several spaces at once
+#define GATEWAY_PACKET_READ_CHANGES                 0x2C   // Master requested registers changed since given change sequence
 
-#define GATEWAY_PACKET_REGISTERS_READING_MAX        10
+// Registers reporting
+#define GATEWAY_PACKET_REPORT_WINDOW                0x2D   // Master opened slots for nodes reports
+#define GATEWAY_PACKET_REPORT_CHANGES               0x2E   // Node reported its changed registers in its slot
+
+// Events queue reading
+#define GATEWAY_PACKET_READ_EVENTS                  0x2F   // Master requested draining of node EV events queue
 
 // Registers writing
 #define GATEWAY_PACKET_WRITE_ONE_DO                 0x31
@@ -128,15 +287,61 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 #define GATEWAY_PACKET_WRITE_MULTI_DO               0x33
 #define GATEWAY_PACKET_WRITE_MULTI_AO               0x34
 
-#define GATEWAY_PACKET_REGISTERS_WRITING_MAX        4
-
 // Misc communication
 #define GATEWAY_PACKET_PING                         0x41
 #define GATEWAY_PACKET_PONG                         0x42
 #define GATEWAY_PACKET_HELLO                        0x43
 #define GATEWAY_PACKET_NONE                         0xFF
 
-#define GATEWAY_PACKET_MISC_MAX                     4
+// -----------------------------------------------------------------------------
+// GATEWAY - Received packets expected states
+// -----------------------------------------------------------------------------
+
+#define GATEWAY_PACKET_EXPECT_ANY                   0x00    // Packet could be sent by unaddressed node
+#define GATEWAY_PACKET_EXPECT_NODE                  0x01    // Packet sender have to be known node
+#define GATEWAY_PACKET_EXPECT_REPLY                 0x02    // Packet have to match request in flight
+
+// -----------------------------------------------------------------------------
+// GATEWAY - Traffic priority classes
+// -----------------------------------------------------------------------------
+
+#define GATEWAY_PRIORITY_CONTROL                    0       // Registers writing requested by user
+#define GATEWAY_PRIORITY_QUERY                      1       // Registers reading requested by user
+#define GATEWAY_PRIORITY_POLLING                    2       // Periodical registers reading & nodes checking
+#define GATEWAY_PRIORITY_INITIALIZATION             3       // Nodes descriptions & registers structure reading
+#define GATEWAY_PRIORITY_DISCOVERY                  4       // Searching for new nodes
+
+#define GATEWAY_PRIORITY_REQUESTED                  2       // Classes below are requested jobs, served before timed jobs
+
+// -----------------------------------------------------------------------------
+// GATEWAY - Sent packets results
+// -----------------------------------------------------------------------------
+
+#define GATEWAY_SEND_SUCCESS                        0x00    // Packet was transmitted & acknowledged by node
+#define GATEWAY_SEND_FAILED                         0x01    // Packet was not acknowledged after all bus attempts
+#define GATEWAY_SEND_TIMEOUT                        0x02    // Packet was not transmitted in FB_GATEWAY_SEND_TIMEOUT
+
+// -----------------------------------------------------------------------------
+// GATEWAY - Nodes searching states
+// -----------------------------------------------------------------------------
+
+#define GATEWAY_SEARCH_STATE_IDLE                   0
+#define GATEWAY_SEARCH_STATE_BROADCAST              1
+#define GATEWAY_SEARCH_STATE_COLLECTING             2
+#define GATEWAY_SEARCH_STATE_ASSIGNING              3
+
+// -----------------------------------------------------------------------------
+// GATEWAY - Nodes reporting states
+// -----------------------------------------------------------------------------
+
+#define GATEWAY_REPORT_STATE_IDLE                   0
+#define GATEWAY_REPORT_STATE_COLLECTING             1
+
+// -----------------------------------------------------------------------------
+// GATEWAY - Nodes slots
+// -----------------------------------------------------------------------------
+
+#define GATEWAY_NODE_SLOT_PARK_TIME                 0x3FFFFFFF      // Not used node slot is scheduled this far into the future
 
 // -----------------------------------------------------------------------------
 // GATEWAY - Registers datatypes
@@ -163,12 +368,41 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 #define GATEWAY_REGISTER_AO                         3
 #define GATEWAY_REGISTER_EV                         4
 
+#define GATEWAY_REGISTER_MAX                        5
+
+#define GATEWAY_REGISTER_ANALOG_VALUE_SIZE          4               // Analog register value space, fits every analog datatype
+
+// -----------------------------------------------------------------------------
+// GATEWAY - Optional registers reading packets support
+// -----------------------------------------------------------------------------
+
+#define GATEWAY_READING_SUPPORT_UNKNOWN             0       // Node did not answer optional reading packet yet
+#define GATEWAY_READING_SUPPORTED                   1
+#define GATEWAY_READING_UNSUPPORTED                 2
+
+#define GATEWAY_DELTA_READING_RESYNC                0xFF    // Changes count in reply when node history does not cover requested sequence
+#define GATEWAY_DELTA_READING_MORE                  0x80    // Changes count flag when reply did not fit all changes
+#define GATEWAY_DELTA_READING_COUNT                 0x7F    // Changes count mask
+
+#define GATEWAY_EVENTS_READING_MORE                 0x80    // Events count flag when reply did not fit all queued events
+#define GATEWAY_EVENTS_READING_COUNT                0x7F    // Events count mask
+
+// -----------------------------------------------------------------------------
+// GATEWAY - Analog registers report by exception
+// -----------------------------------------------------------------------------
+
+#define GATEWAY_DEADBAND_FLAG_OVERRIDE              0x01    // Register has own settings, defaults are not applied
+#define GATEWAY_DEADBAND_FLAG_REPORTED              0x02    // Register value was already reported
+#define GATEWAY_DEADBAND_FLAG_PENDING               0x04    // Value crossed deadband during minimal report interval
+
 // -----------------------------------------------------------------------------
 // GATEWAY - Registers misc
 // -----------------------------------------------------------------------------
 
 #define GATEWAY_DESCRIPTION_NOT_SET                 "none"
 
+#define GATEWAY_REGISTER_VALUE_FORMAT_LENGTH        48              // Buffer length for register value formatted as text, fits float32 extremes
+
 // -----------------------------------------------------------------------------
 // GATEWAY - Prototypes
 // -----------------------------------------------------------------------------
@@ -180,6 +414,11 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
         #define PJON_PACKET_MAX_LENGTH 80
     #endif
 
+    // Every request in flight and one broadcast could be queued at the same time
+    #ifndef PJON_MAX_PACKETS
+        #define PJON_MAX_PACKETS (FB_GATEWAY_MAX_IN_FLIGHT + 1)
+    #endif
+
     #include <PJON.h>
 
     //#define TSA_RESPONSE_TIME_OUT 20000
@@ -190,100 +429,232 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
         char    version[10]         = GATEWAY_DESCRIPTION_NOT_SET;
     };
 
-    struct gateway_node_t {
-        // Node is ready for data exchange flag
-        bool ready = false;
-
-        // Lost communication timestamp
-        uint32_t lost = 0;
-
-        // Node unique identifier
-        char serial_number[15] = GATEWAY_DESCRIPTION_NOT_SET;
-
-        gateway_node_description_t hardware;
-        gateway_node_description_t firmware;
-    };
-
     struct gateway_register_reading_t {
         uint8_t     register_type   = GATEWAY_REGISTER_NONE;
         uint8_t     start           = 0;
+        uint8_t     combined        = GATEWAY_READING_SUPPORT_UNKNOWN;      // Node support of GATEWAY_PACKET_READ_COMBINED
+        uint8_t     combined_probes = 0;
+        uint8_t     delta           = GATEWAY_READING_SUPPORT_UNKNOWN;      // Node support of GATEWAY_PACKET_READ_CHANGES
+        uint8_t     delta_probes    = 0;
+        bool        synchronized    = false;                                // Stored values are complete up to change sequence
+        uint16_t    sequence        = 0;                                    // Last change sequence received from node
     };
 
-    typedef struct {
-        uint8_t         datatype;
-        uint8_t         size;
-        char            value[4];
-    } gateway_register_t;
+    // EV registers events queue draining state
+    struct gateway_register_events_t {
+        uint8_t     support         = GATEWAY_READING_SUPPORT_UNKNOWN;      // Node support of GATEWAY_PACKET_READ_EVENTS
+        uint8_t     probes          = 0;
+        bool        synchronized    = false;                                // Next expected event sequence is known
+        uint8_t     sequence        = 0;                                    // Sequence of next expected event from node queue
+    };
 
+    // Report by exception settings & state of analog register
+    struct gateway_register_deadband_t {
+        float       absolute            = FB_GATEWAY_DEADBAND_ABSOLUTE;         // Absolute change of value to be reported
+        float       reported            = 0;                                    // Last reported value
+        uint32_t    reported_time       = 0;                                    // Timestamp of last report
+        uint32_t    max_interval        = FB_GATEWAY_DEADBAND_MAX_INTERVAL;     // Heartbeat interval in ms, 0 disables heartbeat
+        uint16_t    min_interval        = FB_GATEWAY_DEADBAND_MIN_INTERVAL;     // Minimal interval in ms between two reports
+        uint8_t     percent             = FB_GATEWAY_DEADBAND_PERCENT;          // Change in % of last reported value to be reported
+        uint8_t     flags               = 0;                                    // Mask of GATEWAY_DEADBAND_FLAG_*
+    };
+
+    // All registers spaces of node are stored in one arena allocated during initialization
+    // DI & DO spaces   => bitset, one bit per register
+    // AI & AO spaces   => datatype byte per register followed by GATEWAY_REGISTER_ANALOG_VALUE_SIZE bytes value per register
+    // EV space         => one byte per register
     struct gateway_registers_t {
-        std::vector<gateway_register_t> digital_inputs;
-        std::vector<gateway_register_t> digital_outputs;
+        uint8_t     size[GATEWAY_REGISTER_MAX]      = { 0 };    // Registers count of each registers space
+        uint16_t    offset[GATEWAY_REGISTER_MAX]    = { 0 };    // Position of each registers space in arena
+        uint8_t *   arena                           = NULL;     // Registers values & datatypes
+        gateway_register_deadband_t * deadbands     = NULL;     // Report by exception of AI registers followed by AO registers
+    };
 
-        std::vector<gateway_register_t> analog_inputs;
-        std::vector<gateway_register_t> analog_outputs;
-        
-        std::vector<gateway_register_t> event_inputs;
+    // Requested register value waiting for writing into node, sets of same register are merged
+    struct gateway_register_write_t {
+        uint8_t     register_type       = GATEWAY_REGISTER_NONE;                // DO or AO registers space, NONE for free entry
+        uint8_t     address             = 0;                                    // Register address
+        bool        sending             = false;                                // Value was sent and waits for node confirmation
+        uint8_t     value[GATEWAY_REGISTER_ANALOG_VALUE_SIZE] = { 0 };          // Raw value in register datatype
     };
 
     struct gateway_node_initiliazation_t {
         bool        state               = false;                // Initialization process state
         uint8_t     step                = GATEWAY_PACKET_NONE;  // Node initialization step
-        uint8_t     register_position   = 0;
     };
 
     struct gateway_node_addressing_t {
+        uint8_t     address             = PJON_NOT_ASSIGNED;    // Node assigned address
+    };
+
+    // Addressing of node found by searching, finished when node confirms reserved address
+    struct gateway_node_addressing_process_t {
         bool        state               = false;                // Addressing process state
-        uint32_t    address             = PJON_NOT_ASSIGNED;    // Node assigned address
         uint32_t    registration        = 0;                    // Timestamp when node confirmed search request
     };
 
     struct gateway_node_communication_t {
-        uint8_t     max_packet_size     = PJON_PACKET_MAX_LENGTH;
-        uint8_t     waiting_for         = GATEWAY_PACKET_NONE;
         uint8_t     attempts            = 0;
+        uint8_t     lost_probes         = 0;                    // Count of unanswered probes of lost node
+        uint16_t    srtt                = 0;                    // Smoothed round-trip time in 1/8 ms, 0 when not measured yet
+        uint16_t    rttvar              = 0;                    // Round-trip time variation in 1/4 ms
+    };
+
+    // Support of trailing sequence byte, learned by PING probe during node initialization
+    struct gateway_node_sequencing_t {
+        uint8_t     support             = GATEWAY_READING_SUPPORT_UNKNOWN;  // Node echoes sequence byte as last byte of its replies
+        uint8_t     probes              = 0;                                // Sent sequencing probes
+    };
+
+    typedef void (*gateway_packet_handler_f)(const uint8_t packetId, const uint8_t nodeIndex, const uint8_t senderAddress, uint8_t * payload, const uint8_t payloadLength);
+
+    struct gateway_packet_dispatch_t {
+        gateway_packet_handler_f    handler;                    // Module handler for received packet
+        uint8_t                     expects;                    // Mask of GATEWAY_PACKET_EXPECT_* states
+    };
+
+    typedef void (*gateway_send_callback_f)(const uint8_t nodeIndex, const uint8_t packetId, const uint8_t result);
+
+    struct gateway_packet_sending_t {
+        gateway_send_callback_f callback    = NULL;                 // Module callback notified about sending result
+        uint8_t     address             = PJON_NOT_ASSIGNED;    // Packet destination address
+        uint8_t     packet_id           = GATEWAY_PACKET_NONE;  // Sent packet identifier
+        uint8_t     sequence            = 0;                    // Sent packet sequence number
+        uint8_t     result              = GATEWAY_SEND_SUCCESS; // Result reported by bus error handler
+        uint32_t    queued              = 0;                    // Timestamp when packet was queued
+    };
+
+    struct gateway_packet_in_flight_t {
+        uint8_t     node_index          = INDEX_NONE;           // Node which have to reply
+        uint8_t     packet_id           = GATEWAY_PACKET_NONE;  // Expected reply packet identifier
+        uint8_t     sequence            = 0;                    // Request sequence number
+        bool        sequenced           = false;                // Sequence byte was appended to request and have to be echoed back
+        uint32_t    sent                = 0;                    // Timestamp when request was sent
+        bool        transmitted         = false;                // Request was acknowledged on bus, reply timeout is running
+    };
+
+    struct gateway_scheduler_job_t {
+        uint32_t    due                 = 0;                    // Timestamp when node job have to be processed
+        uint8_t     node_index          = INDEX_NONE;           // Scheduled node index
+    };
+
+    struct gateway_node_polling_t {
+        uint32_t    due[GATEWAY_REGISTER_MAX];                  // Timestamp when registers space have to be polled
+        uint8_t     requested           = 0;                    // Mask of registers spaces queried out of polling order
+        uint8_t     changed             = 0;                    // Mask of registers spaces with changed value since last polling
+    };
+
+    // Node state checked by scheduling step, kept for every slot so it have to stay small
+    struct gateway_node_t {
+        gateway_node_addressing_t       addressing;
+        gateway_node_communication_t    communication;
+        gateway_node_initiliazation_t   initialization;
+
+        bool        ready               = false;                // Node is ready for data exchange flag
+        uint32_t    lost                = 0;                    // Lost communication timestamp
+
+        gateway_node_polling_t          polling;
+    };
+
+    // Node descriptions, registers & processes state not needed for scheduling, allocated only for used slots
+    // Gateway node registers mapped to FastyBird node channels, built when node is initialized
+    struct gateway_fastybird_mapping_t {
+        uint8_t     node                            = INDEX_NONE;   // FastyBird node representing gateway node
+        uint8_t     size[GATEWAY_REGISTER_MAX]      = { 0 };        // Mapped registers count of each registers space
+        uint16_t    offset[GATEWAY_REGISTER_MAX]    = { 0 };        // Position of each registers space in channels table
+        uint8_t *   channels                        = NULL;         // FastyBird channel of each register
     };
 
-    typedef union {
-        bool        number;
-        uint8_t     bytes[4];
-    } BOOL_UNION_t;
-
-    typedef union {
-        uint8_t     number;
-        uint8_t     bytes[4];
-    } UINT8_UNION_t;
-
-    typedef union {
-        uint16_t    number;
-        uint8_t     bytes[4];
-    } UINT16_UNION_t;
-
-    typedef union {
-        uint32_t    number;
-        uint8_t     bytes[4];
-    } UINT32_UNION_t;
-
-    typedef union {
-        int8_t      number;
-        uint8_t     bytes[4];
-    } INT8_UNION_t;
-
-    typedef union {
-        int16_t     number;
-        uint8_t     bytes[4];
-    } INT16_UNION_t;
-
-    typedef union {
-        int32_t     number;
-        uint8_t     bytes[4];
-    } INT32_UNION_t;
-
-    typedef union {
-        float       number;
-        uint8_t     bytes[4];
-    } FLOAT32_UNION_t;
+    struct gateway_node_details_t {
+        char        serial_number[15]   = GATEWAY_DESCRIPTION_NOT_SET;  // Node unique identifier
+
+        gateway_node_description_t      hardware;
+        gateway_node_description_t      firmware;
+
+        gateway_node_addressing_process_t   addressing;
+
+        uint8_t     max_packet_size     = PJON_PACKET_MAX_LENGTH;       // Maximum packet size supported by node
+        uint8_t     register_position   = 0;                            // Register position of structure reading during initialization
+
+        gateway_node_sequencing_t       sequencing;
+
+        uint16_t    poll_interval[GATEWAY_REGISTER_MAX] = { 0 };        // Registers spaces polling intervals
+
+        gateway_registers_t             registers;
+        gateway_register_reading_t      reading;
+        gateway_register_events_t       events;
+
+        gateway_register_write_t        writing[FB_GATEWAY_WRITE_QUEUE_SIZE];
+
+        #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
+            gateway_fastybird_mapping_t fastybird;                      // Released with node by gateway modules reset
+        #endif
+    };
+
+    // Nodes tables are defined in gateway module and shared by all sub-modules
+    extern gateway_node_t _gateway_nodes[FB_GATEWAY_MAX_NODES];
+    extern gateway_node_details_t * _gateway_nodes_details[FB_GATEWAY_MAX_NODES];
+
+    // Registers values codecs shared by all datatypes, values are transferred in little endian
+    template<typename T> struct gateway_data_type_codec_t {
+        typedef T type;
+
+        static T decode(const uint8_t * bytes) { T value; memcpy(&value, bytes, sizeof(T)); return value; }
+        static void encode(const T value, uint8_t * bytes) { memcpy(bytes, &value, sizeof(T)); }
+    };
+
+    // Registers datatypes traits, maps GATEWAY_DATA_TYPE_* to its C++ type, decoder, formatter & parser
+    template<uint8_t datatype> struct gateway_data_type_traits_t;
+
+    template<> struct gateway_data_type_traits_t<GATEWAY_DATA_TYPE_BOOL> : gateway_data_type_codec_t<bool> {
+        static bool decode(const uint8_t * bytes) { return bytes[0] != 0; }
+        static void format(const bool value, char * buffer) { strcpy(buffer, value ? FASTYBIRD_SWITCH_PAYLOAD_ON : FASTYBIRD_SWITCH_PAYLOAD_OFF); }
+        static bool parse(const char * payload) { return strcmp(payload, FASTYBIRD_SWITCH_PAYLOAD_ON) == 0; }
+    };
+
+    template<> struct gateway_data_type_traits_t<GATEWAY_DATA_TYPE_UINT8> : gateway_data_type_codec_t<uint8_t> {
+        static void format(const uint8_t value, char * buffer) { utoa(value, buffer, 10); }
+        static uint8_t parse(const char * payload) { return (uint8_t) strtoul(payload, NULL, 10); }
+    };
+
+    template<> struct gateway_data_type_traits_t<GATEWAY_DATA_TYPE_UINT16> : gateway_data_type_codec_t<uint16_t> {
+        static void format(const uint16_t value, char * buffer) { utoa(value, buffer, 10); }
+        static uint16_t parse(const char * payload) { return (uint16_t) strtoul(payload, NULL, 10); }
+    };
+
+    template<> struct gateway_data_type_traits_t<GATEWAY_DATA_TYPE_UINT32> : gateway_data_type_codec_t<uint32_t> {
+        static void format(const uint32_t value, char * buffer) { ultoa(value, buffer, 10); }
+        static uint32_t parse(const char * payload) { return (uint32_t) strtoul(payload, NULL, 10); }
+    };
+
+    template<> struct gateway_data_type_traits_t<GATEWAY_DATA_TYPE_INT8> : gateway_data_type_codec_t<int8_t> {
+        static void format(const int8_t value, char * buffer) { itoa(value, buffer, 10); }
+        static int8_t parse(const char * payload) { return (int8_t) strtol(payload, NULL, 10); }
+    };
+
+    template<> struct gateway_data_type_traits_t<GATEWAY_DATA_TYPE_INT16> : gateway_data_type_codec_t<int16_t> {
+        static void format(const int16_t value, char * buffer) { itoa(value, buffer, 10); }
+        static int16_t parse(const char * payload) { return (int16_t) strtol(payload, NULL, 10); }
+    };
+
+    template<> struct gateway_data_type_traits_t<GATEWAY_DATA_TYPE_INT32> : gateway_data_type_codec_t<int32_t> {
+        static void format(const int32_t value, char * buffer) { ltoa(value, buffer, 10); }
+        static int32_t parse(const char * payload) { return (int32_t) strtol(payload, NULL, 10); }
+    };
+
+    template<> struct gateway_data_type_traits_t<GATEWAY_DATA_TYPE_FLOAT32> : gateway_data_type_codec_t<float> {
+        static void format(const float value, char * buffer) { dtostrf(value, 1, 2, buffer); }
+        static float parse(const char * payload) { return (float) atof(payload); }
+    };
+
+    // Registers codecs routines generated for each datatype
+    template<uint8_t datatype> void _gatewayRegistersStoreReceivedBlock(const uint8_t nodeIndex, const uint8_t dataRegister, const uint8_t startAddress, const uint8_t count, const uint8_t * bytes, const uint8_t stride);
+    template<uint8_t datatype> void _gatewayRegistersFormatStoredValue(const uint8_t nodeIndex, const uint8_t dataRegister, const uint8_t address, char * buffer);
+    template<uint8_t datatype> void _gatewayRegistersParseValue(const char * payload, uint8_t * bytes);
+    template<uint8_t datatype> float _gatewayRegistersStoredNumericValue(const uint8_t nodeIndex, const uint8_t dataRegister, const uint8_t address);
 #else
     #define gateway_node_t void *
+    #define gateway_node_details_t void *
     #define PJON_Packet_Info void *
 #endif
 
@@ -291,7 +662,7 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 // GATEWAY - PROGMEM structures
 // -----------------------------------------------------------------------------
 
-#if FB_GATEWAY_SUPPORT
+#if FB_GATEWAY_SUPPORT && DEBUG_SUPPORT
 
     PROGMEM const char gateway_packet_search_nodes[]                = "GATEWAY_PACKET_SEARCH_NODES";
     PROGMEM const char gateway_packet_search_nodes_confirm[]        = "GATEWAY_PACKET_SEARCH_NODES_CONFIRM";
@@ -299,11 +670,6 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
     PROGMEM const char gateway_packet_node_address_confirm[]        = "GATEWAY_PACKET_NODE_ADDRESS_CONFIRM";
     PROGMEM const char gateway_packet_address_discard[]             = "GATEWAY_PACKET_ADDRESS_DISCARD";
 
-    PROGMEM const char * const gateway_packets_searching_string[] = {
-        gateway_packet_search_nodes, gateway_packet_search_nodes_confirm,
-        gateway_packet_node_address, gateway_packet_node_address_confirm, gateway_packet_address_discard
-    };
-
     PROGMEM const char gateway_packet_hw_model[]                    = "GATEWAY_PACKET_HW_MODEL";
     PROGMEM const char gateway_packet_hw_manufacturer[]             = "GATEWAY_PACKET_HW_MANUFACTURER";
     PROGMEM const char gateway_packet_hw_version[]                  = "GATEWAY_PACKET_HW_VERSION";
@@ -314,13 +680,6 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
     PROGMEM const char gateway_packet_ai_registers_structure[]      = "GATEWAY_PACKET_AI_REGISTERS_STRUCTURE";
     PROGMEM const char gateway_packet_ao_registers_structure[]      = "GATEWAY_PACKET_AO_REGISTERS_STRUCTURE";
 
-    PROGMEM const char * const gateway_packets_node_initialization_string[] = {
-        gateway_packet_hw_model, gateway_packet_hw_manufacturer, gateway_packet_hw_version,
-        gateway_packet_fw_model, gateway_packet_fw_manufacturer, gateway_packet_fw_version,
-        gateway_packet_registers_size,
-        gateway_packet_ai_registers_structure, gateway_packet_ao_registers_structure
-    };
-
     PROGMEM const char gateway_packet_read_single_di[]              = "GATEWAY_PACKET_READ_SINGLE_DI";
     PROGMEM const char gateway_packet_read_multi_di[]               = "GATEWAY_PACKET_READ_MULTI_DI";
     PROGMEM const char gateway_packet_read_single_do[]              = "GATEWAY_PACKET_READ_SINGLE_DO";
@@ -331,63 +690,36 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
     PROGMEM const char gateway_packet_read_multi_ao[]               = "GATEWAY_PACKET_READ_MULTI_AO";
     PROGMEM const char gateway_packet_read_single_ev[]              = "GATEWAY_PACKET_READ_SINGLE_EV";
     PROGMEM const char gateway_packet_read_multi_ev[]               = "GATEWAY_PACKET_READ_MULTI_EV";
+    PROGMEM const char gateway_packet_read_combined[]               = "GATEWAY_PACKET_READ_COMBINED";
+    PROGMEM const char gateway_packet_read_changes[]                = "GATEWAY_PACKET_READ_CHANGES";
 
-    PROGMEM const char * const gateway_packets_registers_reading_string[] = {
-        gateway_packet_read_single_di, gateway_packet_read_multi_di,
-        gateway_packet_read_single_do, gateway_packet_read_multi_do,
-        gateway_packet_read_single_ai, gateway_packet_read_multi_ai,
-        gateway_packet_read_single_ao, gateway_packet_read_multi_ao,
-        gateway_packet_read_single_ev, gateway_packet_read_multi_ev
-    };
+    PROGMEM const char gateway_packet_report_window[]               = "GATEWAY_PACKET_REPORT_WINDOW";
+    PROGMEM const char gateway_packet_report_changes[]              = "GATEWAY_PACKET_REPORT_CHANGES";
+
+    PROGMEM const char gateway_packet_read_events[]                 = "GATEWAY_PACKET_READ_EVENTS";
 
     PROGMEM const char gateway_packet_write_one_do[]                = "GATEWAY_PACKET_WRITE_ONE_DO";
     PROGMEM const char gateway_packet_write_one_ao[]                = "GATEWAY_PACKET_WRITE_ONE_AO";
     PROGMEM const char gateway_packet_write_multi_do[]              = "GATEWAY_PACKET_WRITE_MULTI_DO";
     PROGMEM const char gateway_packet_write_multi_ao[]              = "GATEWAY_PACKET_WRITE_MULTI_AO";
 
-    PROGMEM const char * const gateway_packets_registers_writing_string[] = {
-        gateway_packet_write_one_do, gateway_packet_write_one_ao,
-        gateway_packet_write_multi_do, gateway_packet_write_multi_ao
-    };
-
     PROGMEM const char gateway_packet_ping[]                        = "GATEWAY_PACKET_PING";
     PROGMEM const char gateway_packet_pong[]                        = "GATEWAY_PACKET_PONG";
     PROGMEM const char gateway_packet_hello[]                       = "GATEWAY_PACKET_HELLO";
     PROGMEM const char gateway_packet_none[]                        = "GATEWAY_PACKET_NONE";
 
-    PROGMEM const char * const gateway_packets_misc_string[] = {
-        gateway_packet_ping, gateway_packet_pong, gateway_packet_hello, gateway_packet_none
-    };
-
-    //--------------------------------------------------------------------------------
-
-    PROGMEM const int gateway_packets_searching[] = {
-        GATEWAY_PACKET_SEARCH_NODES, GATEWAY_PACKET_SEARCH_NODES_CONFIRM,
-        GATEWAY_PACKET_NODE_ADDRESS, GATEWAY_PACKET_NODE_ADDRESS_CONFIRM, GATEWAY_PACKET_ADDRESS_DISCARD
-    };
-
-    PROGMEM const int gateway_packets_node_initialization[] = {
-        GATEWAY_PACKET_HW_MODEL, GATEWAY_PACKET_HW_MANUFACTURER, GATEWAY_PACKET_HW_VERSION,
-        GATEWAY_PACKET_FW_MODEL, GATEWAY_PACKET_FW_MANUFACTURER, GATEWAY_PACKET_FW_VERSION,
-        GATEWAY_PACKET_REGISTERS_SIZE,
-        GATEWAY_PACKET_AI_REGISTERS_STRUCTURE, GATEWAY_PACKET_AO_REGISTERS_STRUCTURE
-    };
-
-    PROGMEM const int gateway_packets_registers_reading[] = {
-        GATEWAY_PACKET_READ_SINGLE_DI, GATEWAY_PACKET_READ_MULTI_DI,
-        GATEWAY_PACKET_READ_SINGLE_DO, GATEWAY_PACKET_READ_MULTI_DO,
-        GATEWAY_PACKET_READ_SINGLE_AI, GATEWAY_PACKET_READ_MULTI_AI,
-        GATEWAY_PACKET_READ_SINGLE_AO, GATEWAY_PACKET_READ_MULTI_AO,
-        GATEWAY_PACKET_READ_SINGLE_EV, GATEWAY_PACKET_READ_MULTI_EV
-    };
-
-    PROGMEM const int gateway_packets_registers_writing[] = {
-        GATEWAY_PACKET_WRITE_ONE_DO, GATEWAY_PACKET_WRITE_ONE_AO,
-        GATEWAY_PACKET_WRITE_MULTI_DO, GATEWAY_PACKET_WRITE_MULTI_AO
-    };
-
-    PROGMEM const int gateway_packets_misc[] = {
-        GATEWAY_PACKET_PING, GATEWAY_PACKET_PONG, GATEWAY_PACKET_HELLO, GATEWAY_PACKET_NONE
+    // Packet names indexed directly by packet identifier
+    PROGMEM const char * const gateway_packets_names[] = {
+        // 0x00 - 0x0F
+        NULL, gateway_packet_search_nodes, gateway_packet_search_nodes_confirm, gateway_packet_node_address, gateway_packet_node_address_confirm, gateway_packet_address_discard, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+        // 0x10 - 0x1F
+        NULL, gateway_packet_hw_model, gateway_packet_hw_manufacturer, gateway_packet_hw_version, gateway_packet_fw_model, gateway_packet_fw_manufacturer, gateway_packet_fw_version, gateway_packet_registers_size, gateway_packet_ai_registers_structure, gateway_packet_ao_registers_structure, NULL, NULL, NULL, NULL, NULL, NULL,
+        // 0x20 - 0x2F
+        NULL, gateway_packet_read_single_di, gateway_packet_read_multi_di, gateway_packet_read_single_do, gateway_packet_read_multi_do, gateway_packet_read_single_ai, gateway_packet_read_multi_ai, gateway_packet_read_single_ao, gateway_packet_read_multi_ao, gateway_packet_read_single_ev, gateway_packet_read_multi_ev, gateway_packet_read_combined, gateway_packet_read_changes, gateway_packet_report_window, gateway_packet_report_changes, gateway_packet_read_events,
+        // 0x30 - 0x3F
+        NULL, gateway_packet_write_one_do, gateway_packet_write_one_ao, gateway_packet_write_multi_do, gateway_packet_write_multi_ao, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+        // 0x40 - 0x43
+        NULL, gateway_packet_ping, gateway_packet_pong, gateway_packet_hello
     };
 
-#endif // FB_GATEWAY_SUPPORT
\ No newline at end of file
+#endif // FB_GATEWAY_SUPPORT && DEBUG_SUPPORT
@@ -8,298 +8,706 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
 #if MQTT_SUPPORT
 
-std::vector<String> _fastybird_topic_parts;
+// Received topics keywords, array index is FASTYBIRD_TOPIC_KEYWORD_* identifier
+const char * const _fastybird_topic_keywords[] = {
+    "",
+    FASTYBIRD_TOPIC_PART_BROADCAST,
+    FASTYBIRD_TOPIC_PART_PROPERTY,
+    FASTYBIRD_TOPIC_PART_CONTROL,
+    FASTYBIRD_TOPIC_PART_CHANNEL,
+    FASTYBIRD_TOPIC_PART_SET,
+    FASTYBIRD_TOPIC_PART_QUERY,
+    FASTYBIRD_TOPIC_PART_INIT,
+};
+
+// Perfect hash table of keywords created at startup, slots hold keywords identifiers
+uint8_t _fastybird_topic_keywords_table[FASTYBIRD_TOPIC_KEYWORDS_TABLE_MAX_SIZE];
+uint8_t _fastybird_topic_keywords_table_size = 0;
+
+// Chip ID based identifier used in topics of this device
+char _fastybird_topic_device_id[20];
+
+// Cached topics prefixes, topics are assembled from them without heap allocations
+fastybird_topic_t _fastybird_topic_own_device_prefix;   // <base>/<this device>/
+fastybird_topic_t _fastybird_topic_device_prefix;       // <base>/<last used device>/
+fastybird_topic_t _fastybird_topic_channel_prefix;      // <base>/<device>/$channel/<last used channel>/
+
+// Length of device part of cached channel prefix
+uint16_t _fastybird_topic_channel_device_length = 0;
 
 // -----------------------------------------------------------------------------
 // MODULE: SUB-MODULE PRIVATE
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateTopic(
-    String topic
+/**
+ * Length of base topic including trailing "/"
+ */
+uint16_t _fastybirdMqttApiTopicBaseLength()
+{
+    uint16_t length = strlen(FASTYBIRD_MQTT_BASE_TOPIC);
+
+    if (length > 0 && FASTYBIRD_MQTT_BASE_TOPIC[length - 1] == '/') {
+        return length;
+    }
+
+    return length + 1;
+}
+
+// -----------------------------------------------------------------------------
+
+bool _fastybirdMqttApiTopicIsValid(
+    const fastybird_topic_t & topic
 ) {
-    // Replace identifier
-    String topic_prefix = FASTYBIRD_MQTT_BASE_TOPIC;
+    return topic.length < FASTYBIRD_TOPIC_MAX_LENGTH;
+}
+
+// -----------------------------------------------------------------------------
+
+void _fastybirdMqttApiTopicCopy(
+    fastybird_topic_t & topic,
+    const fastybird_topic_t & prefix
+) {
+    topic.length = prefix.length;
 
-    // Check if topic prefix is ending with "/"
-    if (!topic_prefix.endsWith("/")) {
-        // ...if not, add it
-        topic_prefix = topic_prefix + "/";
+    if (_fastybirdMqttApiTopicIsValid(prefix)) {
+        memcpy(topic.value, prefix.value, prefix.length + 1);
     }
+}
+
+// -----------------------------------------------------------------------------
 
-    return topic_prefix + topic;
+/**
+ * Append topic segment, topic is marked as invalid when segment does not fit into buffer
+ */
+bool _fastybirdMqttApiTopicAppend(
+    fastybird_topic_t & topic,
+    const char * part,
+    const uint16_t length,
+    const bool lowercase
+) {
+    if ((topic.length + length) >= FASTYBIRD_TOPIC_MAX_LENGTH) {
+        topic.length = FASTYBIRD_TOPIC_MAX_LENGTH;
+
+        return false;
+    }
+
+    if (lowercase) {
+        for (uint16_t i = 0; i < length; i++) {
+            topic.value[topic.length + i] = tolower(part[i]);
+        }
+
+    } else {
+        memcpy(topic.value + topic.length, part, length);
+    }
+
+    topic.length += length;
+    topic.value[topic.length] = '\0';
+
+    return true;
 }
 
 // -----------------------------------------------------------------------------
 
-bool _fastybirdMqttApiIsSameTopic(
-    const char * compareTopic,
-    const char * topic
+bool _fastybirdMqttApiTopicAppend(
+    fastybird_topic_t & topic,
+    const char * part
 ) {
-    return (String(topic)).endsWith(String(compareTopic));
+    return _fastybirdMqttApiTopicAppend(topic, part, strlen(part), false);
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateDeviceTopic(
+/**
+ * Check if prefix was created for given device: <base>/<device>/
+ */
+bool _fastybirdMqttApiTopicIsDevicePrefix(
+    const fastybird_topic_t & prefix,
     const char * deviceId
 ) {
-    String topic = _fastybirdMqttApiCreateTopic(String(deviceId));
+    uint16_t base_length = _fastybirdMqttApiTopicBaseLength();
+    uint16_t length = strlen(deviceId);
+
+    // Device part is ended with "/"
+    uint16_t expected_length = base_length + length + ((length > 0 && deviceId[length - 1] == '/') ? 0 : 1);
+
+    return prefix.length == expected_length
+        && strncasecmp(prefix.value + base_length, deviceId, length) == 0;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Start topic with base topic ended with "/"
+ */
+void _fastybirdMqttApiTopicCreateBase(
+    fastybird_topic_t & topic
+) {
+    topic.length = 0;
+    topic.value[0] = '\0';
 
-    // Check if topic prefix is ending with "/"
-    if (!topic.endsWith("/")) {
-        // ...if not, add it
-        topic = topic + "/";
+    _fastybirdMqttApiTopicAppend(topic, FASTYBIRD_MQTT_BASE_TOPIC, strlen(FASTYBIRD_MQTT_BASE_TOPIC), true);
+
+    if (topic.length != _fastybirdMqttApiTopicBaseLength()) {
+        _fastybirdMqttApiTopicAppend(topic, "/");
     }
+}
+
+// -----------------------------------------------------------------------------
+
+void _fastybirdMqttApiTopicCreateDevicePrefix(
+    fastybird_topic_t & prefix,
+    const char * deviceId
+) {
+    _fastybirdMqttApiTopicCreateBase(prefix);
 
-    // All topic parts have to lowercased
-    topic.toLowerCase();
+    // All prefix parts have to lowercased
+    _fastybirdMqttApiTopicAppend(prefix, deviceId, strlen(deviceId), true);
 
-    return topic;
+    if (_fastybirdMqttApiTopicIsValid(prefix) && prefix.value[prefix.length - 1] != '/') {
+        _fastybirdMqttApiTopicAppend(prefix, "/");
+    }
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateDeviceTopicString(
-    const char * deviceId,
-    String topic
+/**
+ * Prefix of device topics, created only when device is changed
+ */
+const fastybird_topic_t & _fastybirdMqttApiTopicDevicePrefix(
+    const char * deviceId
 ) {
-    return _fastybirdMqttApiCreateDeviceTopic(deviceId) + topic;
+    if (_fastybirdMqttApiTopicIsDevicePrefix(_fastybird_topic_own_device_prefix, deviceId)) {
+        return _fastybird_topic_own_device_prefix;
+    }
+
+    if (!_fastybirdMqttApiTopicIsDevicePrefix(_fastybird_topic_device_prefix, deviceId)) {
+        _fastybirdMqttApiTopicCreateDevicePrefix(_fastybird_topic_device_prefix, deviceId);
+    }
+
+    return _fastybird_topic_device_prefix;
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateDeviceTopicString(
+/**
+ * Prefix of channel topics, created only when device or channel is changed
+ */
+const fastybird_topic_t & _fastybirdMqttApiTopicChannelPrefix(
     const char * deviceId,
-    String topic,
-    String replace,
-    String replaceWith
+    const char * channel
 ) {
-    topic.replace("{" + replace + "}", replaceWith);
+    const fastybird_topic_t & device_prefix = _fastybirdMqttApiTopicDevicePrefix(deviceId);
+
+    uint16_t channel_length = strlen(channel);
+    uint16_t part_length = strlen(FASTYBIRD_TOPIC_PART_CHANNEL);
+
+    // Cached prefix is: <device prefix>$channel/<channel>/
+    if (
+        _fastybird_topic_channel_device_length == device_prefix.length
+        && _fastybird_topic_channel_prefix.length == (device_prefix.length + part_length + channel_length + 2)
+        && memcmp(_fastybird_topic_channel_prefix.value, device_prefix.value, device_prefix.length) == 0
+        && memcmp(_fastybird_topic_channel_prefix.value + device_prefix.length + part_length + 1, channel, channel_length) == 0
+    ) {
+        return _fastybird_topic_channel_prefix;
+    }
+
+    _fastybirdMqttApiTopicCopy(_fastybird_topic_channel_prefix, device_prefix);
+
+    _fastybirdMqttApiTopicAppend(_fastybird_topic_channel_prefix, FASTYBIRD_TOPIC_PART_CHANNEL, part_length, false);
+    _fastybirdMqttApiTopicAppend(_fastybird_topic_channel_prefix, "/");
+    _fastybirdMqttApiTopicAppend(_fastybird_topic_channel_prefix, channel, channel_length, false);
+    _fastybirdMqttApiTopicAppend(_fastybird_topic_channel_prefix, "/");
+
+    _fastybird_topic_channel_device_length = device_prefix.length;
 
-    return _fastybirdMqttApiCreateDeviceTopic(deviceId) + topic;
+    return _fastybird_topic_channel_prefix;
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateStateTopicString(
-    const char * deviceId
+/**
+ * Append "<part>/<name><suffix>" segments, eg. $property/temperature/$name
+ */
+bool _fastybirdMqttApiTopicAppendNamed(
+    fastybird_topic_t & topic,
+    const char * part,
+    const char * name,
+    const char * suffix
 ) {
-    return _fastybirdMqttApiCreateDeviceTopicString(
-        deviceId,
-        FASTYBIRD_TOPIC_DEVICE_STATE
-    );
+    _fastybirdMqttApiTopicAppend(topic, part);
+    _fastybirdMqttApiTopicAppend(topic, "/");
+    _fastybirdMqttApiTopicAppend(topic, name);
+
+    return _fastybirdMqttApiTopicAppend(topic, suffix);
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreatePropertyTopicString(
-    const char * deviceId,
-    String property
+bool _fastybirdMqttApiTopicFinish(
+    const fastybird_topic_t & topic
 ) {
-    return _fastybirdMqttApiCreateDeviceTopicString(
-        deviceId,
-        FASTYBIRD_TOPIC_DEVICE_PROPERTY,
-        "property",
-        property
-    );
+    if (!_fastybirdMqttApiTopicIsValid(topic)) {
+        DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Topic does not fit into buffer\n"));
+
+        return false;
+    }
+
+    return true;
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateHWTopicString(
-    const char * deviceId,
-    String field
+bool _fastybirdMqttApiCreateBroadcastTopic(
+    fastybird_topic_t & topic
 ) {
-    return _fastybirdMqttApiCreateDeviceTopicString(
-        deviceId,
-        FASTYBIRD_TOPIC_DEVICE_HW_INFO,
-        "hw",
-        field
-    );
+    _fastybirdMqttApiTopicCreateBase(topic);
+    _fastybirdMqttApiTopicAppend(topic, FASTYBIRD_TOPIC_BROADCAST);
+
+    return _fastybirdMqttApiTopicFinish(topic);
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateFWTopicString(
+bool _fastybirdMqttApiCreateDeviceTopic(
+    fastybird_topic_t & topic,
     const char * deviceId,
-    String field
+    const char * part
 ) {
-    return _fastybirdMqttApiCreateDeviceTopicString(
-        deviceId,
-        FASTYBIRD_TOPIC_DEVICE_FW_INFO,
-        "fw",
-        field
-    );
+    _fastybirdMqttApiTopicCopy(topic, _fastybirdMqttApiTopicDevicePrefix(deviceId));
+    _fastybirdMqttApiTopicAppend(topic, part);
+
+    return _fastybirdMqttApiTopicFinish(topic);
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateChannelTopicString(
+bool _fastybirdMqttApiCreateDeviceTopic(
+    fastybird_topic_t & topic,
     const char * deviceId,
-    const char * channel,
-    String topic
+    const char * part,
+    const char * name,
+    const char * suffix
 ) {
-    topic.replace("{channel}", channel);
+    _fastybirdMqttApiTopicCopy(topic, _fastybirdMqttApiTopicDevicePrefix(deviceId));
+    _fastybirdMqttApiTopicAppendNamed(topic, part, name, suffix);
 
-    return _fastybirdMqttApiCreateDeviceTopic(deviceId) + topic;
+    return _fastybirdMqttApiTopicFinish(topic);
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateChannelTopicString(
+bool _fastybirdMqttApiCreateChannelTopic(
+    fastybird_topic_t & topic,
     const char * deviceId,
     const char * channel,
-    String topic,
-    String replace,
-    String replaceWith
+    const char * part
 ) {
-    topic = _fastybirdMqttApiCreateChannelTopicString(deviceId, channel, topic);
-    topic.replace("{" + replace + "}", replaceWith);
+    _fastybirdMqttApiTopicCopy(topic, _fastybirdMqttApiTopicChannelPrefix(deviceId, channel));
+    _fastybirdMqttApiTopicAppend(topic, part);
 
-    return topic;
+    return _fastybirdMqttApiTopicFinish(topic);
 }
 
 // -----------------------------------------------------------------------------
 
-String _fastybirdMqttApiCreateChannelTopicString(
+bool _fastybirdMqttApiCreateChannelTopic(
+    fastybird_topic_t & topic,
     const char * deviceId,
     const char * channel,
-    String topic,
-    String replace,
-    String replaceWith,
-    String secondReplace,
-    String secondReplaceWith
+    const char * part,
+    const char * name,
+    const char * suffix
+) {
+    _fastybirdMqttApiTopicCopy(topic, _fastybirdMqttApiTopicChannelPrefix(deviceId, channel));
+    _fastybirdMqttApiTopicAppendNamed(topic, part, name, suffix);
+
+    return _fastybirdMqttApiTopicFinish(topic);
+}
+
+// -----------------------------------------------------------------------------
+
+bool _fastybirdMqttApiIsSameTopic(
+    const char * compareTopic,
+    const char * topic
+) {
+    return (String(topic)).endsWith(String(compareTopic));
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if received topic part is equal to given string, comparison is case sensitive
+ */
+bool _fastybirdMqttApiTopicPartEquals(
+    const char * part,
+    const uint8_t length,
+    const char * value
+) {
+    return strncmp(value, part, length) == 0 && value[length] == '\0';
+}
+
+// -----------------------------------------------------------------------------
+
+bool _fastybirdMqttApiTopicPartEquals(
+    const fastybird_topic_part_t & part,
+    const char * value
+) {
+    return _fastybirdMqttApiTopicPartEquals(part.value, part.length, value);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Create collision free hash table of topics keywords with smallest possible size
+ */
+void _fastybirdMqttApiTopicKeywordsInitialize()
+{
+    uint8_t keywords_count = sizeof(_fastybird_topic_keywords) / sizeof(_fastybird_topic_keywords[0]);
+
+    for (uint8_t size = keywords_count; size <= FASTYBIRD_TOPIC_KEYWORDS_TABLE_MAX_SIZE; size++) {
+        memset(_fastybird_topic_keywords_table, FASTYBIRD_TOPIC_KEYWORD_NONE, size);
+
+        bool collision = false;
+
+        for (uint8_t keyword = (FASTYBIRD_TOPIC_KEYWORD_NONE + 1); keyword < keywords_count; keyword++) {
+            uint8_t slot = fastybirdNameHash(_fastybird_topic_keywords[keyword]) % size;
+
+            if (_fastybird_topic_keywords_table[slot] != FASTYBIRD_TOPIC_KEYWORD_NONE) {
+                collision = true;
+
+                break;
+            }
+
+            _fastybird_topic_keywords_table[slot] = keyword;
+        }
+
+        if (!collision) {
+            _fastybird_topic_keywords_table_size = size;
+
+            return;
+        }
+    }
+
+    // Keywords will be compared one by one
+    _fastybird_topic_keywords_table_size = 0;
+
+    DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Topics keywords table could not be created\n"));
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t _fastybirdMqttApiTopicKeyword(
+    const char * part,
+    const uint8_t length
 ) {
-    topic = _fastybirdMqttApiCreateChannelTopicString(deviceId, channel, topic, replace, replaceWith);
-    topic.replace("{" + secondReplace + "}", secondReplaceWith);
+    if (_fastybird_topic_keywords_table_size == 0) {
+        uint8_t keywords_count = sizeof(_fastybird_topic_keywords) / sizeof(_fastybird_topic_keywords[0]);
 
-    return topic;
+        for (uint8_t keyword = (FASTYBIRD_TOPIC_KEYWORD_NONE + 1); keyword < keywords_count; keyword++) {
+            if (_fastybirdMqttApiTopicPartEquals(part, length, _fastybird_topic_keywords[keyword])) {
+                return keyword;
+            }
+        }
+
+        return FASTYBIRD_TOPIC_KEYWORD_NONE;
+    }
+
+    uint8_t keyword = _fastybird_topic_keywords_table[fastybirdNameHash(part, length) % _fastybird_topic_keywords_table_size];
+
+    // Any other word could hit keyword slot
+    if (
+        keyword != FASTYBIRD_TOPIC_KEYWORD_NONE
+        && _fastybirdMqttApiTopicPartEquals(part, length, _fastybird_topic_keywords[keyword])
+    ) {
+        return keyword;
+    }
+
+    return FASTYBIRD_TOPIC_KEYWORD_NONE;
 }
 
 // -----------------------------------------------------------------------------
 
-void _fastybirdMqttApiPropertyTopicMatchCallback(
-    const char * match,
-    const unsigned int length,
-    const MatchState & topic_match
+/**
+ * Split received topic into parts pointing into topic, empty parts are skipped
+ * Topics with too many or too long parts are not splitted at all
+ */
+uint8_t _fastybirdMqttApiTopicSplit(
+    const char * topic,
+    fastybird_topic_part_t * parts
 ) {
-    // Add string to vector
-    _fastybird_topic_parts.push_back(String(match).substring(0, length));
+    uint8_t count = 0;
+
+    const char * start = topic;
+
+    while (true) {
+        const char * end = strchr(start, '/');
+
+        size_t length = end == NULL ? strlen(start) : (size_t) (end - start);
+
+        if (length > 0) {
+            if (count >= FASTYBIRD_TOPIC_PART_COUNT_MAX || length > UINT8_MAX) {
+                return 0;
+            }
+
+            parts[count].value = start;
+            parts[count].length = length;
+            parts[count].keyword = _fastybirdMqttApiTopicKeyword(start, length);
+
+            count++;
+        }
+
+        if (end == NULL) {
+            return count;
+        }
+
+        start = end + 1;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void _fastybirdMqttApiMqttHandleDeviceControl(
+    const fastybird_topic_part_t & control,
+    const char * payload
+) {
+    fastybirdCallOnControlRegister(control.value, control.length, payload);
 }
 
 // -----------------------------------------------------------------------------
 
 #if FASTYBIRD_MAX_CHANNELS > 0
-    void _fastybirdMqttApiMqttHandleChannelProperty(
-        String channelName,
-        String propertyName,
-        String action,
+    void _fastybirdMqttApiMqttHandleChannelConfiguration(
+        const uint8_t channelIndex,
         const char * payload
     ) {
-        // Find channel index by name
-        uint8_t channelIndex = fastybirdFindChannelIndex(channelName);
+        DynamicJsonBuffer jsonBuffer;
 
-        // Channel was found
-        if (channelIndex != INDEX_NONE) {
-            DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Channel was found\n"));
+        // Parse payload
+        JsonObject& root = jsonBuffer.parseObject(payload);
 
-            // Find channel property index by name
-            uint8_t propertyIndex = fastybirdFindChannelPropertyIndex(channelIndex, propertyName);
+        if (!root.success()) {
+            DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Parsing configuration data failed\n"));
 
-            if (propertyIndex != INDEX_NONE) {
-                DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Channel property was found\n"));
+            return;
+        }
 
-                fastybird_property_t property = fastybirdGetProperty(propertyIndex);
+        const fastybird_channel_t & channel = fastybirdGetChannel(channelIndex);
 
-                // Combination of channel & property was found
+        DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Sending configuration to channel: %s\n"), channel.name.c_str());
 
-                if (
-                    action.equals(FASTYBIRD_TOPIC_PART_SET)
-                    && property.settable
-                ) {
-                    property.payload_callback(channelIndex, propertyIndex, payload);
+        fastybirdCallOnChannelConfigure(channelIndex, root);
 
-                } else if (
-                    action.equals(FASTYBIRD_TOPIC_PART_QUERY)
-                    && property.queryable
-                ) {
-                    property.query_callback(channelIndex, propertyIndex);
-                }
+        DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Changes were saved\n"));
 
-            } else {
-                DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Channel property was not found\n"));
-            }
+        DynamicJsonBuffer configurationJsonBuffer;
 
-        } else {
-            DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Channel was not found\n"));
+        JsonObject& configuration = configurationJsonBuffer.createObject();
+
+        fastybirdCallReportChannelConfiguration(channelIndex, configuration);
+
+        if (configuration.size() > 0) {
+            fastybirdApiPropagateChannelConfiguration(channel.name.c_str(), configuration);
         }
+
+        #if WEB_SUPPORT && WS_SUPPORT
+            wsReportConfiguration();
+        #endif
+
+        // Reload & cache settings
+        firmwareReload();
     }
-#endif
 
 // -----------------------------------------------------------------------------
 
-#if FASTYBIRD_NODES_SUPPORT
-    void _fastybirdMqttApiMqttHandleNodeChannelProperty(
-        String deviceName,
-        String channelName,
-        String propertyName,
-        String action,
+    void _fastybirdMqttApiMqttHandleChannelProperty(
+        const uint8_t channelIndex,
+        const uint8_t propertyIndex,
+        const uint8_t action,
         const char * payload
     ) {
-        uint8_t nodeIndex = fastybirdNodesFindNodeIndex(deviceName);
+        const fastybird_property_t & property = fastybirdGetProperty(propertyIndex);
 
-        if (nodeIndex != INDEX_NONE) {
-            fastybird_node_t node = fastybirdNodesGetNode(nodeIndex);
+        if (
+            action == FASTYBIRD_TOPIC_KEYWORD_SET
+            && property.settable
+        ) {
+            property.payload_callback(channelIndex, propertyIndex, payload);
 
-            if (node.initialized == false) {
-                DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Skipping - Node is not initialized yet\n"));
+        } else if (
+            action == FASTYBIRD_TOPIC_KEYWORD_QUERY
+            && property.queryable
+        ) {
+            property.query_callback(channelIndex, propertyIndex);
+        }
+    }
 
+// -----------------------------------------------------------------------------
+
+    /**
+     * Route channel topic of this device: <base>/<device>/$channel/<channel>/...
+     */
+    void _fastybirdMqttApiMqttRouteChannel(
+        const fastybird_topic_part_t * parts,
+        const uint8_t partsCount,
+        const char * payload
+    ) {
+        // Control channel topic
+        if (
+            partsCount == FASTYBIRD_TOPIC_PART_COUNT_CHANNEL_CONTROL
+            && parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_CONTROL_PREFIX].keyword == FASTYBIRD_TOPIC_KEYWORD_CONTROL
+            && parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_CONTROL_ACTION].keyword == FASTYBIRD_TOPIC_KEYWORD_SET
+        ) {
+            DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Channel control topic\n"));
+
+            // Only configure control is supported
+            if (!_fastybirdMqttApiTopicPartEquals(parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_CONTROL_NAME], FASTYBIRD_CHANNEL_CONTROL_CONFIGURE)) {
                 return;
             }
 
-            if (node.disabled == true) {
-                DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Skipping - Node is disabled\n"));
+            const fastybird_topic_part_t & channel = parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_NAME];
+
+            // Find channel index by name
+            uint8_t channelIndex = fastybirdFindChannelIndex(channel.value, channel.length);
+
+            if (channelIndex == INDEX_NONE) {
+                DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Channel to update was not found\n"));
 
                 return;
             }
 
-            // Find channel index by name
-            uint8_t channelIndex = fastybirdNodesFindChannelIndex(nodeIndex, channelName);
+            _fastybirdMqttApiMqttHandleChannelConfiguration(channelIndex, payload);
 
-            if (channelIndex != INDEX_NONE) {
-                uint8_t propertyIndex = fastybirdNodesFindChannelPropertyIndex(channelIndex, propertyName);
+        // Set or Query channel property topic
+        } else if (
+            partsCount == FASTYBIRD_TOPIC_PART_COUNT_CHANNEL_PROPERTY
+            && parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_PREFIX].keyword == FASTYBIRD_TOPIC_KEYWORD_PROPERTY
+            && (
+                parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].keyword == FASTYBIRD_TOPIC_KEYWORD_SET
+                || parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].keyword == FASTYBIRD_TOPIC_KEYWORD_QUERY
+            )
+        ) {
+            DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Channel property topic\n"));
 
-                if (propertyIndex != INDEX_NONE) {
-                    DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Node channel property was found\n"));
+            const fastybird_topic_part_t & channel = parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_NAME];
+            const fastybird_topic_part_t & property = parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_NAME];
 
-                    fastybird_node_property_t property = fastybirdNodesGetProperty(propertyIndex);
+            // Find channel index by name
+            uint8_t channelIndex = fastybirdFindChannelIndex(channel.value, channel.length);
 
-                    // Combination of channel & property was found
+            if (channelIndex == INDEX_NONE) {
+                DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Channel was not found\n"));
 
-                    if (
-                        action.equals(FASTYBIRD_TOPIC_PART_SET)
-                        && property.settable
-                    ) {
-                        property.payload_callback(nodeIndex, channelIndex, propertyIndex, payload);
+                return;
+            }
 
-                    } else if (
-                        action.equals(FASTYBIRD_TOPIC_PART_QUERY)
-                        && property.queryable
-                    ) {
-                        property.query_callback(nodeIndex, channelIndex, propertyIndex);
-                    }
+            // Find channel property index by name
+            uint8_t propertyIndex = fastybirdFindChannelPropertyIndex(channelIndex, property.value, property.length);
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Node channel property was not found\n"));
-                }
+            if (propertyIndex == INDEX_NONE) {
+                DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Channel property was not found\n"));
 
-            } else {
-                DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Node channel was not found\n"));
+                return;
             }
 
-        } else {
+            _fastybirdMqttApiMqttHandleChannelProperty(
+                channelIndex,
+                propertyIndex,
+                parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].keyword,
+                payload
+            );
+        }
+    }
+#endif
+
+// -----------------------------------------------------------------------------
+
+#if FASTYBIRD_NODES_SUPPORT
+    void _fastybirdMqttApiMqttHandleNodeChannelProperty(
+        const uint8_t nodeIndex,
+        const uint8_t channelIndex,
+        const uint8_t propertyIndex,
+        const uint8_t action,
+        const char * payload
+    ) {
+        const fastybird_node_property_t & property = fastybirdNodesGetProperty(propertyIndex);
+
+        if (
+            action == FASTYBIRD_TOPIC_KEYWORD_SET
+            && property.settable
+        ) {
+            property.payload_callback(nodeIndex, channelIndex, propertyIndex, payload);
+
+        } else if (
+            action == FASTYBIRD_TOPIC_KEYWORD_QUERY
+            && property.queryable
+        ) {
+            property.query_callback(nodeIndex, channelIndex, propertyIndex);
+        }
+    }
+
+// -----------------------------------------------------------------------------
+
+    /**
+     * Route channel property topic of child node: <base>/<node>/$channel/<channel>/$property/<property>/<action>
+     */
+    void _fastybirdMqttApiMqttRouteNodeChannelProperty(
+        const fastybird_topic_part_t * parts,
+        const char * payload
+    ) {
+        DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Node channel property topic\n"));
+
+        const fastybird_topic_part_t & node = parts[FASTYBIRD_TOPIC_POSITION_DEVICE];
+        const fastybird_topic_part_t & channel = parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_NAME];
+        const fastybird_topic_part_t & property = parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_NAME];
+
+        uint8_t nodeIndex = fastybirdNodesFindNodeIndex(node.value, node.length);
+
+        if (nodeIndex == INDEX_NONE) {
             DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Node was not found\n"));
+
+            return;
+        }
+
+        const fastybird_node_t & node_details = fastybirdNodesGetNode(nodeIndex);
+
+        if (node_details.initialized == false) {
+            DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Skipping - Node is not initialized yet\n"));
+
+            return;
+        }
+
+        if (node_details.disabled == true) {
+            DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Skipping - Node is disabled\n"));
+
+            return;
         }
+
+        // Find channel index by name
+        uint8_t channelIndex = fastybirdNodesFindChannelIndex(nodeIndex, channel.value, channel.length);
+
+        if (channelIndex == INDEX_NONE) {
+            DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Node channel was not found\n"));
+
+            return;
+        }
+
+        uint8_t propertyIndex = fastybirdNodesFindChannelPropertyIndex(channelIndex, property.value, property.length);
+
+        if (propertyIndex == INDEX_NONE) {
+            DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Node channel property was not found\n"));
+
+            return;
+        }
+
+        DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Node channel property was found\n"));
+
+        _fastybirdMqttApiMqttHandleNodeChannelProperty(
+            nodeIndex,
+            channelIndex,
+            propertyIndex,
+            parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].keyword,
+            payload
+        );
     }
 #endif
 
@@ -311,80 +719,86 @@ void _fastybirdMqttApiMqttOnConnect()
 
     fastybirdResetDeviceInitialization();
 
-    String topic;
+    fastybird_topic_t topic;
 
     // Initialize device topic
-    topic = _fastybirdMqttApiCreateTopic(FASTYBIRD_TOPIC_BROADCAST);
-
-    mqttSubscribe(topic.c_str());
+    if (_fastybirdMqttApiCreateBroadcastTopic(topic)) {
+        mqttSubscribe(topic.value);
+    }
 
     // Control device topic
-    topic = _fastybirdMqttApiCreateDeviceTopicString(
-        fastybirdDeviceIdentifier().c_str(),
-        FASTYBIRD_TOPIC_DEVICE_CONTROL_RECEIVE,
-        "control",
-        "+"
-    );
-
-    mqttSubscribe(topic.c_str());
+    if (_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        _fastybird_topic_device_id,
+        FASTYBIRD_TOPIC_DEVICE_CONTROL,
+        "+",
+        FASTYBIRD_TOPIC_SUFFIX_RECEIVE
+    )) {
+        mqttSubscribe(topic.value);
+    }
 
     #if FASTYBIRD_NODES_SUPPORT
         // Control channel property request topic
-        topic = _fastybirdMqttApiCreateChannelTopicString(
+        if (_fastybirdMqttApiCreateChannelTopic(
+            topic,
             "+",
             "+",
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_RECEIVE,
-            "property",
-            "+"
-        );
-
-        mqttSubscribe(topic.c_str());
+            FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+            "+",
+            FASTYBIRD_TOPIC_SUFFIX_RECEIVE
+        )) {
+            mqttSubscribe(topic.value);
+        }
 
         // Control channel property query topic
-        topic = _fastybirdMqttApiCreateChannelTopicString(
+        if (_fastybirdMqttApiCreateChannelTopic(
+            topic,
             "+",
             "+",
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_QUERY,
-            "property",
-            "+"
-        );
-
-        mqttSubscribe(topic.c_str());
+            FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+            "+",
+            FASTYBIRD_TOPIC_SUFFIX_QUERY
+        )) {
+            mqttSubscribe(topic.value);
+        }
     #elif FASTYBIRD_MAX_CHANNELS > 0
         // Control channel property request topic
-        topic = _fastybirdMqttApiCreateChannelTopicString(
-            fastybirdDeviceIdentifier().c_str(),
+        if (_fastybirdMqttApiCreateChannelTopic(
+            topic,
+            _fastybird_topic_device_id,
             "+",
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_RECEIVE,
-            "property",
-            "+"
-        );
-
-        mqttSubscribe(topic.c_str());
+            FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+            "+",
+            FASTYBIRD_TOPIC_SUFFIX_RECEIVE
+        )) {
+            mqttSubscribe(topic.value);
+        }
 
         // Control channel property query topic
-        topic = _fastybirdMqttApiCreateChannelTopicString(
-            fastybirdDeviceIdentifier().c_str(),
+        if (_fastybirdMqttApiCreateChannelTopic(
+            topic,
+            _fastybird_topic_device_id,
             "+",
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_QUERY,
-            "property",
-            "+"
-        );
-
-        mqttSubscribe(topic.c_str());
+            FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+            "+",
+            FASTYBIRD_TOPIC_SUFFIX_QUERY
+        )) {
+            mqttSubscribe(topic.value);
+        }
     #endif
 
     #if FASTYBIRD_MAX_CHANNELS > 0
         // Control channel topic
-        topic = _fastybirdMqttApiCreateChannelTopicString(
-            fastybirdDeviceIdentifier().c_str(),
+        if (_fastybirdMqttApiCreateChannelTopic(
+            topic,
+            _fastybird_topic_device_id,
             "+",
-            FASTYBIRD_TOPIC_CHANNEL_CONTROL_RECEIVE,
-            "control",
-            "+"
-        );
-
-        mqttSubscribe(topic.c_str());
+            FASTYBIRD_TOPIC_CHANNEL_CONTROL,
+            "+",
+            FASTYBIRD_TOPIC_SUFFIX_RECEIVE
+        )) {
+            mqttSubscribe(topic.value);
+        }
     #endif
 }
 
@@ -411,148 +825,61 @@ void _fastybirdMqttApiMqttOnMessage(
         return;
     }
 
-    char topic_string[strlen(topic) + 2];
-    strcpy(topic_string, topic);
-
-    MatchState topic_match (topic_string);
-
-    // Reset topic parts storage
-    _fastybird_topic_parts.clear();
+    fastybird_topic_part_t parts[FASTYBIRD_TOPIC_PART_COUNT_MAX];
 
-    // Find how many parts are in topic
-    uint8_t parts_count = topic_match.MatchCount("[^/]+");
-
-    _fastybird_topic_parts.reserve(parts_count);
-
-    // Pull the words out (the callback will put them in the storage)
-    topic_match.GlobalMatch ("[^/]+", _fastybirdMqttApiPropertyTopicMatchCallback);
+    uint8_t parts_count = _fastybirdMqttApiTopicSplit(topic, parts);
 
     // Broadcast topic
     if (
         parts_count == FASTYBIRD_TOPIC_PART_COUNT_BROADCAST
-        && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_BROADCAST_PREFIX].equals(FASTYBIRD_TOPIC_PART_BROADCAST)
+        && parts[FASTYBIRD_TOPIC_POSITION_BROADCAST_PREFIX].keyword == FASTYBIRD_TOPIC_KEYWORD_BROADCAST
     ) {
         DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Broadcast topic\n"));
 
-        if (_fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_BROADCAST_ACTION].equals(FASTYBIRD_TOPIC_PART_INIT)) {
+        if (parts[FASTYBIRD_TOPIC_POSITION_BROADCAST_ACTION].keyword == FASTYBIRD_TOPIC_KEYWORD_INIT) {
             fastybirdResetDeviceInitialization();
         }
 
         return;
     }
 
+    if (parts_count <= FASTYBIRD_TOPIC_POSITION_DEVICE) {
+        return;
+    }
+
     // Check for device info in topic
-    if (
-        parts_count > FASTYBIRD_TOPIC_POSITION_DEVICE
-        && fastybirdDeviceIdentifier().equals(_fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_DEVICE])
-    ) {
+    if (_fastybirdMqttApiTopicPartEquals(parts[FASTYBIRD_TOPIC_POSITION_DEVICE], _fastybird_topic_device_id)) {
         // Control device topic
         if (
             parts_count == FASTYBIRD_TOPIC_PART_COUNT_DEVICE_CONTROL
-            && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_DEVICE_CONTROL_PREFIX].equals(FASTYBIRD_TOPIC_PART_CONTROL)
-            && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_DEVICE_CONTROL_ACTION].equals(FASTYBIRD_TOPIC_PART_SET)
+            && parts[FASTYBIRD_TOPIC_POSITION_DEVICE_CONTROL_PREFIX].keyword == FASTYBIRD_TOPIC_KEYWORD_CONTROL
+            && parts[FASTYBIRD_TOPIC_POSITION_DEVICE_CONTROL_ACTION].keyword == FASTYBIRD_TOPIC_KEYWORD_SET
         ) {
             DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Device control topic\n"));
 
-            fastybirdCallOnControlRegister(_fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_DEVICE_CONTROL_NAME], payload);
+            _fastybirdMqttApiMqttHandleDeviceControl(parts[FASTYBIRD_TOPIC_POSITION_DEVICE_CONTROL_NAME], payload);
 
         #if FASTYBIRD_MAX_CHANNELS > 0
-            // Control channel topic
-            } else if (
-                parts_count == FASTYBIRD_TOPIC_PART_COUNT_CHANNEL_CONTROL
-                && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PREFIX].equals(FASTYBIRD_TOPIC_PART_CHANNEL)
-                && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_CONTROL_PREFIX].equals(FASTYBIRD_TOPIC_PART_CONTROL)
-                && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_CONTROL_ACTION].equals(FASTYBIRD_TOPIC_PART_SET)
-            ) {
-                DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Channel control topic\n"));
-
-                // Configure channel
-                if (_fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_CONTROL_NAME].equals(FASTYBIRD_CHANNEL_CONTROL_CONFIGURE)) {
-                    DynamicJsonBuffer jsonBuffer;
-
-                    // Parse payload
-                    JsonObject& root = jsonBuffer.parseObject(payload);
-
-                    if (root.success()) {
-                        // Find channel index by name
-                        uint8_t channelIndex = fastybirdFindChannelIndex(_fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_NAME]);
-
-                        // Channel was found
-                        if (channelIndex != INDEX_NONE) {
-                            fastybird_channel_t channel = fastybirdGetChannel(channelIndex);
-
-                            DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Sending configuration to channel: %s\n"), channel.name.c_str());
-
-                            fastybirdCallOnChannelConfigure(channelIndex, root);
-
-                            DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Changes were saved\n"));
-
-                            DynamicJsonBuffer jsonBuffer;
-
-                            JsonObject& configuration = jsonBuffer.createObject();
-
-                            fastybirdCallReportChannelConfiguration(channelIndex, configuration);
-
-                            if (configuration.size() > 0) {
-                                fastybirdApiPropagateChannelConfiguration(channel.name.c_str(), configuration);
-                            }
-
-                            #if WEB_SUPPORT && WS_SUPPORT
-                                wsReportConfiguration();
-                            #endif
-
-                            // Reload & cache settings
-                            firmwareReload();
-
-                        } else {
-                            DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Channel to update was not found\n"));
-                        }
-
-                    } else {
-                        DEBUG_MSG(PSTR("[ERR][FASTYBIRD][API] Parsing configuration data failed\n"));
-                    }
-                }
-
-            // Set or Query channel property topic
+            // Channel topic
             } else if (
-                parts_count == FASTYBIRD_TOPIC_PART_COUNT_CHANNEL_PROPERTY
-                && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PREFIX].equals(FASTYBIRD_TOPIC_PART_CHANNEL)
-                && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_PREFIX].equals(FASTYBIRD_TOPIC_PART_PROPERTY)
-                && (
-                    _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].equals(FASTYBIRD_TOPIC_PART_SET)
-                    || _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].equals(FASTYBIRD_TOPIC_PART_QUERY)
-                )
+                parts_count > FASTYBIRD_TOPIC_POSITION_CHANNEL_PREFIX
+                && parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PREFIX].keyword == FASTYBIRD_TOPIC_KEYWORD_CHANNEL
             ) {
-                DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Channel property topic\n"));
-
-                _fastybirdMqttApiMqttHandleChannelProperty(
-                    _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_NAME],
-                    _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_NAME],
-                    _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION],
-                    payload
-                );
+                _fastybirdMqttApiMqttRouteChannel(parts, parts_count, payload);
         #endif
         }
 
     #if FASTYBIRD_NODES_SUPPORT
     } else if (
         parts_count == FASTYBIRD_TOPIC_PART_COUNT_CHANNEL_PROPERTY
-        && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PREFIX].equals(FASTYBIRD_TOPIC_PART_CHANNEL)
-        && _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_PREFIX].equals(FASTYBIRD_TOPIC_PART_PROPERTY)
+        && parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PREFIX].keyword == FASTYBIRD_TOPIC_KEYWORD_CHANNEL
+        && parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_PREFIX].keyword == FASTYBIRD_TOPIC_KEYWORD_PROPERTY
         && (
-            _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].equals(FASTYBIRD_TOPIC_PART_SET)
-            || _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].equals(FASTYBIRD_TOPIC_PART_QUERY)
+            parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].keyword == FASTYBIRD_TOPIC_KEYWORD_SET
+            || parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION].keyword == FASTYBIRD_TOPIC_KEYWORD_QUERY
         )
     ) {
-        DEBUG_MSG(PSTR("[INFO][FASTYBIRD][API] Node channel property topic\n"));
-
-        _fastybirdMqttApiMqttHandleNodeChannelProperty(
-            _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_DEVICE],
-            _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_NAME],
-            _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_NAME],
-            _fastybird_topic_parts[FASTYBIRD_TOPIC_POSITION_CHANNEL_PROPERTY_ACTION],
-            payload
-        );
+        _fastybirdMqttApiMqttRouteNodeChannelProperty(parts, payload);
     #endif
     }
 }
@@ -574,14 +901,21 @@ void fastybirdApiSetup()
     mqttOnDisconnectRegister(_fastybirdMqttApiMqttOnDisconnect);
     mqttOnMessageRegister(_fastybirdMqttApiMqttOnMessage);
 
-    char will_topic[100];
-    
-    strcpy(will_topic, _fastybirdMqttApiCreateStateTopicString(fastybirdDeviceIdentifier().c_str()).c_str());
+    _fastybirdMqttApiTopicKeywordsInitialize();
 
-    mqttSetWill(
-        will_topic,
-        FASTYBIRD_STATUS_LOST
-    );
+    // Chip ID is not changing, device topics prefix could be created only once
+    strncpy(_fastybird_topic_device_id, fastybirdDeviceIdentifier().c_str(), sizeof(_fastybird_topic_device_id) - 1);
+
+    _fastybirdMqttApiTopicCreateDevicePrefix(_fastybird_topic_own_device_prefix, _fastybird_topic_device_id);
+
+    fastybird_topic_t will_topic;
+
+    if (_fastybirdMqttApiCreateDeviceTopic(will_topic, _fastybird_topic_device_id, FASTYBIRD_TOPIC_DEVICE_STATE)) {
+        mqttSetWill(
+            will_topic.value,
+            FASTYBIRD_STATUS_LOST
+        );
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -590,82 +924,90 @@ void fastybirdApiReset()
 {
     if (mqttConnected()) {
         // Unsubscribe from all device topics
-        mqttUnsubscribe((_fastybirdMqttApiCreateDeviceTopic(fastybirdDeviceIdentifier().c_str()) + "#").c_str());
+        fastybird_topic_t topic;
 
-        String topic;
+        if (_fastybirdMqttApiCreateDeviceTopic(topic, _fastybird_topic_device_id, "#")) {
+            mqttUnsubscribe(topic.value);
+        }
 
         // Initialize device topic
-        topic = _fastybirdMqttApiCreateTopic(FASTYBIRD_TOPIC_BROADCAST);
-
-        mqttUnsubscribe(topic.c_str());
+        if (_fastybirdMqttApiCreateBroadcastTopic(topic)) {
+            mqttUnsubscribe(topic.value);
+        }
 
         // Control device topic
-        topic = _fastybirdMqttApiCreateDeviceTopicString(
-            fastybirdDeviceIdentifier().c_str(),
-            FASTYBIRD_TOPIC_DEVICE_CONTROL_RECEIVE,
-            "control",
-            "+"
-        );
-
-        mqttUnsubscribe(topic.c_str());
+        if (_fastybirdMqttApiCreateDeviceTopic(
+            topic,
+            _fastybird_topic_device_id,
+            FASTYBIRD_TOPIC_DEVICE_CONTROL,
+            "+",
+            FASTYBIRD_TOPIC_SUFFIX_RECEIVE
+        )) {
+            mqttUnsubscribe(topic.value);
+        }
 
         #if FASTYBIRD_NODES_SUPPORT
             // Control channel property request topic
-            topic = _fastybirdMqttApiCreateChannelTopicString(
+            if (_fastybirdMqttApiCreateChannelTopic(
+                topic,
                 "+",
                 "+",
-                FASTYBIRD_TOPIC_CHANNEL_PROPERTY_RECEIVE,
-                "property",
-                "+"
-            );
-
-            mqttUnsubscribe(topic.c_str());
+                FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+                "+",
+                FASTYBIRD_TOPIC_SUFFIX_RECEIVE
+            )) {
+                mqttUnsubscribe(topic.value);
+            }
 
             // Control channel property query topic
-            topic = _fastybirdMqttApiCreateChannelTopicString(
+            if (_fastybirdMqttApiCreateChannelTopic(
+                topic,
                 "+",
                 "+",
-                FASTYBIRD_TOPIC_CHANNEL_PROPERTY_QUERY,
-                "property",
-                "+"
-            );
-
-            mqttUnsubscribe(topic.c_str());
+                FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+                "+",
+                FASTYBIRD_TOPIC_SUFFIX_QUERY
+            )) {
+                mqttUnsubscribe(topic.value);
+            }
         #elif FASTYBIRD_MAX_CHANNELS > 0
             // Control channel property request topic
-            topic = _fastybirdMqttApiCreateChannelTopicString(
-                fastybirdDeviceIdentifier().c_str(),
+            if (_fastybirdMqttApiCreateChannelTopic(
+                topic,
+                _fastybird_topic_device_id,
                 "+",
-                FASTYBIRD_TOPIC_CHANNEL_PROPERTY_RECEIVE,
-                "property",
-                "+"
-            );
-
-            mqttUnsubscribe(topic.c_str());
+                FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+                "+",
+                FASTYBIRD_TOPIC_SUFFIX_RECEIVE
+            )) {
+                mqttUnsubscribe(topic.value);
+            }
 
             // Control channel property query topic
-            topic = _fastybirdMqttApiCreateChannelTopicString(
-                fastybirdDeviceIdentifier().c_str(),
+            if (_fastybirdMqttApiCreateChannelTopic(
+                topic,
+                _fastybird_topic_device_id,
                 "+",
-                FASTYBIRD_TOPIC_CHANNEL_PROPERTY_QUERY,
-                "property",
-                "+"
-            );
-
-            mqttUnsubscribe(topic.c_str());
+                FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+                "+",
+                FASTYBIRD_TOPIC_SUFFIX_QUERY
+            )) {
+                mqttUnsubscribe(topic.value);
+            }
         #endif
 
         #if FASTYBIRD_MAX_CHANNELS > 0
             // Control channel topic
-            topic = _fastybirdMqttApiCreateChannelTopicString(
-                fastybirdDeviceIdentifier().c_str(),
+            if (_fastybirdMqttApiCreateChannelTopic(
+                topic,
+                _fastybird_topic_device_id,
                 "+",
-                FASTYBIRD_TOPIC_CHANNEL_CONTROL_RECEIVE,
-                "control",
-                "+"
-            );
-
-            mqttUnsubscribe(topic.c_str());
+                FASTYBIRD_TOPIC_CHANNEL_CONTROL,
+                "+",
+                FASTYBIRD_TOPIC_SUFFIX_RECEIVE
+            )) {
+                mqttUnsubscribe(topic.value);
+            }
         #endif
     }
 }
@@ -674,37 +1016,18 @@ void fastybirdApiReset()
 
 void fastybirdApiOnHeartbeat()
 {
-    mqttSend(
-        _fastybirdMqttApiCreatePropertyTopicString(fastybirdDeviceIdentifier().c_str(), FASTYBIRD_PROPERTY_FREE_HEAP).c_str(),
-        String(getFreeHeap()).c_str()
-    );
-
-    mqttSend(
-        _fastybirdMqttApiCreatePropertyTopicString(fastybirdDeviceIdentifier().c_str(), FASTYBIRD_PROPERTY_UPTIME).c_str(),
-        String(getUptime()).c_str()
-    );
+    fastybirdApiPropagateDevicePropertyValue(FASTYBIRD_PROPERTY_FREE_HEAP, String(getFreeHeap()).c_str());
+    fastybirdApiPropagateDevicePropertyValue(FASTYBIRD_PROPERTY_UPTIME, String(getUptime()).c_str());
 
     #if WIFI_SUPPORT
-        mqttSend(
-            _fastybirdMqttApiCreatePropertyTopicString(fastybirdDeviceIdentifier().c_str(), FASTYBIRD_PROPERTY_RSSI).c_str(),
-            String(WiFi.RSSI()).c_str()
-        );
-        mqttSend(
-            _fastybirdMqttApiCreatePropertyTopicString(fastybirdDeviceIdentifier().c_str(), FASTYBIRD_PROPERTY_SSID).c_str(),
-            getNetwork().c_str()
-        );
+        fastybirdApiPropagateDevicePropertyValue(FASTYBIRD_PROPERTY_RSSI, String(WiFi.RSSI()).c_str());
+        fastybirdApiPropagateDevicePropertyValue(FASTYBIRD_PROPERTY_SSID, getNetwork().c_str());
     #endif
 
-    mqttSend(
-        _fastybirdMqttApiCreatePropertyTopicString(fastybirdDeviceIdentifier().c_str(), FASTYBIRD_PROPERTY_CPU_LOAD).c_str(),
-        String(systemLoadAverage()).c_str()
-    );
+    fastybirdApiPropagateDevicePropertyValue(FASTYBIRD_PROPERTY_CPU_LOAD, String(systemLoadAverage()).c_str());
 
     #if ADC_MODE_VALUE == ADC_VCC
-        mqttSend(
-            _fastybirdMqttApiCreatePropertyTopicString(fastybirdDeviceIdentifier().c_str(), FASTYBIRD_PROPERTY_VCC).c_str(),
-            String(ESP.getVcc()).c_str()
-        );
+        fastybirdApiPropagateDevicePropertyValue(FASTYBIRD_PROPERTY_VCC, String(ESP.getVcc()).c_str());
     #endif
 }
 
@@ -718,8 +1041,18 @@ bool fastybirdApiPropagateDeviceState(
 
     bool retain = false;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_STATE
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateStateTopicString(deviceId).c_str(),
+        topic.value,
         payload,
         true
     );
@@ -734,7 +1067,7 @@ bool fastybirdApiPropagateDeviceState(
 bool fastybirdApiPropagateDeviceState(
     const char * payload
 ) {
-    return fastybirdApiPropagateDeviceState(fastybirdDeviceIdentifier().c_str(), payload);
+    return fastybirdApiPropagateDeviceState(_fastybird_topic_device_id, payload);
 }
 
 // -----------------------------------------------------------------------------
@@ -745,7 +1078,15 @@ bool fastybirdApiPropagateDevicePropertiesNames(
 ) {
     uint8_t packet_id;
 
-    String topic = _fastybirdMqttApiCreateDeviceTopicString(deviceId, FASTYBIRD_TOPIC_DEVICE_PROPERTIES_STRUCTURE);
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_PROPERTIES_STRUCTURE
+    )) {
+        return false;
+    }
 
     if (properties.size() > 0) {
         char payload[80];
@@ -758,7 +1099,7 @@ bool fastybirdApiPropagateDevicePropertiesNames(
         }
 
         packet_id = mqttSend(
-            topic.c_str(),
+            topic.value,
             payload,
             false
         );
@@ -767,7 +1108,7 @@ bool fastybirdApiPropagateDevicePropertiesNames(
 
     } else {
         packet_id = mqttSend(
-            topic.c_str(),
+            topic.value,
             "",
             false
         );
@@ -783,7 +1124,7 @@ bool fastybirdApiPropagateDevicePropertiesNames(
 bool fastybirdApiPropagateDevicePropertiesNames(
     std::vector<String> properties
 ) {
-    return fastybirdApiPropagateDevicePropertiesNames(fastybirdDeviceIdentifier().c_str(), properties);
+    return fastybirdApiPropagateDevicePropertiesNames(_fastybird_topic_device_id, properties);
 }
 
 // -----------------------------------------------------------------------------
@@ -797,8 +1138,20 @@ bool fastybirdApiPropagateDevicePropertyValue(
 
     bool retain = false;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_PROPERTY,
+        property,
+        FASTYBIRD_TOPIC_SUFFIX_NONE
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreatePropertyTopicString(deviceId, property).c_str(),
+        topic.value,
         payload,
         true
     );
@@ -814,7 +1167,7 @@ bool fastybirdApiPropagateDevicePropertyValue(
     const char * property,
     const char * payload
 ) {
-    return fastybirdApiPropagateDevicePropertyValue(fastybirdDeviceIdentifier().c_str(), property, payload);
+    return fastybirdApiPropagateDevicePropertyValue(_fastybird_topic_device_id, property, payload);
 }
 
 // -----------------------------------------------------------------------------
@@ -825,8 +1178,18 @@ bool fastybirdApiPropagateDeviceName(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_NAME
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateDeviceTopicString(deviceId, FASTYBIRD_TOPIC_DEVICE_NAME).c_str(),
+        topic.value,
         name,
         false
     );
@@ -841,7 +1204,7 @@ bool fastybirdApiPropagateDeviceName(
 bool fastybirdApiPropagateDeviceName(
     const char * name
 ) {
-    return fastybirdApiPropagateDeviceName(fastybirdDeviceIdentifier().c_str(), name);
+    return fastybirdApiPropagateDeviceName(_fastybird_topic_device_id, name);
 }
 
 // -----------------------------------------------------------------------------
@@ -852,8 +1215,18 @@ bool fastybirdApiPropagateDeviceParent(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_PARENT
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateDeviceTopicString(deviceId, FASTYBIRD_TOPIC_DEVICE_PARENT).c_str(),
+        topic.value,
         parent,
         false
     );
@@ -872,8 +1245,20 @@ bool fastybirdApiPropagateDeviceHardwareField(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_HW_INFO,
+        field,
+        FASTYBIRD_TOPIC_SUFFIX_NONE
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateHWTopicString(deviceId, field).c_str(),
+        topic.value,
         payload,
         false
     );
@@ -889,7 +1274,7 @@ bool fastybirdApiPropagateDeviceHardwareField(
     const char * field,
     const char * payload
 ) {
-    return fastybirdApiPropagateDeviceHardwareField(fastybirdDeviceIdentifier().c_str(), field, payload);
+    return fastybirdApiPropagateDeviceHardwareField(_fastybird_topic_device_id, field, payload);
 }
 
 // -----------------------------------------------------------------------------
@@ -906,7 +1291,7 @@ bool fastybirdApiPropagateDeviceHardwareVersion(
 bool fastybirdApiPropagateDeviceHardwareVersion(
     const char * name
 ) {
-    return fastybirdApiPropagateDeviceHardwareVersion(fastybirdDeviceIdentifier().c_str(), name);
+    return fastybirdApiPropagateDeviceHardwareVersion(_fastybird_topic_device_id, name);
 }
 
 // -----------------------------------------------------------------------------
@@ -923,7 +1308,7 @@ bool fastybirdApiPropagateDeviceHardwareModelName(
 bool fastybirdApiPropagateDeviceHardwareModelName(
     const char * model
 ) {
-    return fastybirdApiPropagateDeviceHardwareModelName(fastybirdDeviceIdentifier().c_str(), model);
+    return fastybirdApiPropagateDeviceHardwareModelName(_fastybird_topic_device_id, model);
 }
 
 // -----------------------------------------------------------------------------
@@ -940,7 +1325,7 @@ bool fastybirdApiPropagateDeviceHardwareManufacturer(
 bool fastybirdApiPropagateDeviceHardwareManufacturer(
     const char * manufacturer
 ) {
-    return fastybirdApiPropagateDeviceHardwareManufacturer(fastybirdDeviceIdentifier().c_str(), manufacturer);
+    return fastybirdApiPropagateDeviceHardwareManufacturer(_fastybird_topic_device_id, manufacturer);
 }
 
 // -----------------------------------------------------------------------------
@@ -957,7 +1342,7 @@ bool fastybirdApiPropagateDeviceHardwareSerialNumber(
 bool fastybirdApiPropagateDeviceHardwareSerialNumber(
     const char * serialNumber
 ) {
-    return fastybirdApiPropagateDeviceHardwareSerialNumber(fastybirdDeviceIdentifier().c_str(), serialNumber);
+    return fastybirdApiPropagateDeviceHardwareSerialNumber(_fastybird_topic_device_id, serialNumber);
 }
 
 // -----------------------------------------------------------------------------
@@ -969,8 +1354,20 @@ bool fastybirdApiPropagateDeviceFirmwareField(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_FW_INFO,
+        field,
+        FASTYBIRD_TOPIC_SUFFIX_NONE
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateFWTopicString(deviceId, field).c_str(),
+        topic.value,
         payload,
         false
     );
@@ -986,7 +1383,7 @@ bool fastybirdApiPropagateDeviceFirmwareField(
     const char * field,
     const char * payload
 ) {
-    return fastybirdApiPropagateDeviceFirmwareField(fastybirdDeviceIdentifier().c_str(), field, payload);
+    return fastybirdApiPropagateDeviceFirmwareField(_fastybird_topic_device_id, field, payload);
 }
 
 // -----------------------------------------------------------------------------
@@ -1003,7 +1400,7 @@ bool fastybirdApiPropagateDeviceFirmwareName(
 bool fastybirdApiPropagateDeviceFirmwareName(
     const char * name
 ) {
-    return fastybirdApiPropagateDeviceFirmwareName(fastybirdDeviceIdentifier().c_str(), name);
+    return fastybirdApiPropagateDeviceFirmwareName(_fastybird_topic_device_id, name);
 }
 
 // -----------------------------------------------------------------------------
@@ -1020,7 +1417,7 @@ bool fastybirdApiPropagateDeviceFirmwareManufacturer(
 bool fastybirdApiPropagateDeviceFirmwareManufacturer(
     const char * manufacturer
 ) {
-    return fastybirdApiPropagateDeviceFirmwareManufacturer(fastybirdDeviceIdentifier().c_str(), manufacturer);
+    return fastybirdApiPropagateDeviceFirmwareManufacturer(_fastybird_topic_device_id, manufacturer);
 }
 
 // -----------------------------------------------------------------------------
@@ -1038,7 +1435,7 @@ bool fastybirdApiPropagateDeviceFirmwareVersion(
 bool fastybirdApiPropagateDeviceFirmwareVersion(
     const char * version
 ) {
-    return fastybirdApiPropagateDeviceFirmwareVersion(fastybirdDeviceIdentifier().c_str(), version);
+    return fastybirdApiPropagateDeviceFirmwareVersion(_fastybird_topic_device_id, version);
 }
 
 // -----------------------------------------------------------------------------
@@ -1051,6 +1448,16 @@ bool fastybirdApiPropagateDeviceChannelsNames(
 
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_CHANNELS
+    )) {
+        return false;
+    }
+
     if (channels.size() > 0) {
         char formatted_channels[300];
 
@@ -1062,14 +1469,14 @@ bool fastybirdApiPropagateDeviceChannelsNames(
         }
 
         packet_id = mqttSend(
-            _fastybirdMqttApiCreateDeviceTopicString(deviceId, FASTYBIRD_TOPIC_DEVICE_CHANNELS).c_str(),
+            topic.value,
             formatted_channels,
             false
         );
 
     } else {
         packet_id = mqttSend(
-            _fastybirdMqttApiCreateDeviceTopicString(deviceId, FASTYBIRD_TOPIC_DEVICE_CHANNELS).c_str(),
+            topic.value,
             "",
             false
         );
@@ -1087,7 +1494,7 @@ bool fastybirdApiPropagateDeviceChannelsNames(
 bool fastybirdApiPropagateDeviceChannelsNames(
     std::vector<String> channels
 ) {
-    return fastybirdApiPropagateDeviceChannelsNames(fastybirdDeviceIdentifier().c_str(), channels);
+    return fastybirdApiPropagateDeviceChannelsNames(_fastybird_topic_device_id, channels);
 }
 
 // -----------------------------------------------------------------------------
@@ -1111,8 +1518,18 @@ bool fastybirdApiPropagateDeviceControlNames(
 
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateDeviceTopic(
+        topic,
+        deviceId,
+        FASTYBIRD_TOPIC_DEVICE_CONTROL
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateDeviceTopicString(deviceId, FASTYBIRD_TOPIC_DEVICE_CONTROL).c_str(),
+        topic.value,
         payload,
         false
     );
@@ -1128,7 +1545,7 @@ bool fastybirdApiPropagateDeviceControlNames(
     std::vector<String> controls
 ) {
     return fastybirdApiPropagateDeviceControlNames(
-        fastybirdDeviceIdentifier().c_str(),
+        _fastybird_topic_device_id,
         controls
     );
 }
@@ -1146,13 +1563,20 @@ bool fastybirdApiPropagateDeviceConfigurationSchema(
 
         schema.printTo(output);
 
+        fastybird_topic_t topic;
+
+        if (!_fastybirdMqttApiCreateDeviceTopic(
+            topic,
+            deviceId,
+            FASTYBIRD_TOPIC_DEVICE_CONTROL,
+            FASTYBIRD_DEVICE_CONTROL_CONFIGURE,
+            FASTYBIRD_TOPIC_SUFFIX_SCHEMA
+        )) {
+            return false;
+        }
+
         packet_id = mqttSend(
-            _fastybirdMqttApiCreateDeviceTopicString(
-                deviceId,
-                FASTYBIRD_TOPIC_DEVICE_CONTROL_SCHEMA,
-                "control",
-                FASTYBIRD_DEVICE_CONTROL_CONFIGURE
-            ).c_str(),
+            topic.value,
             output.c_str(),
             false
         );
@@ -1168,7 +1592,7 @@ bool fastybirdApiPropagateDeviceConfigurationSchema(
 bool fastybirdApiPropagateDeviceConfigurationSchema(
     JsonArray& schema
 ) {
-    return fastybirdApiPropagateDeviceConfigurationSchema(fastybirdDeviceIdentifier().c_str(), schema);
+    return fastybirdApiPropagateDeviceConfigurationSchema(_fastybird_topic_device_id, schema);
 }
 
 // -----------------------------------------------------------------------------
@@ -1184,13 +1608,20 @@ bool fastybirdApiPropagateDeviceConfiguration(
 
         uint8_t packet_id;
 
+        fastybird_topic_t topic;
+
+        if (!_fastybirdMqttApiCreateDeviceTopic(
+            topic,
+            deviceId,
+            FASTYBIRD_TOPIC_DEVICE_CONTROL,
+            FASTYBIRD_DEVICE_CONTROL_CONFIGURE,
+            FASTYBIRD_TOPIC_SUFFIX_NONE
+        )) {
+            return false;
+        }
+
         packet_id = mqttSend(
-            _fastybirdMqttApiCreateDeviceTopicString(
-                deviceId,
-                FASTYBIRD_TOPIC_DEVICE_CONTROL_DATA,
-                "control",
-                FASTYBIRD_DEVICE_CONTROL_CONFIGURE
-            ).c_str(),
+            topic.value,
             output.c_str(),
             false
         );
@@ -1206,7 +1637,7 @@ bool fastybirdApiPropagateDeviceConfiguration(
 bool fastybirdApiPropagateDeviceConfiguration(
     JsonObject& configuration
 ) {
-    return fastybirdApiPropagateDeviceConfiguration(fastybirdDeviceIdentifier().c_str(), configuration);
+    return fastybirdApiPropagateDeviceConfiguration(_fastybird_topic_device_id, configuration);
 }
 
 // -----------------------------------------------------------------------------
@@ -1218,12 +1649,19 @@ bool fastybirdApiPropagateChannelName(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
+        deviceId,
+        channel,
+        FASTYBIRD_TOPIC_CHANNEL_NAME
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateChannelTopicString(
-            deviceId,
-            channel,
-            FASTYBIRD_TOPIC_CHANNEL_NAME
-        ).c_str(),
+        topic.value,
         name,
         false
     );
@@ -1239,7 +1677,7 @@ bool fastybirdApiPropagateChannelName(
     const char * channel,
     const char * name
 ) {
-    return fastybirdApiPropagateChannelName(fastybirdDeviceIdentifier().c_str(), channel, name);
+    return fastybirdApiPropagateChannelName(_fastybird_topic_device_id, channel, name);
 }
 
 // -----------------------------------------------------------------------------
@@ -1251,11 +1689,16 @@ bool fastybirdApiPropagateChannelPropertiesNames(
 ) {
     uint8_t packet_id;
 
-    String topic = _fastybirdMqttApiCreateChannelTopicString(
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
         deviceId,
         channel,
         FASTYBIRD_TOPIC_CHANNEL_PROPERTIES
-    );
+    )) {
+        return false;
+    }
 
     if (properties.size() > 0) {
         char formatted_properties[100];
@@ -1268,7 +1711,7 @@ bool fastybirdApiPropagateChannelPropertiesNames(
         }
 
         packet_id = mqttSend(
-            topic.c_str(),
+            topic.value,
             formatted_properties,
             false
         );
@@ -1277,7 +1720,7 @@ bool fastybirdApiPropagateChannelPropertiesNames(
 
     } else {
         packet_id = mqttSend(
-            topic.c_str(),
+            topic.value,
             "",
             false
         );
@@ -1294,7 +1737,7 @@ bool fastybirdApiPropagateChannelPropertiesNames(
     const char * channel,
     std::vector<String> properties
 ) {
-    return fastybirdApiPropagateChannelPropertiesNames(fastybirdDeviceIdentifier().c_str(), channel, properties);
+    return fastybirdApiPropagateChannelPropertiesNames(_fastybird_topic_device_id, channel, properties);
 }
 
 // -----------------------------------------------------------------------------
@@ -1307,14 +1750,21 @@ bool fastybirdApiPropagateChannelPropertyName(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
+        deviceId,
+        channel,
+        FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+        property,
+        FASTYBIRD_TOPIC_SUFFIX_NAME
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateChannelTopicString(
-            deviceId,
-            channel,
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_NAME,
-            "property",
-            property
-        ).c_str(),
+        topic.value,
         name,
         false
     );
@@ -1331,7 +1781,7 @@ bool fastybirdApiPropagateChannelPropertyName(
     const char * property,
     const char * name
 ) {
-    return fastybirdApiPropagateChannelPropertyName(fastybirdDeviceIdentifier().c_str(), channel, property, name);
+    return fastybirdApiPropagateChannelPropertyName(_fastybird_topic_device_id, channel, property, name);
 }
 
 // -----------------------------------------------------------------------------
@@ -1344,14 +1794,21 @@ bool fastybirdApiPropagateChannelPropertySettable(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
+        deviceId,
+        channel,
+        FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+        property,
+        FASTYBIRD_TOPIC_SUFFIX_SETTABLE
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateChannelTopicString(
-            deviceId,
-            channel,
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_SETTABLE,
-            "property",
-            property
-        ).c_str(),
+        topic.value,
         settable ? FASTYBIRD_PROPERTY_IS_SETTABLE : FASTYBIRD_PROPERTY_IS_NOT_SETTABLE,
         false
     );
@@ -1368,7 +1825,7 @@ bool fastybirdApiPropagateChannelPropertySettable(
     const char * property,
     bool settable
 ) {
-    return fastybirdApiPropagateChannelPropertySettable(fastybirdDeviceIdentifier().c_str(), channel, property, settable);
+    return fastybirdApiPropagateChannelPropertySettable(_fastybird_topic_device_id, channel, property, settable);
 }
 
 // -----------------------------------------------------------------------------
@@ -1381,14 +1838,21 @@ bool fastybirdApiPropagateChannelPropertyQueryable(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
+        deviceId,
+        channel,
+        FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+        property,
+        FASTYBIRD_TOPIC_SUFFIX_QUERYABLE
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateChannelTopicString(
-            deviceId,
-            channel,
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_QUERYABLE,
-            "property",
-            property
-        ).c_str(),
+        topic.value,
         queryable ? FASTYBIRD_PROPERTY_IS_QUERYABLE : FASTYBIRD_PROPERTY_IS_NOT_QUERYABLE,
         false
     );
@@ -1405,7 +1869,7 @@ bool fastybirdApiPropagateChannelPropertyQueryable(
     const char * property,
     bool queryable
 ) {
-    return fastybirdApiPropagateChannelPropertyQueryable(fastybirdDeviceIdentifier().c_str(), channel, property, queryable);
+    return fastybirdApiPropagateChannelPropertyQueryable(_fastybird_topic_device_id, channel, property, queryable);
 }
 
 // -----------------------------------------------------------------------------
@@ -1418,14 +1882,21 @@ bool fastybirdApiPropagateChannelPropertyDataType(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
+        deviceId,
+        channel,
+        FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+        property,
+        FASTYBIRD_TOPIC_SUFFIX_DATA_TYPE
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateChannelTopicString(
-            deviceId,
-            channel,
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_DATA_TYPE,
-            "property",
-            property
-        ).c_str(),
+        topic.value,
         dataType,
         false
     );
@@ -1442,7 +1913,7 @@ bool fastybirdApiPropagateChannelPropertyDataType(
     const char * property,
     const char * dataType
 ) {
-    return fastybirdApiPropagateChannelPropertyDataType(fastybirdDeviceIdentifier().c_str(), channel, property, dataType);
+    return fastybirdApiPropagateChannelPropertyDataType(_fastybird_topic_device_id, channel, property, dataType);
 }
 
 // -----------------------------------------------------------------------------
@@ -1455,14 +1926,21 @@ bool fastybirdApiPropagateChannelPropertyUnit(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
+        deviceId,
+        channel,
+        FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+        property,
+        FASTYBIRD_TOPIC_SUFFIX_UNIT
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateChannelTopicString(
-            deviceId,
-            channel,
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_UNIT,
-            "property",
-            property
-        ).c_str(),
+        topic.value,
         unit,
         false
     );
@@ -1479,7 +1957,7 @@ bool fastybirdApiPropagateChannelPropertyUnit(
     const char * property,
     const char * unit
 ) {
-    return fastybirdApiPropagateChannelPropertyUnit(fastybirdDeviceIdentifier().c_str(), channel, property, unit);
+    return fastybirdApiPropagateChannelPropertyUnit(_fastybird_topic_device_id, channel, property, unit);
 }
 
 // -----------------------------------------------------------------------------
@@ -1492,14 +1970,21 @@ bool fastybirdApiPropagateChannelPropertyFormat(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
+        deviceId,
+        channel,
+        FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+        property,
+        FASTYBIRD_TOPIC_SUFFIX_FORMAT
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateChannelTopicString(
-            deviceId,
-            channel,
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY_FORMAT,
-            "property",
-            property
-        ).c_str(),
+        topic.value,
         format,
         false
     );
@@ -1516,7 +2001,7 @@ bool fastybirdApiPropagateChannelPropertyFormat(
     const char * property,
     const char * format
 ) {
-    return fastybirdApiPropagateChannelPropertyFormat(fastybirdDeviceIdentifier().c_str(), channel, property, format);
+    return fastybirdApiPropagateChannelPropertyFormat(_fastybird_topic_device_id, channel, property, format);
 }
 
 // -----------------------------------------------------------------------------
@@ -1528,11 +2013,16 @@ bool fastybirdApiPropagateChannelControlNames(
 ) {
     uint8_t packet_id;
 
-    String topic = _fastybirdMqttApiCreateChannelTopicString(
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
         deviceId,
         channel,
         FASTYBIRD_TOPIC_CHANNEL_CONTROL
-    );
+    )) {
+        return false;
+    }
 
     if (controls.size() > 0) {
         char payload[80];
@@ -1545,7 +2035,7 @@ bool fastybirdApiPropagateChannelControlNames(
         }
 
         packet_id = mqttSend(
-            topic.c_str(),
+            topic.value,
             payload,
             false
         );
@@ -1554,7 +2044,7 @@ bool fastybirdApiPropagateChannelControlNames(
 
     } else {
         packet_id = mqttSend(
-            topic.c_str(),
+            topic.value,
             "",
             false
         );
@@ -1571,7 +2061,7 @@ bool fastybirdApiPropagateChannelControlNames(
     const char * channel,
     std::vector<String> controls
 ) {
-    return fastybirdApiPropagateChannelControlNames(fastybirdDeviceIdentifier().c_str(), channel, controls);
+    return fastybirdApiPropagateChannelControlNames(_fastybird_topic_device_id, channel, controls);
 }
 
 // -----------------------------------------------------------------------------
@@ -1588,14 +2078,21 @@ bool fastybirdApiPropagateChannelConfigurationSchema(
 
         schema.printTo(output);
 
+        fastybird_topic_t topic;
+
+        if (!_fastybirdMqttApiCreateChannelTopic(
+            topic,
+            deviceId,
+            channel,
+            FASTYBIRD_TOPIC_CHANNEL_CONTROL,
+            FASTYBIRD_CHANNEL_CONTROL_CONFIGURE,
+            FASTYBIRD_TOPIC_SUFFIX_SCHEMA
+        )) {
+            return false;
+        }
+
         packet_id = mqttSend(
-            _fastybirdMqttApiCreateChannelTopicString(
-                deviceId,
-                channel,
-                FASTYBIRD_TOPIC_CHANNEL_CONTROL_SCHEMA,
-                "control",
-                FASTYBIRD_CHANNEL_CONTROL_CONFIGURE
-            ).c_str(),
+            topic.value,
             output.c_str(),
             false
         );
@@ -1612,7 +2109,7 @@ bool fastybirdApiPropagateChannelConfigurationSchema(
     const char * channel,
     JsonArray& schema
 ) {
-    return fastybirdApiPropagateChannelConfigurationSchema(fastybirdDeviceIdentifier().c_str(), channel, schema);
+    return fastybirdApiPropagateChannelConfigurationSchema(_fastybird_topic_device_id, channel, schema);
 }
 
 // -----------------------------------------------------------------------------
@@ -1627,20 +2124,23 @@ bool fastybirdApiPropagateChannelConfiguration(
 
         configuration.printTo(output);
 
-        String topic;
+        fastybird_topic_t topic;
 
-        topic = _fastybirdMqttApiCreateChannelTopicString(
+        if (!_fastybirdMqttApiCreateChannelTopic(
+            topic,
             deviceId,
             channel,
-            FASTYBIRD_TOPIC_CHANNEL_CONTROL_DATA,
-            "control",
-            FASTYBIRD_CHANNEL_CONTROL_CONFIGURE
-        );
+            FASTYBIRD_TOPIC_CHANNEL_CONTROL,
+            FASTYBIRD_CHANNEL_CONTROL_CONFIGURE,
+            FASTYBIRD_TOPIC_SUFFIX_NONE
+        )) {
+            return false;
+        }
 
         uint8_t packet_id;
 
         packet_id = mqttSend(
-            topic.c_str(),
+            topic.value,
             output.c_str(),
             false
         );
@@ -1657,7 +2157,7 @@ bool fastybirdApiPropagateChannelConfiguration(
     const char * channel,
     JsonObject& configuration
 ) {
-    return fastybirdApiPropagateChannelConfiguration(fastybirdDeviceIdentifier().c_str(), channel, configuration);
+    return fastybirdApiPropagateChannelConfiguration(_fastybird_topic_device_id, channel, configuration);
 }
 
 // -----------------------------------------------------------------------------
@@ -1670,14 +2170,21 @@ bool fastybirdApiPropagateChannelPropertyValue(
 ) {
     uint8_t packet_id;
 
+    fastybird_topic_t topic;
+
+    if (!_fastybirdMqttApiCreateChannelTopic(
+        topic,
+        deviceId,
+        channel,
+        FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
+        property,
+        FASTYBIRD_TOPIC_SUFFIX_NONE
+    )) {
+        return false;
+    }
+
     packet_id = mqttSend(
-        _fastybirdMqttApiCreateChannelTopicString(
-            deviceId,
-            channel,
-            FASTYBIRD_TOPIC_CHANNEL_PROPERTY,
-            "property",
-            property
-        ).c_str(),
+        topic.value,
         payload,
         true
     );
@@ -1694,7 +2201,7 @@ bool fastybirdApiPropagateChannelPropertyValue(
     const char * property,
     const char * payload
 ) {
-    return fastybirdApiPropagateChannelPropertyValue(fastybirdDeviceIdentifier().c_str(), channel, property, payload);
+    return fastybirdApiPropagateChannelPropertyValue(_fastybird_topic_device_id, channel, property, payload);
 }
 
 #endif
@@ -26,6 +26,10 @@ std::vector<fastybird_channel_t> _fastybird_channels;
 // Registered properties
 std::vector<fastybird_property_t> _fastybird_properties;
 
+// Name lookup indexes, channels by name & channels properties by channel and name
+fastybird_index_t _fastybird_channels_index;
+fastybird_index_t _fastybird_channels_properties_index;
+
 // Device callbacks - each module could register own callback
 std::vector<fastybird_on_connect_callback_f> _fastybird_on_connect_callbacks;
 std::vector<fastybird_on_report_configuration_schema_callback_f> _fastybird_report_configuration_schema_callbacks;
@@ -42,6 +46,42 @@ std::vector<fastybird_on_channel_configure_callback_f> _fastybird_on_channel_con
 // MODULE PRIVATE
 // -----------------------------------------------------------------------------
 
+void _fastybirdRebuildChannelsIndex()
+{
+    fastybirdIndexReset(_fastybird_channels_index, _fastybird_channels.size());
+
+    for (uint8_t i = 0; i < _fastybird_channels.size(); i++) {
+        fastybirdIndexInsert(_fastybird_channels_index, _fastybird_channels[i].hash, i);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void _fastybirdRebuildChannelsPropertiesIndex()
+{
+    uint16_t count = 0;
+
+    for (uint8_t i = 0; i < _fastybird_channels.size(); i++) {
+        count += _fastybird_channels[i].properties.size();
+    }
+
+    fastybirdIndexReset(_fastybird_channels_properties_index, count);
+
+    for (uint8_t i = 0; i < _fastybird_channels.size(); i++) {
+        for (uint8_t j = 0; j < _fastybird_channels[i].properties.size(); j++) {
+            uint8_t property_index = _fastybird_channels[i].properties[j];
+
+            fastybirdIndexInsert(
+                _fastybird_channels_properties_index,
+                fastybirdIndexKey(_fastybird_properties[property_index].hash, i),
+                ((uint16_t) i << 8) | property_index
+            );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 #if FASTYBIRD_MAX_CHANNELS > 0
     void _fastybirdInitializeChannels()
     {
@@ -97,7 +137,11 @@ std::vector<fastybird_on_channel_configure_callback_f> _fastybird_on_channel_con
                         });
                         break;
                 }
+
+                _fastybird_channels[i].hash = fastybirdNameHash(_fastybird_channels[i].name.c_str());
             }
+
+            _fastybirdRebuildChannelsIndex();
         }
     }
 #endif
@@ -155,8 +199,8 @@ std::vector<fastybird_on_channel_configure_callback_f> _fastybird_on_channel_con
             return true;
         }
 
-        fastybird_channel_t channel = _fastybird_channels[channelIndex];
-        fastybird_property_t property = _fastybird_properties[propertyIndex];
+        const fastybird_channel_t & channel = _fastybird_channels[channelIndex];
+        const fastybird_property_t & property = _fastybird_properties[propertyIndex];
 
         switch (_fastybird_channel_property_advertisement_progress)
         {
@@ -241,7 +285,7 @@ std::vector<fastybird_on_channel_configure_callback_f> _fastybird_on_channel_con
         std::vector<String> channel_properties;
         std::vector<String> channel_controls;
 
-        fastybird_channel_t channel = _fastybird_channels[channelIndex];
+        const fastybird_channel_t & channel = _fastybird_channels[channelIndex];
 
         switch (_fastybird_channel_advertisement_progress)
         {
@@ -689,12 +733,18 @@ void fastybirdOnControlRegister(
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Call control callbacks, action could be part of longer string eg. received topic
+ */
 void fastybirdCallOnControlRegister(
-    String action,
+    const char * action,
+    const size_t length,
     const char * payload
 ) {
     for (uint8_t i = 0; i < _fastybird_on_control_callbacks.size(); i++) {
-        if (_fastybird_on_control_callbacks[i].controlName.equals(action)) {
+        const String & control = _fastybird_on_control_callbacks[i].controlName;
+
+        if (control.length() == length && strncmp(control.c_str(), action, length) == 0) {
             _fastybird_on_control_callbacks[i].callback(payload);
         }
     }
@@ -702,6 +752,15 @@ void fastybirdCallOnControlRegister(
 
 // -----------------------------------------------------------------------------
 
+void fastybirdCallOnControlRegister(
+    String action,
+    const char * payload
+) {
+    fastybirdCallOnControlRegister(action.c_str(), action.length(), payload);
+}
+
+// -----------------------------------------------------------------------------
+
 void fastybirdReportConfigurationSchemaRegister(
     fastybird_on_report_configuration_schema_callback_f callback
 ) {
@@ -761,6 +820,81 @@ bool fastybirdIsDeviceInitialzed()
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Case insensitive FNV-1a hash of name, registries store it to skip comparing not matching names
+ */
+uint32_t fastybirdNameHash(
+    const char * name,
+    const size_t length
+) {
+    uint32_t hash = 2166136261UL;
+
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t) tolower(name[i])) * 16777619UL;
+    }
+
+    return hash;
+}
+
+// -----------------------------------------------------------------------------
+
+uint32_t fastybirdNameHash(
+    const char * name
+) {
+    return fastybirdNameHash(name, strlen(name));
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Clear index and size it for given count of entries
+ */
+void fastybirdIndexReset(
+    fastybird_index_t & index,
+    const uint16_t count
+) {
+    uint16_t size = FASTYBIRD_INDEX_MIN_SIZE;
+
+    // At least one slot have to stay empty, so every lookup ends
+    while (size < (count * 2)) {
+        size = size << 1;
+    }
+
+    index.assign(size, FASTYBIRD_INDEX_EMPTY);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Key of entry scoped by its owner, same names of different owners are spread over index
+ */
+uint32_t fastybirdIndexKey(
+    const uint32_t hash,
+    const uint8_t owner
+) {
+    return hash ^ ((uint32_t) (owner + 1) * 2654435761UL);
+}
+
+// -----------------------------------------------------------------------------
+
+void fastybirdIndexInsert(
+    fastybird_index_t & index,
+    const uint32_t key,
+    const uint16_t entry
+) {
+    uint16_t mask = index.size() - 1;
+    uint16_t slot = key & mask;
+
+    // Linear probing to the first empty slot
+    while (index[slot] != FASTYBIRD_INDEX_EMPTY) {
+        slot = (slot + 1) & mask;
+    }
+
+    index[slot] = entry;
+}
+
+// -----------------------------------------------------------------------------
+
 bool fastybirdReportConfiguration()
 {
     DynamicJsonBuffer jsonBuffer;
@@ -881,12 +1015,32 @@ void fastybirdCallOnChannelConfigure(
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Find channel by name, name could be part of longer string eg. received topic
+ */
 uint8_t fastybirdFindChannelIndex(
-    String name
+    const char * name,
+    const size_t length
 ) {
-    for (uint8_t i = 0; i < FASTYBIRD_MAX_CHANNELS; i++) {
-        if (_fastybird_channels[i].name.equals(name)) {
-            return i;
+    // Channels are not registered yet
+    if (_fastybird_channels_index.size() == 0) {
+        return INDEX_NONE;
+    }
+
+    uint32_t hash = fastybirdNameHash(name, length);
+    uint16_t mask = _fastybird_channels_index.size() - 1;
+
+    for (uint16_t slot = (hash & mask); _fastybird_channels_index[slot] != FASTYBIRD_INDEX_EMPTY; slot = (slot + 1) & mask) {
+        uint8_t channel_index = _fastybird_channels_index[slot];
+
+        const String & channel_name = _fastybird_channels[channel_index].name;
+
+        if (
+            _fastybird_channels[channel_index].hash == hash
+            && channel_name.length() == length
+            && strncasecmp(channel_name.c_str(), name, length) == 0
+        ) {
+            return channel_index;
         }
     }
 
@@ -895,7 +1049,26 @@ uint8_t fastybirdFindChannelIndex(
 
 // -----------------------------------------------------------------------------
 
-fastybird_channel_t fastybirdGetChannel(
+uint8_t fastybirdFindChannelIndex(
+    const char * name
+) {
+    return fastybirdFindChannelIndex(name, strlen(name));
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t fastybirdFindChannelIndex(
+    const String & name
+) {
+    return fastybirdFindChannelIndex(name.c_str());
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Registered channel, reference is valid until next channel is registered
+ */
+const fastybird_channel_t & fastybirdGetChannel(
     const uint8_t channelIndex
 ) {
     return _fastybird_channels[channelIndex];
@@ -920,6 +1093,8 @@ uint8_t fastybirdRegisterProperty(
         String(format)
     };
 
+    property.hash = fastybirdNameHash(name);
+
     _fastybird_properties.push_back(property);
 
     return (_fastybird_properties.size() - 1);
@@ -997,19 +1172,42 @@ uint8_t fastybirdRegisterProperty(
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Find channel property by name, name could be part of longer string eg. received topic
+ */
 uint8_t fastybirdFindChannelPropertyIndex(
     const uint8_t channelIndex,
-    String name
+    const char * name,
+    const size_t length
 ) {
-    if (channelIndex >= FASTYBIRD_MAX_CHANNELS) {
+    if (channelIndex >= _fastybird_channels.size()) {
+        return INDEX_NONE;
+    }
+
+    // Properties are not mapped yet
+    if (_fastybird_channels_properties_index.size() == 0) {
         return INDEX_NONE;
     }
 
-    fastybird_channel_t channel = _fastybird_channels[channelIndex];
+    uint32_t hash = fastybirdNameHash(name, length);
+    uint16_t mask = _fastybird_channels_properties_index.size() - 1;
+
+    for (uint16_t slot = (fastybirdIndexKey(hash, channelIndex) & mask); _fastybird_channels_properties_index[slot] != FASTYBIRD_INDEX_EMPTY; slot = (slot + 1) & mask) {
+        uint16_t entry = _fastybird_channels_properties_index[slot];
+
+        // Slot of other channel property
+        if ((entry >> 8) != channelIndex) {
+            continue;
+        }
+
+        const fastybird_property_t & property = _fastybird_properties[entry & 0xFF];
 
-    for (uint8_t i = 0; i < channel.properties.size(); i++) {
-        if (_fastybird_properties[channel.properties[i]].name.equals(name)) {
-            return channel.properties[i];
+        if (
+            property.hash == hash
+            && property.name.length() == length
+            && strncasecmp(property.name.c_str(), name, length) == 0
+        ) {
+            return (entry & 0xFF);
         }
     }
 
@@ -1018,6 +1216,24 @@ uint8_t fastybirdFindChannelPropertyIndex(
 
 // -----------------------------------------------------------------------------
 
+uint8_t fastybirdFindChannelPropertyIndex(
+    const uint8_t channelIndex,
+    const char * name
+) {
+    return fastybirdFindChannelPropertyIndex(channelIndex, name, strlen(name));
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t fastybirdFindChannelPropertyIndex(
+    const uint8_t channelIndex,
+    const String & name
+) {
+    return fastybirdFindChannelPropertyIndex(channelIndex, name.c_str());
+}
+
+// -----------------------------------------------------------------------------
+
 bool fastybirdMapPropertyToChannel(
     const uint8_t channelIndex,
     const uint8_t propertyIndex
@@ -1044,12 +1260,17 @@ bool fastybirdMapPropertyToChannel(
 
     _fastybird_channels[channelIndex].properties.push_back(propertyIndex);
 
+    _fastybirdRebuildChannelsPropertiesIndex();
+
     return true;
 }
 
 // -----------------------------------------------------------------------------
 
-fastybird_property_t fastybirdGetProperty(
+/**
+ * Registered property, reference is valid until next property is registered
+ */
+const fastybird_property_t & fastybirdGetProperty(
     const uint8_t propertyIndex
 ) {
     return _fastybird_properties[propertyIndex];
@@ -1070,8 +1291,8 @@ bool fastybirdReportChannelPropertyValue(
         return false;
     }
 
-    fastybird_channel_t channel = _fastybird_channels[channelIndex];
-    fastybird_property_t property = _fastybird_properties[propertyIndex];
+    const fastybird_channel_t & channel = _fastybird_channels[channelIndex];
+    const fastybird_property_t & property = _fastybird_properties[propertyIndex];
 
     return fastybirdApiPropagateChannelPropertyValue(
         channel.name.c_str(),
@@ -25,10 +25,76 @@ std::vector<fastybird_node_t> _fastybird_nodes;
 std::vector<fastybird_node_channel_t> _fastybird_nodes_channels;
 std::vector<fastybird_node_property_t> _fastybird_nodes_properties;
 
+// Name lookup indexes, nodes by serial number, channels by node and name & properties by channel and name
+fastybird_index_t _fastybird_nodes_index;
+fastybird_index_t _fastybird_nodes_channels_index;
+fastybird_index_t _fastybird_nodes_channels_properties_index;
+
 // -----------------------------------------------------------------------------
 // MODULE PRIVATE 
 // -----------------------------------------------------------------------------
 
+void _fastybirdNodesRebuildNodesIndex()
+{
+    fastybirdIndexReset(_fastybird_nodes_index, _fastybird_nodes.size());
+
+    for (uint8_t i = 0; i < _fastybird_nodes.size(); i++) {
+        fastybirdIndexInsert(_fastybird_nodes_index, _fastybird_nodes[i].hash, i);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void _fastybirdNodesRebuildChannelsIndex()
+{
+    uint16_t count = 0;
+
+    for (uint8_t i = 0; i < _fastybird_nodes.size(); i++) {
+        count += _fastybird_nodes[i].channels.size();
+    }
+
+    fastybirdIndexReset(_fastybird_nodes_channels_index, count);
+
+    for (uint8_t i = 0; i < _fastybird_nodes.size(); i++) {
+        for (uint8_t j = 0; j < _fastybird_nodes[i].channels.size(); j++) {
+            uint8_t channel_index = _fastybird_nodes[i].channels[j];
+
+            fastybirdIndexInsert(
+                _fastybird_nodes_channels_index,
+                fastybirdIndexKey(_fastybird_nodes_channels[channel_index].hash, i),
+                ((uint16_t) i << 8) | channel_index
+            );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void _fastybirdNodesRebuildChannelsPropertiesIndex()
+{
+    uint16_t count = 0;
+
+    for (uint8_t i = 0; i < _fastybird_nodes_channels.size(); i++) {
+        count += _fastybird_nodes_channels[i].properties.size();
+    }
+
+    fastybirdIndexReset(_fastybird_nodes_channels_properties_index, count);
+
+    for (uint8_t i = 0; i < _fastybird_nodes_channels.size(); i++) {
+        for (uint8_t j = 0; j < _fastybird_nodes_channels[i].properties.size(); j++) {
+            uint8_t property_index = _fastybird_nodes_channels[i].properties[j];
+
+            fastybirdIndexInsert(
+                _fastybird_nodes_channels_properties_index,
+                fastybirdIndexKey(_fastybird_nodes_properties[property_index].hash, i),
+                ((uint16_t) i << 8) | property_index
+            );
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void _fastybirdNodesSendHeartbeat()
 {
     for (uint8_t i = 0; i < _fastybird_nodes.size(); i++) {
@@ -63,9 +129,9 @@ bool _fastybirdNodesInitializeChannelProperty(
         return true;
     }
 
-    fastybird_node_t node = _fastybird_nodes[nodeIndex];
-    fastybird_node_channel_t channel = _fastybird_nodes_channels[channelIndex];
-    fastybird_node_property_t property = _fastybird_nodes_properties[propertyIndex];
+    const fastybird_node_t & node = _fastybird_nodes[nodeIndex];
+    const fastybird_node_channel_t & channel = _fastybird_nodes_channels[channelIndex];
+    const fastybird_node_property_t & property = _fastybird_nodes_properties[propertyIndex];
 
     switch (_fastybird_node_channel_property_advertisement_progress)
     {
@@ -148,8 +214,8 @@ bool _fastybirdNodesInitializeChannel(
     std::vector<String> properties;
     std::vector<String> controls;
 
-    fastybird_node_t node = _fastybird_nodes[nodeIndex];
-    fastybird_node_channel_t channel = _fastybird_nodes_channels[channelIndex];
+    const fastybird_node_t & node = _fastybird_nodes[nodeIndex];
+    const fastybird_node_channel_t & channel = _fastybird_nodes_channels[channelIndex];
 
     switch (_fastybird_node_channel_advertisement_progress)
     {
@@ -272,7 +338,7 @@ void _fastybirdNodesInitialize(
         return;
     }
 
-    fastybird_node_t node = _fastybird_nodes[nodeIndex];
+    const fastybird_node_t & node = _fastybird_nodes[nodeIndex];
 
     std::vector<String> channels;
     std::vector<String> properties;
@@ -289,6 +355,7 @@ void _fastybirdNodesInitialize(
             // Collect all node default properties...
             properties.push_back(FASTYBIRD_PROPERTY_UPTIME);
             properties.push_back(FASTYBIRD_PROPERTY_INTERVAL);
+            properties.push_back(FASTYBIRD_PROPERTY_POLL_INTERVAL);
 
             // ...and pass them to the broker
             if (!fastybirdApiPropagateDevicePropertiesNames(node.id, properties)) {
@@ -480,11 +547,11 @@ uint8_t fastybirdNodesRegisterNode(
     const char * firmwareManufacturer,
     bool ready
 ) {
-    for (uint8_t i = 0; i < _fastybird_nodes.size(); i++) {
-        // Check if node with same serial no is allready registered
-        if (strcmp(_fastybird_nodes[i].id, serialNumber)) {
-            return i;
-        }
+    // Check if node with same serial no is allready registered
+    uint8_t registered_index = fastybirdNodesFindNodeIndex(serialNumber);
+
+    if (registered_index != INDEX_NONE) {
+        return registered_index;
     }
 
     fastybird_node_hardware_t hardware = {
@@ -518,8 +585,12 @@ uint8_t fastybirdNodesRegisterNode(
 
     strcpy(node.id, serialNumber);
 
+    node.hash = fastybirdNameHash(node.id);
+
     _fastybird_nodes.push_back(node);
 
+    _fastybirdNodesRebuildNodesIndex();
+
     DEBUG_MSG(PSTR("[INFO][FASTYBIRD][NODE] Inserting node: %s\n"), node.id);
 
     return (_fastybird_nodes.size() - 1);
@@ -535,7 +606,10 @@ void fastybirdNodesUnregisterNode(
 
 // -----------------------------------------------------------------------------
 
-fastybird_node_t fastybirdNodesGetNode(
+/**
+ * Registered node, reference is valid until next node is registered
+ */
+const fastybird_node_t & fastybirdNodesGetNode(
     const uint8_t nodeIndex
 ) {
     return _fastybird_nodes[nodeIndex];
@@ -552,7 +626,7 @@ void fastybirdNodesNodeIsLost(
 
     _fastybird_nodes[nodeIndex].ready = false;
 
-    fastybird_node_t node = _fastybird_nodes[nodeIndex];
+    const fastybird_node_t & node = _fastybird_nodes[nodeIndex];
 
     fastybirdApiPropagateDeviceState(node.id, FASTYBIRD_STATUS_LOST);
 }
@@ -568,26 +642,39 @@ void fastybirdNodesNodeIsReady(
 
     _fastybird_nodes[nodeIndex].ready = true;
 
-    fastybird_node_t node = _fastybird_nodes[nodeIndex];
+    const fastybird_node_t & node = _fastybird_nodes[nodeIndex];
 
     fastybirdApiPropagateDeviceState(node.id, FASTYBIRD_STATUS_READY);
 }
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Find node by serial number, serial number could be part of longer string eg. received topic
+ */
 uint8_t fastybirdNodesFindNodeIndex(
-    String serialNumber
+    const char * serialNumber,
+    const size_t length
 ) {
-    String serial_no_tmp;
+    // Nodes are not registered yet
+    if (_fastybird_nodes_index.size() == 0) {
+        return INDEX_NONE;
+    }
 
-    serialNumber.toLowerCase();
+    uint32_t hash = fastybirdNameHash(serialNumber, length);
+    uint16_t mask = _fastybird_nodes_index.size() - 1;
 
-    for (uint8_t i = 0; i < _fastybird_nodes.size(); i++) {
-        serial_no_tmp = _fastybird_nodes[i].id;
-        serial_no_tmp.toLowerCase();
+    for (uint16_t slot = (hash & mask); _fastybird_nodes_index[slot] != FASTYBIRD_INDEX_EMPTY; slot = (slot + 1) & mask) {
+        uint8_t node_index = _fastybird_nodes_index[slot];
 
-        if (serialNumber.equals(serial_no_tmp)) {
-            return i;
+        const char * id = _fastybird_nodes[node_index].id;
+
+        if (
+            _fastybird_nodes[node_index].hash == hash
+            && strncasecmp(id, serialNumber, length) == 0
+            && id[length] == '\0'
+        ) {
+            return node_index;
         }
     }
 
@@ -596,6 +683,22 @@ uint8_t fastybirdNodesFindNodeIndex(
 
 // -----------------------------------------------------------------------------
 
+uint8_t fastybirdNodesFindNodeIndex(
+    const char * serialNumber
+) {
+    return fastybirdNodesFindNodeIndex(serialNumber, strlen(serialNumber));
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t fastybirdNodesFindNodeIndex(
+    const String & serialNumber
+) {
+    return fastybirdNodesFindNodeIndex(serialNumber.c_str());
+}
+
+// -----------------------------------------------------------------------------
+
 uint8_t fastybirdNodesRegisterNodeChannel(
     const char * name
 ) {
@@ -603,6 +706,8 @@ uint8_t fastybirdNodesRegisterNodeChannel(
         String(name)
     };
 
+    channel.hash = fastybirdNameHash(name);
+
     _fastybird_nodes_channels.push_back(channel);
 
     return (_fastybird_nodes_channels.size() - 1);
@@ -636,24 +741,49 @@ bool fastybirdNodesMapChannelToNode(
 
     _fastybird_nodes[nodeIndex].channels.push_back(channelIndex);
 
+    _fastybirdNodesRebuildChannelsIndex();
+
     return true;
 }
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Find node channel by name, name could be part of longer string eg. received topic
+ */
 uint8_t fastybirdNodesFindChannelIndex(
     const uint8_t nodeIndex,
-    String name
+    const char * name,
+    const size_t length
 ) {
     if (nodeIndex >= _fastybird_nodes.size()) {
         return INDEX_NONE;
     }
 
-    fastybird_node_t node = _fastybird_nodes[nodeIndex];
+    // Channels are not mapped yet
+    if (_fastybird_nodes_channels_index.size() == 0) {
+        return INDEX_NONE;
+    }
+
+    uint32_t hash = fastybirdNameHash(name, length);
+    uint16_t mask = _fastybird_nodes_channels_index.size() - 1;
+
+    for (uint16_t slot = (fastybirdIndexKey(hash, nodeIndex) & mask); _fastybird_nodes_channels_index[slot] != FASTYBIRD_INDEX_EMPTY; slot = (slot + 1) & mask) {
+        uint16_t entry = _fastybird_nodes_channels_index[slot];
+
+        // Slot of other node channel
+        if ((entry >> 8) != nodeIndex) {
+            continue;
+        }
+
+        const fastybird_node_channel_t & channel = _fastybird_nodes_channels[entry & 0xFF];
 
-    for (uint8_t i = 0; i < node.channels.size(); i++) {
-        if (_fastybird_nodes_channels[node.channels[i]].name.equals(name)) {
-            return node.channels[i];
+        if (
+            channel.hash == hash
+            && channel.name.length() == length
+            && strncasecmp(channel.name.c_str(), name, length) == 0
+        ) {
+            return (entry & 0xFF);
         }
     }
 
@@ -662,7 +792,28 @@ uint8_t fastybirdNodesFindChannelIndex(
 
 // -----------------------------------------------------------------------------
 
-fastybird_node_channel_t fastybirdNodesGetChannel(
+uint8_t fastybirdNodesFindChannelIndex(
+    const uint8_t nodeIndex,
+    const char * name
+) {
+    return fastybirdNodesFindChannelIndex(nodeIndex, name, strlen(name));
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t fastybirdNodesFindChannelIndex(
+    const uint8_t nodeIndex,
+    const String & name
+) {
+    return fastybirdNodesFindChannelIndex(nodeIndex, name.c_str());
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Registered node channel, reference is valid until next channel is registered
+ */
+const fastybird_node_channel_t & fastybirdNodesGetChannel(
     const uint8_t channelIndex
 ) {
     return _fastybird_nodes_channels[channelIndex];
@@ -685,6 +836,8 @@ uint8_t fastybirdNodesRegisterNodeProperty(
         String(format)
     };
 
+    property.hash = fastybirdNameHash(name);
+
     _fastybird_nodes_properties.push_back(property);
 
     return (_fastybird_nodes_properties.size() - 1);
@@ -762,19 +915,42 @@ uint8_t fastybirdNodesRegisterNodeProperty(
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Find node channel property by name, name could be part of longer string eg. received topic
+ */
 uint8_t fastybirdNodesFindChannelPropertyIndex(
     const uint8_t channelIndex,
-    String name
+    const char * name,
+    const size_t length
 ) {
     if (channelIndex >= _fastybird_nodes_channels.size()) {
         return INDEX_NONE;
     }
 
-    fastybird_node_channel_t channel = _fastybird_nodes_channels[channelIndex];
+    // Properties are not mapped yet
+    if (_fastybird_nodes_channels_properties_index.size() == 0) {
+        return INDEX_NONE;
+    }
+
+    uint32_t hash = fastybirdNameHash(name, length);
+    uint16_t mask = _fastybird_nodes_channels_properties_index.size() - 1;
+
+    for (uint16_t slot = (fastybirdIndexKey(hash, channelIndex) & mask); _fastybird_nodes_channels_properties_index[slot] != FASTYBIRD_INDEX_EMPTY; slot = (slot + 1) & mask) {
+        uint16_t entry = _fastybird_nodes_channels_properties_index[slot];
 
-    for (uint8_t i = 0; i < channel.properties.size(); i++) {
-        if (_fastybird_nodes_properties[channel.properties[i]].name.equals(name)) {
-            return channel.properties[i];
+        // Slot of other channel property
+        if ((entry >> 8) != channelIndex) {
+            continue;
+        }
+
+        const fastybird_node_property_t & property = _fastybird_nodes_properties[entry & 0xFF];
+
+        if (
+            property.hash == hash
+            && property.name.length() == length
+            && strncasecmp(property.name.c_str(), name, length) == 0
+        ) {
+            return (entry & 0xFF);
         }
     }
 
@@ -783,7 +959,28 @@ uint8_t fastybirdNodesFindChannelPropertyIndex(
 
 // -----------------------------------------------------------------------------
 
-fastybird_node_property_t fastybirdNodesGetProperty(
+uint8_t fastybirdNodesFindChannelPropertyIndex(
+    const uint8_t channelIndex,
+    const char * name
+) {
+    return fastybirdNodesFindChannelPropertyIndex(channelIndex, name, strlen(name));
+}
+
+// -----------------------------------------------------------------------------
+
+uint8_t fastybirdNodesFindChannelPropertyIndex(
+    const uint8_t channelIndex,
+    const String & name
+) {
+    return fastybirdNodesFindChannelPropertyIndex(channelIndex, name.c_str());
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Registered node property, reference is valid until next property is registered
+ */
+const fastybird_node_property_t & fastybirdNodesGetProperty(
     const uint8_t propertyIndex
 ) {
     return _fastybird_nodes_properties[propertyIndex];
@@ -817,6 +1014,8 @@ bool fastybirdNodesMapPropertyToChannel(
 
     _fastybird_nodes_channels[channelIndex].properties.push_back(propertyIndex);
 
+    _fastybirdNodesRebuildChannelsPropertiesIndex();
+
     return true;
 }
 
@@ -832,7 +1031,7 @@ bool fastybirdNodesReportChannelPropertyValue(
         return false;
     }
 
-    fastybird_node_t node = _fastybird_nodes[nodeIndex];
+    const fastybird_node_t & node = _fastybird_nodes[nodeIndex];
 
     // Node have to be initialized
     if (node.initialized) {
@@ -842,7 +1041,7 @@ bool fastybirdNodesReportChannelPropertyValue(
             return false;
         }
 
-        fastybird_node_channel_t channel = _fastybird_nodes_channels[channelIndex];
+        const fastybird_node_channel_t & channel = _fastybird_nodes_channels[channelIndex];
 
         if (propertyIndex >= _fastybird_nodes_properties.size()) {
             DEBUG_MSG(PSTR("[FB NODES] Property index is not valid\n"));
@@ -850,7 +1049,7 @@ bool fastybirdNodesReportChannelPropertyValue(
             return false;
         }
 
-        fastybird_node_property_t property = _fastybird_nodes_properties[propertyIndex];
+        const fastybird_node_property_t & property = _fastybird_nodes_properties[propertyIndex];
 
         return fastybirdApiPropagateChannelPropertyValue(
             node.id,
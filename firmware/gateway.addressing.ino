@@ -14,15 +14,44 @@ Communication sequence:
  6. Node confirm assigned address with packet GATEWAY_PACKET_NODE_ADDRESS_CONFIRM
  7. Gateway mark node as added and store it to the memory
 
+Searching is not blocking. After broadcast is sent, gateway opens collecting
+window and replies are processed by standard receive handler while rest of
+the firmware is running.
+
+Collisions avoidance:
+---------------------
+Broadcast GATEWAY_PACKET_SEARCH_NODES carries count of reply slots and slot
+length. Unaddressed node pick one slot (random or derived from its SN) and send
+its reply only in this slot, so many nodes powered up together are not replying
+at the same moment. Reserved addresses are broadcasted after collecting window
+is closed, when the bus is quiet again.
+
+After each round gateway adjust slots count. When many slots were used, some
+replies probably collided and slots count is doubled. When nobody replied,
+slots count is halved. Searching is extended while new nodes are found.
+
+Nodes slots:
+------------
+Node is placed into first free slot and gets lowest free bus address, so slot
+index and bus address are not bound together. Bus address is translated to
+slot index through direct lookup map.
+
 */
 
 #if FB_GATEWAY_SUPPORT
 
-gateway_node_addressing_t _gateway_nodes_addressing[FB_GATEWAY_MAX_NODES];
-
 bool _gateway_addressing_search_for_nodes = false;
 uint32_t _gateway_addressing_last_node_search = 0;
 
+uint8_t _gateway_addressing_search_state = GATEWAY_SEARCH_STATE_IDLE;
+uint32_t _gateway_addressing_search_window = 0;
+
+uint8_t _gateway_addressing_search_slots = FB_GATEWAY_SEARCH_SLOTS_MIN;
+uint8_t _gateway_addressing_search_found = 0;
+
+// Bus address to node slot index map
+uint8_t _gateway_addressing_nodes_map[FB_GATEWAY_MAX_ADDRESS + 1];
+
 // -----------------------------------------------------------------------------
 // MODULE: SUB-MODULE PRIVATE
 // -----------------------------------------------------------------------------
@@ -33,13 +62,18 @@ bool _gatewayAddressingIsNodeSerialNumberUnique(
     char stored_sn[15] = GATEWAY_DESCRIPTION_NOT_SET;
 
     for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+        // Not used slot
+        if (!gatewayIsNodeAllocated(i)) {
+            continue;
+        }
+
         gatewayGetSerialNumber(i, stored_sn);
 
         if (
             // If in registry is node with same serial number...
             strcmp(stored_sn, serialNumber) == 0
             // ...and addressing is still in process
-            && _gateway_nodes_addressing[i].state == true
+            && _gateway_nodes_details[i]->addressing.state == true
         ) {
             DEBUG_MSG(PSTR("[WARN][GATEWAY][ADDRESSING] Node serial number: %s is not unique\n"), serialNumber);
 
@@ -54,6 +88,35 @@ bool _gatewayAddressingIsNodeSerialNumberUnique(
 
 // -----------------------------------------------------------------------------
 
+void _gatewayAddressingBind(
+    const uint8_t nodeIndex,
+    const uint8_t address
+) {
+    if (address == PJON_NOT_ASSIGNED || address > FB_GATEWAY_MAX_ADDRESS) {
+        return;
+    }
+
+    _gateway_addressing_nodes_map[address] = nodeIndex;
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewayAddressingUnbind(
+    const uint8_t nodeIndex
+) {
+    uint8_t address = _gateway_nodes[nodeIndex].addressing.address;
+
+    if (address == PJON_NOT_ASSIGNED || address > FB_GATEWAY_MAX_ADDRESS) {
+        return;
+    }
+
+    if (_gateway_addressing_nodes_map[address] == nodeIndex) {
+        _gateway_addressing_nodes_map[address] = INDEX_NONE;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 uint16_t _gatewayAddressingReserveNodeAddress(
     const char * serialNumber
 ) {
@@ -64,64 +127,136 @@ uint16_t _gatewayAddressingReserveNodeAddress(
     char stored_sn[15] = GATEWAY_DESCRIPTION_NOT_SET;
 
     for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+        // Not used slot
+        if (!gatewayIsNodeAllocated(i)) {
+            continue;
+        }
+
         gatewayGetSerialNumber(i, stored_sn);
 
-        // Search for free node slot
-        if (strcmp(stored_sn, serialNumber) == 0) {
-            return i + 1;
+        // Node replied again before its reservation was confirmed
+        if (strcmp(stored_sn, serialNumber) == 0 && _gateway_nodes[i].addressing.address != PJON_NOT_ASSIGNED) {
+            return _gateway_nodes[i].addressing.address;
         }
 
         strcpy(stored_sn, GATEWAY_DESCRIPTION_NOT_SET);
     }
 
-    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
-        gatewayGetSerialNumber(i, stored_sn);
+    // Search for lowest free bus address
+    uint8_t address = PJON_NOT_ASSIGNED;
 
-        // Search for free node slot
-        if (strcmp(stored_sn, GATEWAY_DESCRIPTION_NOT_SET) == 0) {
-            gatewaySetSerialNumber(i, serialNumber);
+    for (uint8_t i = 1; i <= FB_GATEWAY_MAX_ADDRESS; i++) {
+        if (_gateway_addressing_nodes_map[i] == INDEX_NONE) {
+            address = i;
 
-            return i + 1;
+            break;
         }
+    }
 
-        strcpy(stored_sn, GATEWAY_DESCRIPTION_NOT_SET);
+    uint8_t node_index = INDEX_NONE;
+
+    if (address != PJON_NOT_ASSIGNED) {
+        node_index = gatewayAllocateNode();
     }
 
-    DEBUG_MSG(PSTR("[WARN][GATEWAY][ADDRESSING] Nodes registry is full. No other nodes could be added.\n"));
+    if (node_index == INDEX_NONE) {
+        DEBUG_MSG(PSTR("[WARN][GATEWAY][ADDRESSING] Nodes registry is full. No other nodes could be added.\n"));
+
+        return FB_GATEWAY_NODES_BUFFER_FULL;
+    }
 
-    return FB_GATEWAY_NODES_BUFFER_FULL;
+    gatewaySetSerialNumber(node_index, serialNumber);
+
+    _gateway_nodes[node_index].addressing.address = address;
+
+    _gatewayAddressingBind(node_index, address);
+
+    return address;
 }
 
 // -----------------------------------------------------------------------------
 
 /**
  * Gateway searching for new nodes which are not addressed yet
+ *
+ * PAYLOAD:
+ * 0    => Packet identifier    => GATEWAY_PACKET_SEARCH_NODES
+ * 1    => Reply slots count    => 1-255
+ * 2    => Reply slot length    => 0-255 ms
  */
 void _gatewayAddressingSearchForNodes()
 {
-    char output_content[1];
+    char output_content[3];
 
     output_content[0] = GATEWAY_PACKET_SEARCH_NODES;
+    output_content[1] = (uint8_t) _gateway_addressing_search_slots;
+    output_content[2] = (uint8_t) FB_GATEWAY_SEARCH_SLOT_LENGTH;
 
-    gatewayBroadcastPacket(
-        output_content,
-        1,
-        FB_GATEWAY_SEARCH_NODES_BROADCAST_TIME
-    );
+    if (gatewayBroadcastPacket(output_content, 3, _gatewayAddressingSearchSentCallback)) {
+        _gateway_addressing_search_found = 0;
+        _gateway_addressing_search_window = millis();
+        _gateway_addressing_search_state = GATEWAY_SEARCH_STATE_COLLECTING;
+    }
 }
 
 // -----------------------------------------------------------------------------
 
-void _gatewayAddressingContinueInProcess(
-    const uint8_t nodeIndex
+/**
+ * Search broadcast left bus queue, replies window starts now
+ */
+void _gatewayAddressingSearchSentCallback(
+    const uint8_t nodeIndex,
+    const uint8_t packetId,
+    const uint8_t result
 ) {
-    // Validate computed node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    if (_gateway_addressing_search_state != GATEWAY_SEARCH_STATE_COLLECTING) {
         return;
     }
 
-    // Convert node index to address
-    uint8_t address = (nodeIndex - 1);
+    if (result == GATEWAY_SEND_SUCCESS) {
+        _gateway_addressing_search_window = millis();
+
+    } else {
+        // Broadcast was not transmitted, nodes could not reply
+        _gateway_addressing_search_state = GATEWAY_SEARCH_STATE_BROADCAST;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Adjust reply slots count according to searching round result
+ */
+void _gatewayAddressingAdjustSearchSlots()
+{
+    if (_gateway_addressing_search_found == 0) {
+        // Nobody replied, shorten next window
+        if (_gateway_addressing_search_slots > FB_GATEWAY_SEARCH_SLOTS_MIN) {
+            _gateway_addressing_search_slots = _gateway_addressing_search_slots / 2;
+        }
+
+    } else if ((_gateway_addressing_search_found * 2) >= _gateway_addressing_search_slots) {
+        // Half of slots were occupied, replies were probably colliding
+        if (_gateway_addressing_search_slots <= (FB_GATEWAY_SEARCH_SLOTS_MAX / 2)) {
+            _gateway_addressing_search_slots = _gateway_addressing_search_slots * 2;
+        }
+    }
+
+    if (_gateway_addressing_search_found > 0) {
+        // There could be other nodes waiting, keep searching
+        _gateway_addressing_last_node_search = millis();
+    }
+
+    DEBUG_MSG(PSTR("[INFO][GATEWAY][ADDRESSING] Searching round found: %d nodes, next round slots: %d\n"), _gateway_addressing_search_found, _gateway_addressing_search_slots);
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewayAddressingContinueInProcess(
+    const uint8_t nodeIndex
+) {
+    // Address reserved for node during searching
+    uint8_t address = _gateway_nodes[nodeIndex].addressing.address;
 
     char output_content[gatewayCommunicationGetMaxPacketSize(nodeIndex)];
 
@@ -150,14 +285,14 @@ void _gatewayAddressingContinueInProcess(
     // Increment communication counter
     gatewayCommunicationIncrementAttempts(nodeIndex);
 
-    // ...add mark, that gateway is waiting for reply from node
-    gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NODE_ADDRESS_CONFIRM);
+    uint8_t packet_sequence;
+    bool packet_sequenced;
 
-    gatewayBroadcastPacket(
-        output_content,
-        (byte_pointer + 1),
-        FB_GATEWAY_SEARCH_NODES_BROADCAST_TIME
-    );
+    // Node has no address yet, request is broadcasted
+    if (gatewaySendPacket(PJON_BROADCAST, output_content, (byte_pointer + 1), NULL, packet_sequence, packet_sequenced)) {
+        // ...add mark, that gateway is waiting for reply from node
+        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NODE_ADDRESS_CONFIRM, packet_sequence, packet_sequenced);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -165,14 +300,9 @@ void _gatewayAddressingContinueInProcess(
 bool _gatewayAddressingIsUnfinished(
     const uint8_t nodeIndex
 ) {
-    // Validate computed node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return false;
-    }
-
     if (
         // Check if node is in searching mode
-        _gateway_nodes_addressing[nodeIndex].registration > 0
+        _gateway_nodes_details[nodeIndex]->addressing.registration > 0
     ) {
         return true;
     }
@@ -182,18 +312,34 @@ bool _gatewayAddressingIsUnfinished(
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Check if some node is still waiting for address confirmation
+ */
+bool _gatewayAddressingIsAssigning()
+{
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+        if (_gatewayAddressingIsUnfinished(i)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
 void _gatewayAddressingCheckPacketsDelays()
 {
     for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
         // Searching
         if (
-            _gateway_nodes_addressing[i].state == false
-            && _gateway_nodes_addressing[i].registration > 0
-            && (millis() - _gateway_nodes_addressing[i].registration) > FB_GATEWAY_SEARCHING_WAITING_TIMEOUT
+            _gateway_nodes_details[i]->addressing.state == false
+            && _gateway_nodes_details[i]->addressing.registration > 0
+            && (millis() - _gateway_nodes_details[i]->addressing.registration) > FB_GATEWAY_SEARCHING_WAITING_TIMEOUT
         ) {
             // Node does not respond in reserved time window
             // Node slot is free to use by other node
-            gatewayAddressingReset(i);
+            gatewayReleaseNode(i);
         }
     }
 }
@@ -247,7 +393,7 @@ void _gatewayAddressingSearchNodesHandler(
     }
 
     // Transform address to node memory index
-    uint8_t node_index = (address - 1);
+    uint8_t node_index = gatewayAddressingGetNodeIndex(address);
 
     // Validate computed node index
     if (node_index >= FB_GATEWAY_MAX_NODES) {
@@ -257,15 +403,16 @@ void _gatewayAddressingSearchNodesHandler(
     DEBUG_MSG(PSTR("[INFO][GATEWAY][ADDRESSING] New node: %s was successfully added to registry with address: %d\n"), (char *) node_sn, (uint8_t) address);
 
     // Addressing process info
-    _gateway_nodes_addressing[node_index].address = address;
-    _gateway_nodes_addressing[node_index].registration = millis();
+    _gateway_nodes_details[node_index]->addressing.registration = millis();
 
     // Communication info
     gatewayCommunicationSetMaxPacketSize(node_index, max_packet_length);
     gatewayCommunicationResetAttempts(node_index);
 
-    // Send address info to node
-    _gatewayAddressingContinueInProcess(node_index);
+    _gateway_addressing_search_found++;
+
+    // Address info is sent by node job, after collecting window is closed
+    gatewaySchedulerWake(node_index);
 }
 
 // -----------------------------------------------------------------------------
@@ -286,7 +433,7 @@ void _gatewayAddressingConfirmNodeHandler(
     uint8_t address = (uint8_t) payload[1];
 
     // Transform node address to node index
-    uint8_t node_index = (address - 1);
+    uint8_t node_index = gatewayAddressingGetNodeIndex(address);
 
     // Validate computed node index
     if (node_index >= FB_GATEWAY_MAX_NODES) {
@@ -329,7 +476,7 @@ void _gatewayAddressingConfirmNodeHandler(
         gatewayAddressingSet(node_index, address);
 
         // Gateway is not waiting any message from node
-        gatewayCommunicationSetWaitingPacket(node_index, GATEWAY_PACKET_NONE);
+        gatewayCommunicationResetWaitingPacket(node_index);
 
         // Store new node info into storage memory
         gatewayStorageAddNode(node_index);
@@ -337,6 +484,9 @@ void _gatewayAddressingConfirmNodeHandler(
         // Reset communication counter
         gatewayCommunicationResetAttempts(node_index);
 
+        // Node could continue with initialization
+        gatewaySchedulerWake(node_index);
+
         DEBUG_MSG(PSTR("[INFO][GATEWAY][ADDRESSING] Addressing for new node: %s was successfully finished. Assigned address is: %d\n"), (char *) node_sn, address);
 
     } else {
@@ -362,15 +512,19 @@ void gatewayAddressingSet(
     const uint8_t nodeIndex,
     const uint8_t address
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be addressed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
+    _gatewayAddressingUnbind(nodeIndex);
+
     // Update addressing process info
-    _gateway_nodes_addressing[nodeIndex].state = true;
-    _gateway_nodes_addressing[nodeIndex].address = address;
-    _gateway_nodes_addressing[nodeIndex].registration = 0;
+    _gateway_nodes_details[nodeIndex]->addressing.state = true;
+    _gateway_nodes[nodeIndex].addressing.address = address;
+    _gateway_nodes_details[nodeIndex]->addressing.registration = 0;
+
+    _gatewayAddressingBind(nodeIndex, address);
 }
 
 // -----------------------------------------------------------------------------
@@ -392,9 +546,17 @@ void gatewayAddressingReset(
         return;
     }
 
-    _gateway_nodes_addressing[nodeIndex].state = false;
-    _gateway_nodes_addressing[nodeIndex].address = PJON_NOT_ASSIGNED;
-    _gateway_nodes_addressing[nodeIndex].registration = 0;
+    _gatewayAddressingUnbind(nodeIndex);
+
+    _gateway_nodes[nodeIndex].addressing.address = PJON_NOT_ASSIGNED;
+
+    // Not used slot has no addressing process
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
+        return;
+    }
+
+    _gateway_nodes_details[nodeIndex]->addressing.state = false;
+    _gateway_nodes_details[nodeIndex]->addressing.registration = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -407,7 +569,7 @@ uint8_t gatewayAddressingGet(
         return INDEX_NONE;
     }
 
-    return _gateway_nodes_addressing[nodeIndex].address;
+    return _gateway_nodes[nodeIndex].addressing.address;
 }
 
 // -----------------------------------------------------------------------------
@@ -420,7 +582,7 @@ bool gatewayAddressingHasAssignedAddress(
         return false;
     }
 
-    return _gateway_nodes_addressing[nodeIndex].address != PJON_NOT_ASSIGNED;
+    return _gateway_nodes[nodeIndex].addressing.address != PJON_NOT_ASSIGNED;
 }
 
 // -----------------------------------------------------------------------------
@@ -428,13 +590,11 @@ bool gatewayAddressingHasAssignedAddress(
 uint8_t gatewayAddressingGetNodeIndex(
     const uint8_t address
 ) {
-    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
-        if (_gateway_nodes_addressing[i].address == address) {
-            return i;
-        }
+    if (address == PJON_NOT_ASSIGNED || address > FB_GATEWAY_MAX_ADDRESS) {
+        return INDEX_NONE;
     }
 
-    return INDEX_NONE;
+    return _gateway_addressing_nodes_map[address];
 }
 
 // -----------------------------------------------------------------------------
@@ -446,13 +606,26 @@ void gatewayAddressingStartSearching()
 {
     _gateway_addressing_search_for_nodes = true;
     _gateway_addressing_last_node_search = millis();
+
+    _gateway_addressing_search_state = GATEWAY_SEARCH_STATE_BROADCAST;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if gateway is collecting replies for search broadcast
+ */
+bool gatewayAddressingIsCollecting()
+{
+    return _gateway_addressing_search_state == GATEWAY_SEARCH_STATE_COLLECTING;
 }
 
 // -----------------------------------------------------------------------------
 
-bool gatewayAddressingRequestHandler(
+void gatewayAddressingHandler(
     const uint8_t packetId,
-    const uint8_t address,
+    const uint8_t nodeIndex,
+    const uint8_t senderAddress,
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
@@ -462,37 +635,40 @@ bool gatewayAddressingRequestHandler(
          * Unaddressed node responded to search request
          */
         case GATEWAY_PACKET_SEARCH_NODES_CONFIRM:
-            _gatewayAddressingSearchNodesHandler(address, payload, payloadLength);
+            _gatewayAddressingSearchNodesHandler(senderAddress, payload, payloadLength);
             break;
 
         /**
          * Node confirmed back reserved address
          */
         case GATEWAY_PACKET_NODE_ADDRESS_CONFIRM:
-            _gatewayAddressingConfirmNodeHandler(address, payload, payloadLength);
+            _gatewayAddressingConfirmNodeHandler(senderAddress, payload, payloadLength);
             break;
 
         /**
          * Node requested discarding its address
          */
         case GATEWAY_PACKET_ADDRESS_DISCARD:
-            _gatewayAddressingDisconnectNodeHandler(address, payload, payloadLength);
+            _gatewayAddressingDisconnectNodeHandler(senderAddress, payload, payloadLength);
             break;
-
-        default:
-            return false;
     }
-
-    return true;
 }
 
 // -----------------------------------------------------------------------------
 // MODULE: SUB-MODULE CORE
 // -----------------------------------------------------------------------------
 
-bool gatewayAddressingLoop(
-    const uint8_t nodeIndex
-) {
+void gatewayAddressingSetup()
+{
+    for (uint16_t i = 0; i <= FB_GATEWAY_MAX_ADDRESS; i++) {
+        _gateway_addressing_nodes_map[i] = INDEX_NONE;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void gatewayAddressingLoop()
+{
     _gatewayAddressingCheckPacketsDelays();
 
     if (
@@ -503,14 +679,47 @@ bool gatewayAddressingLoop(
         _gateway_addressing_last_node_search = 0;
     }
 
-    // Search for new unaddressed nodes
-    if (
-        _gateway_addressing_search_for_nodes == true
-        && (_gateway_addressing_last_node_search + FB_GATEWAY_SEARCHING_TIMEOUT) > millis()
-    ) {
-        _gatewayAddressingSearchForNodes();
+    switch (_gateway_addressing_search_state)
+    {
+        // Search for new unaddressed nodes
+        case GATEWAY_SEARCH_STATE_BROADCAST:
+            // Replies window would block requested jobs, searching has the lowest priority
+            if (!gatewaySchedulerHasRequests() && !gatewayReportingIsCollecting()) {
+                _gatewayAddressingSearchForNodes();
+            }
+            break;
+
+        // Nodes replies are collected by receive handler
+        case GATEWAY_SEARCH_STATE_COLLECTING:
+            if ((millis() - _gateway_addressing_search_window) >= ((uint32_t) _gateway_addressing_search_slots * FB_GATEWAY_SEARCH_SLOT_LENGTH + FB_GATEWAY_RESPONSE_TIMEOUT)) {
+                _gatewayAddressingAdjustSearchSlots();
+
+                _gateway_addressing_search_state = GATEWAY_SEARCH_STATE_ASSIGNING;
+            }
+            break;
+
+        // Reserved addresses are sent by nodes jobs, next round waits for their confirmations
+        case GATEWAY_SEARCH_STATE_ASSIGNING:
+            if (!_gatewayAddressingIsAssigning()) {
+                if (_gateway_addressing_search_for_nodes == true) {
+                    _gateway_addressing_search_state = GATEWAY_SEARCH_STATE_BROADCAST;
+
+                } else {
+                    _gateway_addressing_search_state = GATEWAY_SEARCH_STATE_IDLE;
+                }
+            }
+            break;
+
+        default:
+            break;
     }
+}
 
+// -----------------------------------------------------------------------------
+
+bool gatewayAddressingLoop(
+    const uint8_t nodeIndex
+) {
     // Check if all connected nodes have finished searching process
     if (_gatewayAddressingIsUnfinished(nodeIndex)) {
         _gatewayAddressingContinueInProcess(nodeIndex);
@@ -15,16 +15,11 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 bool _gatewayCheckingIsLost(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return false;
-    }
-
     if (
         // Check if node has finished addressing procedure
-        gatewayAddressingHasAssignedAddress(nodeIndex) == true
+        _gateway_nodes[nodeIndex].addressing.address != PJON_NOT_ASSIGNED
         // Check if node is lost
-        && gatewayIsNodeLost(nodeIndex) == true
+        && _gateway_nodes[nodeIndex].lost > 0
     ) {
         return true;
     }
@@ -37,31 +32,29 @@ bool _gatewayCheckingIsLost(
 void _gatewayCheckingPingNode(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     if (
         // Check if node has finished addressing procedure
-        gatewayAddressingHasAssignedAddress(nodeIndex)
+        _gateway_nodes[nodeIndex].addressing.address != PJON_NOT_ASSIGNED
     ) {
         char output_content[1];
 
         // Packet identifier at first postion
         output_content[0] = GATEWAY_PACKET_PING;
 
+        uint8_t packet_sequence;
+        bool packet_sequenced;
+
         // Send packet to node
-        bool result = gatewaySendPacket(gatewayAddressingGet(nodeIndex), output_content, 1);
+        bool result = gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 1, NULL, packet_sequence, packet_sequenced);
 
         // When successfully sent...
         if (result == true) {
             // ...add mark, that gateway is waiting for reply from node
-            gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_PONG);
+            gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_PONG, packet_sequence, packet_sequenced);
 
         } else {
             // ...sending packet failed, reset incomming handler
-            gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+            gatewayCommunicationResetWaitingPacket(nodeIndex);
         }
     }
 }
@@ -71,17 +64,12 @@ void _gatewayCheckingPingNode(
 bool _gatewayCheckingIsReady(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return false;
-    }
-
     if (
         // Check if node has finished addressing procedure
-        gatewayAddressingHasAssignedAddress(nodeIndex) == true
+        _gateway_nodes[nodeIndex].addressing.address != PJON_NOT_ASSIGNED
         // Check if node is not lost
-        && gatewayIsNodeLost(nodeIndex) == false
-        && gatewayIsNodeReady(nodeIndex) == false
+        && _gateway_nodes[nodeIndex].lost == 0
+        && _gateway_nodes[nodeIndex].ready == false
     ) {
         return true;
     }
@@ -94,31 +82,29 @@ bool _gatewayCheckingIsReady(
 void _gatewayCheckingHelloNode(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     if (
         // Check if node has finished addressing procedure
-        gatewayAddressingHasAssignedAddress(nodeIndex)
+        _gateway_nodes[nodeIndex].addressing.address != PJON_NOT_ASSIGNED
     ) {
         char output_content[1];
 
         // Packet identifier at first postion
         output_content[0] = GATEWAY_PACKET_HELLO;
 
+        uint8_t packet_sequence;
+        bool packet_sequenced;
+
         // Send packet to node
-        bool result = gatewaySendPacket(gatewayAddressingGet(nodeIndex), output_content, 1);
+        bool result = gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 1, NULL, packet_sequence, packet_sequenced);
 
         // When successfully sent...
         if (result == true) {
             // ...add mark, that gateway is waiting for reply from node
-            gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_HELLO);
+            gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_HELLO, packet_sequence, packet_sequenced);
 
         } else {
             // ...sending packet failed, reset incomming handler
-            gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+            gatewayCommunicationResetWaitingPacket(nodeIndex);
         }
 
         // Increment communication counter
@@ -139,16 +125,14 @@ void _gatewayCheckingPongHandler(
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
+    // PONG is also reply to sequencing probe of node which is not lost
+    if (_gateway_nodes[nodeIndex].lost > 0) {
+        // Node could be marked as alive
+        gatewayMarkNodeAsAlive(nodeIndex);
     }
 
-    // Node could be marked as alive
-    gatewayMarkNodeAsAlive(nodeIndex);
-
     // Node is ready to communicate
-    gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+    gatewayCommunicationResetWaitingPacket(nodeIndex);
 }
 
 // -----------------------------------------------------------------------------
@@ -166,11 +150,6 @@ void _gatewayCheckingHelloHandler(
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     uint8_t bytes_length = (uint8_t) payload[1];
 
     char node_sn[bytes_length];
@@ -204,16 +183,17 @@ void _gatewayCheckingHelloHandler(
     gatewayMarkNodeAsReady(nodeIndex);
 
     // Node is ready to communicate
-    gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+    gatewayCommunicationResetWaitingPacket(nodeIndex);
 }
 
 // -----------------------------------------------------------------------------
 // MODULE: SUB-MODULE API
 // -----------------------------------------------------------------------------
 
-bool gatewayCheckingRequestHandler(
+void gatewayCheckingHandler(
     const uint8_t packetId,
-    const uint8_t address,
+    const uint8_t nodeIndex,
+    const uint8_t senderAddress,
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
@@ -223,21 +203,16 @@ bool gatewayCheckingRequestHandler(
          * Node responded to PING
          */
         case GATEWAY_PACKET_PONG:
-            _gatewayCheckingPongHandler(packetId, gatewayAddressingGetNodeIndex(address), payload, payloadLength);
+            _gatewayCheckingPongHandler(packetId, nodeIndex, payload, payloadLength);
             break;
 
         /**
          * Node confirmed hello message
          */
         case GATEWAY_PACKET_HELLO:
-            _gatewayCheckingHelloHandler(packetId, gatewayAddressingGetNodeIndex(address), payload, payloadLength);
+            _gatewayCheckingHelloHandler(packetId, nodeIndex, payload, payloadLength);
             break;
-
-        default:
-            return false;
     }
-
-    return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -4,26 +4,217 @@ GATEWAY MODULE - NODES COMMUNICATION
 
 Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
+Expected replies are stored in in-flight table, so several nodes could have
+outstanding request at the same time.
+
+Sequencing:
+-----------
+Packets for nodes supporting it are extended with trailing sequence byte and
+node have to echo this byte back as last byte of its reply. Replies with unknown
+sequence (late or duplicate) are dropped. Support is learned during node
+initialization by PING probe carrying sequence byte, supporting node echoes it
+in PONG. Until support is confirmed, packets are sent without sequence byte,
+nothing is stripped from received packets and replies are matched by packet id.
+
+Requests are queued on bus and transmitted asynchronously. Reply timeout starts
+only when request is acknowledged on bus, requests which could not be
+transmitted are released immediately.
+
+Timeouts:
+---------
+Accepted replies are round-trip time samples. Replies of sequenced transmissions
+are not ambiguous even for retried requests. Reply of node without sequencing
+could belong to any attempt of retried request, so it is not sampled (Karn's
+rule). Node reply timeout is computed from smoothed RTT and its variation (srtt + 4 * rttvar).
+Retries of unanswered requests are delayed with exponential backoff and random
+jitter and lost node is probed with doubling delay up to FB_GATEWAY_LOST_DELAY.
+
 */
 
 #if FB_GATEWAY_SUPPORT
 
-gateway_node_communication_t _gateway_nodes_communication[FB_GATEWAY_MAX_NODES];
+gateway_packet_in_flight_t _gateway_packets_in_flight[FB_GATEWAY_MAX_IN_FLIGHT];
+
+uint8_t _gateway_packet_sequence = 0;
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE PRIVATE
+// -----------------------------------------------------------------------------
+
+uint8_t _gatewayCommunicationFindInFlight(
+    const uint8_t nodeIndex
+) {
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_IN_FLIGHT; i++) {
+        if (_gateway_packets_in_flight[i].node_index == nodeIndex) {
+            return i;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Update node round-trip time estimation with new sample
+ */
+void _gatewayCommunicationUpdateRoundTrip(
+    const uint8_t nodeIndex,
+    uint32_t sample
+) {
+    if (sample > FB_GATEWAY_RESPONSE_TIMEOUT_MAX) {
+        sample = FB_GATEWAY_RESPONSE_TIMEOUT_MAX;
+    }
+
+    // First measurement, lowest bit keeps zero samples distinguishable from not measured node
+    if (_gateway_nodes[nodeIndex].communication.srtt == 0) {
+        _gateway_nodes[nodeIndex].communication.srtt = (sample << 3) + 1;
+        _gateway_nodes[nodeIndex].communication.rttvar = sample << 1;
+
+        return;
+    }
+
+    // srtt = 7/8 srtt + 1/8 sample
+    int32_t delta = (int32_t) sample - (_gateway_nodes[nodeIndex].communication.srtt >> 3);
+
+    _gateway_nodes[nodeIndex].communication.srtt = (int32_t) _gateway_nodes[nodeIndex].communication.srtt + delta;
+
+    // rttvar = 3/4 rttvar + 1/4 |delta|
+    if (delta < 0) {
+        delta = -delta;
+    }
+
+    delta = delta - (_gateway_nodes[nodeIndex].communication.rttvar >> 2);
+
+    _gateway_nodes[nodeIndex].communication.rttvar = (int32_t) _gateway_nodes[nodeIndex].communication.rttvar + delta;
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewayCommunicationReleaseInFlight(
+    const uint8_t position
+) {
+    _gateway_packets_in_flight[position].node_index = INDEX_NONE;
+    _gateway_packets_in_flight[position].packet_id = GATEWAY_PACKET_NONE;
+    _gateway_packets_in_flight[position].sequence = 0;
+    _gateway_packets_in_flight[position].sequenced = false;
+    _gateway_packets_in_flight[position].sent = 0;
+    _gateway_packets_in_flight[position].transmitted = false;
+}
 
 // -----------------------------------------------------------------------------
 // MODULE: SUB-MODULE API
 // -----------------------------------------------------------------------------
 
+/**
+ * Get sequence number for new outgoing packet
+ */
+uint8_t gatewayCommunicationNextSequence()
+{
+    _gateway_packet_sequence++;
+
+    return _gateway_packet_sequence;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Discard expected reply of node, node is not waiting for any packet
+ */
+void gatewayCommunicationResetWaitingPacket(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    uint8_t position = _gatewayCommunicationFindInFlight(nodeIndex);
+
+    if (position != INDEX_NONE) {
+        _gatewayCommunicationReleaseInFlight(position);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Register expected reply for packet sent with given sequence
+ */
 void gatewayCommunicationSetWaitingPacket(
     const uint8_t nodeIndex,
-    const uint8_t packetId
+    const uint8_t packetId,
+    const uint8_t sequence,
+    const bool sequenced
 ) {
     // Validate node index
     if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
         return;
     }
 
-    _gateway_nodes_communication[nodeIndex].waiting_for = packetId;
+    // Node could wait only for one reply, previous request is discarded
+    gatewayCommunicationResetWaitingPacket(nodeIndex);
+
+    if (packetId == GATEWAY_PACKET_NONE) {
+        return;
+    }
+
+    uint8_t position = _gatewayCommunicationFindInFlight(INDEX_NONE);
+
+    // Table is full, the oldest request is discarded
+    if (position == INDEX_NONE) {
+        position = 0;
+
+        for (uint8_t i = 1; i < FB_GATEWAY_MAX_IN_FLIGHT; i++) {
+            if ((int32_t) (_gateway_packets_in_flight[i].sent - _gateway_packets_in_flight[position].sent) < 0) {
+                position = i;
+            }
+        }
+    }
+
+    _gateway_packets_in_flight[position].node_index = nodeIndex;
+    _gateway_packets_in_flight[position].packet_id = packetId;
+    _gateway_packets_in_flight[position].sequence = sequence;
+    _gateway_packets_in_flight[position].sequenced = sequenced;
+    _gateway_packets_in_flight[position].sent = millis();
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Start reply timeout of request which was transmitted on bus
+ */
+void gatewayCommunicationPacketTransmitted(
+    const uint8_t sequence
+) {
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_IN_FLIGHT; i++) {
+        if (
+            _gateway_packets_in_flight[i].node_index != INDEX_NONE
+            && _gateway_packets_in_flight[i].sequence == sequence
+            && _gateway_packets_in_flight[i].transmitted == false
+        ) {
+            _gateway_packets_in_flight[i].sent = millis();
+            _gateway_packets_in_flight[i].transmitted = true;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Release request which was not transmitted, node could not reply to it
+ */
+void gatewayCommunicationPacketDropped(
+    const uint8_t sequence
+) {
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_IN_FLIGHT; i++) {
+        if (
+            _gateway_packets_in_flight[i].node_index != INDEX_NONE
+            && _gateway_packets_in_flight[i].sequence == sequence
+        ) {
+            _gatewayCommunicationReleaseInFlight(i);
+        }
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -37,7 +228,7 @@ bool gatewayCommunicationIsWaitingForPacket(
         return false;
     }
 
-    return _gateway_nodes_communication[nodeIndex].waiting_for == packedId;
+    return gatewayCommunicationGetPacketWaitingFor(nodeIndex) == packedId;
 }
 
 // -----------------------------------------------------------------------------
@@ -50,7 +241,296 @@ uint8_t gatewayCommunicationGetPacketWaitingFor(
         return GATEWAY_PACKET_NONE;
     }
 
-    return _gateway_nodes_communication[nodeIndex].waiting_for;
+    uint8_t position = _gatewayCommunicationFindInFlight(nodeIndex);
+
+    if (position == INDEX_NONE) {
+        return GATEWAY_PACKET_NONE;
+    }
+
+    return _gateway_packets_in_flight[position].packet_id;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check received reply against in-flight table and release matched request
+ */
+bool gatewayCommunicationAcceptReply(
+    const uint8_t nodeIndex,
+    const uint8_t packetId,
+    const uint8_t sequence
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return false;
+    }
+
+    uint8_t position = _gatewayCommunicationFindInFlight(nodeIndex);
+
+    if (
+        position == INDEX_NONE
+        || _gateway_packets_in_flight[position].packet_id != packetId
+    ) {
+        return false;
+    }
+
+    // Sequence could be checked only when it was sent and node echoes it
+    if (
+        _gateway_packets_in_flight[position].sequenced
+        && gatewayCommunicationIsSequenced(nodeIndex)
+        && _gateway_packets_in_flight[position].sequence != sequence
+    ) {
+        return false;
+    }
+
+    // Late reply to previous attempt could not be told from reply to retry without sequence
+    if (
+        _gateway_packets_in_flight[position].sequenced
+        || gatewayCommunicationGetAttempts(nodeIndex) <= 1
+    ) {
+        _gatewayCommunicationUpdateRoundTrip(nodeIndex, millis() - _gateway_packets_in_flight[position].sent);
+    }
+
+    _gatewayCommunicationReleaseInFlight(position);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if node echoes sequence byte, only then it is appended to packets for node and stripped from its packets
+ */
+bool gatewayCommunicationIsSequenced(
+    const uint8_t nodeIndex
+) {
+    // Unknown sender & not used slot could not be sequenced
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
+        return false;
+    }
+
+    return _gateway_nodes_details[nodeIndex]->sequencing.support == GATEWAY_READING_SUPPORTED;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Count new sequencing probe, false when support is already known or node did not answer all probes
+ */
+bool gatewayCommunicationProbeSequencing(
+    const uint8_t nodeIndex
+) {
+    // Not used slot could not be probed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
+        return false;
+    }
+
+    gateway_node_sequencing_t & sequencing = _gateway_nodes_details[nodeIndex]->sequencing;
+
+    if (sequencing.support != GATEWAY_READING_SUPPORT_UNKNOWN) {
+        return false;
+    }
+
+    if (sequencing.probes >= FB_GATEWAY_SEQUENCING_PROBES) {
+        DEBUG_MSG(PSTR("[INFO][GATEWAY][COMMUNICATION] Node with address: %d did not answer sequencing probe, packets are sent without sequence\n"), gatewayAddressingGet(nodeIndex));
+
+        sequencing.support = GATEWAY_READING_UNSUPPORTED;
+
+        return false;
+    }
+
+    sequencing.probes++;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Learn sequencing support from reply to probe, supporting node echoes probe sequence as last byte
+ */
+void gatewayCommunicationLearnSequencing(
+    const uint8_t nodeIndex,
+    const uint8_t * payload,
+    const uint16_t length
+) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
+        return;
+    }
+
+    if (_gateway_nodes_details[nodeIndex]->sequencing.support != GATEWAY_READING_SUPPORT_UNKNOWN) {
+        return;
+    }
+
+    uint8_t position = _gatewayCommunicationFindInFlight(nodeIndex);
+
+    // Only reply to request carrying sequence byte is probe reply
+    if (
+        position == INDEX_NONE
+        || _gateway_packets_in_flight[position].sequenced == false
+        || _gateway_packets_in_flight[position].packet_id != (uint8_t) payload[0]
+    ) {
+        return;
+    }
+
+    if (length >= 2 && (uint8_t) payload[length - 1] == _gateway_packets_in_flight[position].sequence) {
+        _gateway_nodes_details[nodeIndex]->sequencing.support = GATEWAY_READING_SUPPORTED;
+
+    } else {
+        DEBUG_MSG(PSTR("[INFO][GATEWAY][COMMUNICATION] Node with address: %d does not echo sequence, packets are sent without sequence\n"), gatewayAddressingGet(nodeIndex));
+
+        _gateway_nodes_details[nodeIndex]->sequencing.support = GATEWAY_READING_UNSUPPORTED;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Get time in ms reserved for node reply
+ */
+uint16_t gatewayCommunicationGetResponseTimeout(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return FB_GATEWAY_RESPONSE_TIMEOUT;
+    }
+
+    // Node was not measured yet
+    if (_gateway_nodes[nodeIndex].communication.srtt == 0) {
+        return FB_GATEWAY_RESPONSE_TIMEOUT;
+    }
+
+    uint32_t timeout = (_gateway_nodes[nodeIndex].communication.srtt >> 3) + _gateway_nodes[nodeIndex].communication.rttvar;
+
+    if (timeout < FB_GATEWAY_RESPONSE_TIMEOUT_MIN) {
+        return FB_GATEWAY_RESPONSE_TIMEOUT_MIN;
+    }
+
+    if (timeout > FB_GATEWAY_RESPONSE_TIMEOUT_MAX) {
+        return FB_GATEWAY_RESPONSE_TIMEOUT_MAX;
+    }
+
+    return timeout;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Get delay before request is retried, exponential backoff with jitter
+ */
+uint32_t gatewayCommunicationGetRetryDelay(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return FB_GATEWAY_RESPONSE_TIMEOUT;
+    }
+
+    uint32_t timeout = gatewayCommunicationGetResponseTimeout(nodeIndex);
+
+    uint8_t backoff = _gateway_nodes[nodeIndex].communication.attempts > 0 ? (_gateway_nodes[nodeIndex].communication.attempts - 1) : 0;
+
+    if (backoff > FB_GATEWAY_RETRY_BACKOFF_MAX) {
+        backoff = FB_GATEWAY_RETRY_BACKOFF_MAX;
+    }
+
+    // Jitter spreads retries of nodes which failed at the same moment
+    return (timeout << backoff) + random((timeout >> 1) + 1);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Get delay before next probe of lost node
+ */
+uint32_t gatewayCommunicationGetLostDelay(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return FB_GATEWAY_LOST_DELAY;
+    }
+
+    uint32_t delay = FB_GATEWAY_LOST_DELAY_MIN;
+
+    for (uint8_t i = 0; i < _gateway_nodes[nodeIndex].communication.lost_probes && delay < FB_GATEWAY_LOST_DELAY; i++) {
+        delay = delay << 1;
+    }
+
+    if (delay > FB_GATEWAY_LOST_DELAY) {
+        return FB_GATEWAY_LOST_DELAY;
+    }
+
+    return delay;
+}
+
+// -----------------------------------------------------------------------------
+
+void gatewayCommunicationIncrementLostProbes(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    if (_gateway_nodes[nodeIndex].communication.lost_probes < UINT8_MAX) {
+        _gateway_nodes[nodeIndex].communication.lost_probes = _gateway_nodes[nodeIndex].communication.lost_probes + 1;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void gatewayCommunicationResetLostProbes(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    _gateway_nodes[nodeIndex].communication.lost_probes = 0;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if request of given priority class could be sent, timed jobs could not use reserved slots
+ */
+bool gatewayCommunicationHasFreeSlot(
+    const uint8_t priority
+) {
+    uint8_t free_slots = 0;
+
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_IN_FLIGHT; i++) {
+        if (_gateway_packets_in_flight[i].node_index == INDEX_NONE) {
+            free_slots++;
+        }
+    }
+
+    if (priority < GATEWAY_PRIORITY_REQUESTED) {
+        return free_slots > 0;
+    }
+
+    return free_slots > FB_GATEWAY_RESERVED_IN_FLIGHT;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if any request is still waiting for reply
+ */
+bool gatewayCommunicationHasInFlight()
+{
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_IN_FLIGHT; i++) {
+        if (_gateway_packets_in_flight[i].node_index != INDEX_NONE) {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 // -----------------------------------------------------------------------------
@@ -63,7 +543,23 @@ void gatewayCommunicationIncrementAttempts(
         return;
     }
     
-    _gateway_nodes_communication[nodeIndex].attempts = _gateway_nodes_communication[nodeIndex].attempts + 1;
+    _gateway_nodes[nodeIndex].communication.attempts = _gateway_nodes[nodeIndex].communication.attempts + 1;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Count of requests sent to node since its last reply, the first transmission is 1
+ */
+uint8_t gatewayCommunicationGetAttempts(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return 0;
+    }
+
+    return _gateway_nodes[nodeIndex].communication.attempts;
 }
 
 // -----------------------------------------------------------------------------
@@ -76,7 +572,7 @@ void gatewayCommunicationResetAttempts(
         return;
     }
     
-    _gateway_nodes_communication[nodeIndex].attempts = 0;
+    _gateway_nodes[nodeIndex].communication.attempts = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -89,7 +585,7 @@ bool gatewayCommunicationIsMaxFailuresReached(
         return true;
     }
 
-    return _gateway_nodes_communication[nodeIndex].attempts >= FB_GATEWAY_MAX_SENDING_FAILURES;
+    return _gateway_nodes[nodeIndex].communication.attempts >= FB_GATEWAY_MAX_SENDING_FAILURES;
 }
 
 // -----------------------------------------------------------------------------
@@ -111,9 +607,20 @@ void gatewayCommunicationReset(
         return;
     }
 
-    _gateway_nodes_communication[nodeIndex].waiting_for = GATEWAY_PACKET_NONE;
-    _gateway_nodes_communication[nodeIndex].max_packet_size = PJON_PACKET_MAX_LENGTH;
-    _gateway_nodes_communication[nodeIndex].attempts = 0;
+    gatewayCommunicationResetWaitingPacket(nodeIndex);
+
+    _gateway_nodes[nodeIndex].communication.attempts = 0;
+    _gateway_nodes[nodeIndex].communication.lost_probes = 0;
+    _gateway_nodes[nodeIndex].communication.srtt = 0;
+    _gateway_nodes[nodeIndex].communication.rttvar = 0;
+
+    gatewayCommunicationSetMaxPacketSize(nodeIndex, PJON_PACKET_MAX_LENGTH);
+
+    // Node firmware could be changed, sequencing support is learned again
+    if (gatewayIsNodeAllocated(nodeIndex)) {
+        _gateway_nodes_details[nodeIndex]->sequencing.support = GATEWAY_READING_SUPPORT_UNKNOWN;
+        _gateway_nodes_details[nodeIndex]->sequencing.probes = 0;
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -122,12 +629,12 @@ void gatewayCommunicationSetMaxPacketSize(
     const uint8_t nodeIndex,
     const uint8_t maxPacketSize
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    _gateway_nodes_communication[nodeIndex].max_packet_size = maxPacketSize;
+    _gateway_nodes_details[nodeIndex]->max_packet_size = maxPacketSize;
 }
 
 // -----------------------------------------------------------------------------
@@ -140,7 +647,28 @@ uint8_t gatewayCommunicationGetMaxPacketSize(
         return PJON_PACKET_MAX_LENGTH;
     }
 
-    return _gateway_nodes_communication[nodeIndex].max_packet_size;
+    return _gateway_nodes_details[nodeIndex]->max_packet_size;
+}
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE CORE
+// -----------------------------------------------------------------------------
+
+void gatewayCommunicationLoop()
+{
+    uint32_t time = millis();
+
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_IN_FLIGHT; i++) {
+        if (
+            _gateway_packets_in_flight[i].node_index != INDEX_NONE
+            // Queued requests are released by bus sending result
+            && _gateway_packets_in_flight[i].transmitted
+            && (time - _gateway_packets_in_flight[i].sent) > gatewayCommunicationGetResponseTimeout(_gateway_packets_in_flight[i].node_index)
+        ) {
+            // Node did not reply in time, free slot for other requests
+            _gatewayCommunicationReleaseInFlight(i);
+        }
+    }
 }
 
-#endif
+#endif // FB_GATEWAY_SUPPORT
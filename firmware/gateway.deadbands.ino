@@ -0,0 +1,407 @@
+/*
+
+GATEWAY MODULE - ANALOG REGISTERS REPORT BY EXCEPTION
+
+Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
+
+*/
+
+#if FB_GATEWAY_SUPPORT
+
+// Settings of analog registers without own deadband
+gateway_register_deadband_t _gateway_deadbands_defaults;
+
+uint32_t _gateway_deadbands_last_check = 0;
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE PRIVATE
+// -----------------------------------------------------------------------------
+
+/**
+ * Report by exception entry of analog register, NULL for other registers spaces
+ */
+gateway_register_deadband_t * _gatewayDeadbandsGetEntry(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return NULL;
+    }
+
+    // Only analog registers are reported by exception
+    if (dataRegister != GATEWAY_REGISTER_AI && dataRegister != GATEWAY_REGISTER_AO) {
+        return NULL;
+    }
+
+    gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
+
+    // Validate register address
+    if (registers.deadbands == NULL || address >= registers.size[dataRegister]) {
+        return NULL;
+    }
+
+    if (dataRegister == GATEWAY_REGISTER_AO) {
+        return registers.deadbands + registers.size[GATEWAY_REGISTER_AI] + address;
+    }
+
+    return registers.deadbands + address;
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewayDeadbandsCopySettings(
+    gateway_register_deadband_t & entry,
+    const gateway_register_deadband_t & settings
+) {
+    entry.absolute = settings.absolute;
+    entry.percent = settings.percent;
+    entry.min_interval = settings.min_interval;
+    entry.max_interval = settings.max_interval;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if value is out of band around last reported value
+ * Band is the wider one of absolute & percentual deadband, zero band lets through every change
+ */
+bool _gatewayDeadbandsIsCrossed(
+    const gateway_register_deadband_t & entry,
+    const float value
+) {
+    // First received value is always reported
+    if ((entry.flags & GATEWAY_DEADBAND_FLAG_REPORTED) == 0) {
+        return true;
+    }
+
+    float band = entry.absolute;
+    float relative_band = fabs(entry.reported) * entry.percent / 100;
+
+    if (relative_band > band) {
+        band = relative_band;
+    }
+
+    float change = fabs(value - entry.reported);
+
+    return change > 0 && change >= band;
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewayDeadbandsMarkReported(
+    gateway_register_deadband_t & entry,
+    const float value,
+    const uint32_t time
+) {
+    entry.reported = value;
+    entry.reported_time = time;
+    entry.flags = (entry.flags | GATEWAY_DEADBAND_FLAG_REPORTED) & ~GATEWAY_DEADBAND_FLAG_PENDING;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Propagate actually stored register value to modules
+ */
+void _gatewayDeadbandsPublish(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address,
+    gateway_register_deadband_t & entry,
+    const uint32_t time
+) {
+    char payload[GATEWAY_REGISTER_VALUE_FORMAT_LENGTH];
+
+    if (!gatewayRegistersFormatValue(nodeIndex, dataRegister, address, payload)) {
+        return;
+    }
+
+    _gatewayDeadbandsMarkReported(entry, gatewayRegistersReadNumericValue(nodeIndex, dataRegister, address), time);
+
+    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, payload);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Report postponed values after minimal interval & unchanged values after heartbeat interval
+ */
+void _gatewayDeadbandsCheckNode(
+    const uint8_t nodeIndex,
+    const uint32_t time
+) {
+    for (uint8_t data_register = GATEWAY_REGISTER_AI; data_register <= GATEWAY_REGISTER_AO; data_register++) {
+        for (uint8_t address = 0; address < gatewayRegistersSize(nodeIndex, data_register); address++) {
+            gateway_register_deadband_t * entry = _gatewayDeadbandsGetEntry(nodeIndex, data_register, address);
+
+            if (entry == NULL) {
+                break;
+            }
+
+            if ((entry->flags & GATEWAY_DEADBAND_FLAG_PENDING) != 0) {
+                if ((time - entry->reported_time) < entry->min_interval) {
+                    continue;
+                }
+
+                entry->flags &= ~GATEWAY_DEADBAND_FLAG_PENDING;
+
+                // Value could return back into band while waiting
+                if (_gatewayDeadbandsIsCrossed(*entry, gatewayRegistersReadNumericValue(nodeIndex, data_register, address))) {
+                    _gatewayDeadbandsPublish(nodeIndex, data_register, address, *entry, time);
+
+                    continue;
+                }
+            }
+
+            if (
+                entry->max_interval > 0
+                && (entry->flags & GATEWAY_DEADBAND_FLAG_REPORTED) != 0
+                && (time - entry->reported_time) >= entry->max_interval
+            ) {
+                _gatewayDeadbandsPublish(nodeIndex, data_register, address, *entry, time);
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE API
+// -----------------------------------------------------------------------------
+
+/**
+ * Decide if changed register value have to be propagated now
+ * Values crossing deadband during minimal interval are postponed & reported by deadbands loop
+ */
+bool gatewayDeadbandsValueChanged(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address,
+    const float value
+) {
+    gateway_register_deadband_t * entry = _gatewayDeadbandsGetEntry(nodeIndex, dataRegister, address);
+
+    // Digital & event registers are propagated on every change
+    if (entry == NULL) {
+        return true;
+    }
+
+    if (!_gatewayDeadbandsIsCrossed(*entry, value)) {
+        return false;
+    }
+
+    uint32_t time = millis();
+
+    if (
+        (entry->flags & GATEWAY_DEADBAND_FLAG_REPORTED) != 0
+        && (time - entry->reported_time) < entry->min_interval
+    ) {
+        entry->flags |= GATEWAY_DEADBAND_FLAG_PENDING;
+
+        return false;
+    }
+
+    _gatewayDeadbandsMarkReported(*entry, value, time);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Register value was propagated out of deadbands, eg. as write confirmation
+ */
+void gatewayDeadbandsValueReported(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address
+) {
+    gateway_register_deadband_t * entry = _gatewayDeadbandsGetEntry(nodeIndex, dataRegister, address);
+
+    if (entry == NULL) {
+        return;
+    }
+
+    _gatewayDeadbandsMarkReported(*entry, gatewayRegistersReadNumericValue(nodeIndex, dataRegister, address), millis());
+}
+
+// -----------------------------------------------------------------------------
+
+const gateway_register_deadband_t * gatewayDeadbandsGet(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address
+) {
+    return _gatewayDeadbandsGetEntry(nodeIndex, dataRegister, address);
+}
+
+// -----------------------------------------------------------------------------
+
+bool gatewayDeadbandsIsOverridden(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address
+) {
+    gateway_register_deadband_t * entry = _gatewayDeadbandsGetEntry(nodeIndex, dataRegister, address);
+
+    return entry != NULL && (entry->flags & GATEWAY_DEADBAND_FLAG_OVERRIDE) != 0;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Set own deadband of analog register, defaults are not applied to it any more
+ */
+bool gatewayDeadbandsSet(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address,
+    const gateway_register_deadband_t & settings
+) {
+    gateway_register_deadband_t * entry = _gatewayDeadbandsGetEntry(nodeIndex, dataRegister, address);
+
+    if (entry == NULL) {
+        return false;
+    }
+
+    _gatewayDeadbandsCopySettings(*entry, settings);
+
+    entry->flags |= GATEWAY_DEADBAND_FLAG_OVERRIDE;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Drop own deadband of analog register and use defaults again
+ */
+bool gatewayDeadbandsRestoreDefaults(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address
+) {
+    gateway_register_deadband_t * entry = _gatewayDeadbandsGetEntry(nodeIndex, dataRegister, address);
+
+    if (entry == NULL) {
+        return false;
+    }
+
+    _gatewayDeadbandsCopySettings(*entry, _gateway_deadbands_defaults);
+
+    entry->flags &= ~GATEWAY_DEADBAND_FLAG_OVERRIDE;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+const gateway_register_deadband_t & gatewayDeadbandsGetDefaults()
+{
+    return _gateway_deadbands_defaults;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Update defaults and apply them to all registers without own deadband
+ */
+void gatewayDeadbandsSetDefaults(
+    const gateway_register_deadband_t & settings
+) {
+    _gatewayDeadbandsCopySettings(_gateway_deadbands_defaults, settings);
+
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+        if (!gatewayIsNodeAllocated(i)) {
+            continue;
+        }
+
+        for (uint8_t data_register = GATEWAY_REGISTER_AI; data_register <= GATEWAY_REGISTER_AO; data_register++) {
+            for (uint8_t address = 0; address < gatewayRegistersSize(i, data_register); address++) {
+                if (!gatewayDeadbandsIsOverridden(i, data_register, address)) {
+                    gatewayDeadbandsRestoreDefaults(i, data_register, address);
+                }
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void gatewayDeadbandsReset(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
+
+    if (registers.deadbands != NULL) {
+        delete[] registers.deadbands;
+
+        registers.deadbands = NULL;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Create deadbands of node analog registers, registers spaces sizes have to be known
+ */
+void gatewayDeadbandsInitialize(
+    const uint8_t nodeIndex
+) {
+    // Release previous deadbands structure
+    gatewayDeadbandsReset(nodeIndex);
+
+    gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
+
+    uint16_t count = (uint16_t) registers.size[GATEWAY_REGISTER_AI] + registers.size[GATEWAY_REGISTER_AO];
+
+    if (count == 0) {
+        return;
+    }
+
+    registers.deadbands = new gateway_register_deadband_t[count];
+
+    if (registers.deadbands == NULL) {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY][DEADBANDS] Not enough memory for node deadbands\n"));
+
+        return;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        _gatewayDeadbandsCopySettings(registers.deadbands[i], _gateway_deadbands_defaults);
+    }
+
+    // Apply registers own deadbands stored for node
+    gatewayStorageLoadDeadbands(nodeIndex);
+}
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE CORE
+// -----------------------------------------------------------------------------
+
+void gatewayDeadbandsLoop()
+{
+    uint32_t time = millis();
+
+    if ((time - _gateway_deadbands_last_check) < FB_GATEWAY_DEADBAND_CHECK_INTERVAL) {
+        return;
+    }
+
+    _gateway_deadbands_last_check = time;
+
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+        if (!gatewayIsNodeAllocated(i) || !gatewayIsNodeReady(i)) {
+            continue;
+        }
+
+        _gatewayDeadbandsCheckNode(i, time);
+    }
+}
+
+#endif // FB_GATEWAY_SUPPORT
@@ -8,8 +8,6 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
 #if FB_GATEWAY_SUPPORT
 
-gateway_node_initiliazation_t _gateway_nodes_initialization[FB_GATEWAY_MAX_NODES];
-
 // -----------------------------------------------------------------------------
 // MODULE: SUB-MODULE PRIVATE
 // -----------------------------------------------------------------------------
@@ -18,27 +16,71 @@ void _gatewayInitializationSendBaseInitializationPacket(
     const uint8_t nodeIndex,
     const uint8_t requestedPacket
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    char output_content[1];
+
+    // Packet identifier at first postion
+    output_content[0] = requestedPacket;
+
+    uint8_t packet_sequence;
+    bool packet_sequenced;
+
+    // Send packet to node
+    bool result = gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 1, NULL, packet_sequence, packet_sequenced);
+
+    // When successfully sent...
+    if (result == true) {
+        // ...add mark, that gateway is waiting for reply from node
+        gatewayCommunicationSetWaitingPacket(nodeIndex, requestedPacket, packet_sequence, packet_sequenced);
+
+    } else {
+        // ...sending packet failed, reset incomming handler
+        gatewayCommunicationResetWaitingPacket(nodeIndex);
+    }
+
+    // Increment communication counter
+    gatewayCommunicationIncrementAttempts(nodeIndex);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Probe node with PING carrying sequence byte, initialization continues when support is learned
+ */
+void _gatewayInitializationProbeSequencing(
+    const uint8_t nodeIndex
+) {
+    _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_PING;
+
+    // Support is known or node did not answer any probe
+    if (!gatewayCommunicationProbeSequencing(nodeIndex)) {
+        _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_HW_MODEL;
+
+        // Unanswered probes are not counted as node failures
+        gatewayCommunicationResetAttempts(nodeIndex);
+
+        _gatewayInitializationSendBaseInitializationPacket(nodeIndex, GATEWAY_PACKET_HW_MODEL);
+
         return;
     }
 
     char output_content[1];
 
     // Packet identifier at first postion
-    output_content[0] = requestedPacket;
+    output_content[0] = GATEWAY_PACKET_PING;
+
+    uint8_t packet_sequence;
 
     // Send packet to node
-    bool result = gatewaySendPacket(gatewayAddressingGet(nodeIndex), output_content, 1);
+    bool result = gatewaySendSequencingProbe(_gateway_nodes[nodeIndex].addressing.address, output_content, 1, packet_sequence);
 
     // When successfully sent...
     if (result == true) {
-        // ...add mark, that gateway is waiting for reply from node
-        gatewayCommunicationSetWaitingPacket(nodeIndex, requestedPacket);
+        // ...add mark, that gateway is waiting for reply from node, probe always carries sequence byte
+        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_PONG, packet_sequence, true);
 
     } else {
         // ...sending packet failed, reset incomming handler
-        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+        gatewayCommunicationResetWaitingPacket(nodeIndex);
     }
 
     // Increment communication counter
@@ -52,11 +94,6 @@ void _gatewayInitializationSendRegistersInitializationPacket(
     const uint8_t requestedPacket,
     const uint8_t start
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     char output_content[gatewayCommunicationGetMaxPacketSize(nodeIndex)];
 
     // Packet identifier at first postion
@@ -64,8 +101,8 @@ void _gatewayInitializationSendRegistersInitializationPacket(
     output_content[1] = (char) (start >> 8);
     output_content[2] = (char) (start & 0xFF);
     
-    // It is based on maximum packed size reduced by packet header (4 bytes)
-    uint8_t max_readable_addresses = start + gatewayCommunicationGetMaxPacketSize(nodeIndex) - 4;
+    // It is based on maximum packed size reduced by packet header (4 bytes) and sequence byte
+    uint8_t max_readable_addresses = start + gatewayCommunicationGetMaxPacketSize(nodeIndex) - 5;
 
     switch (requestedPacket)
     {
@@ -92,17 +129,20 @@ void _gatewayInitializationSendRegistersInitializationPacket(
             break;
     }
 
+    uint8_t packet_sequence;
+    bool packet_sequenced;
+
     // Send packet to node
-    bool result = gatewaySendPacket(gatewayAddressingGet(nodeIndex), output_content, 5);
+    bool result = gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 5, NULL, packet_sequence, packet_sequenced);
 
     // When successfully sent...
     if (result == true) {
         // ...add mark, that gateway is waiting for reply from node
-        gatewayCommunicationSetWaitingPacket(nodeIndex, requestedPacket);
+        gatewayCommunicationSetWaitingPacket(nodeIndex, requestedPacket, packet_sequence, packet_sequenced);
 
     } else {
         // ...sending packet failed, reset incomming handler
-        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+        gatewayCommunicationResetWaitingPacket(nodeIndex);
     }
 
     // Increment communication counter
@@ -114,8 +154,8 @@ void _gatewayInitializationSendRegistersInitializationPacket(
 void _gatewayInitializationMarkNodeAsInitialized(
     const uint8_t nodeIndex
 ) {
-    _gateway_nodes_initialization[nodeIndex].state = true;
-    _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_NONE;
+    _gateway_nodes[nodeIndex].initialization.state = true;
+    _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_NONE;
 
     // Initialized node is automatically ready for communication
     gatewayMarkNodeAsReady(nodeIndex);
@@ -132,7 +172,7 @@ void _gatewayInitializationMarkNodeAsInitialized(
 void _gatewayInitializationContinueInProcess(
     const uint8_t nodeIndex
 ) {
-    switch (_gateway_nodes_initialization[nodeIndex].step)
+    switch (_gateway_nodes[nodeIndex].initialization.step)
     {
         // Hardware info
         case GATEWAY_PACKET_HW_MODEL:
@@ -144,7 +184,7 @@ void _gatewayInitializationContinueInProcess(
         case GATEWAY_PACKET_FW_VERSION:
         // Registers info
         case GATEWAY_PACKET_REGISTERS_SIZE:
-            _gatewayInitializationSendBaseInitializationPacket(nodeIndex, _gateway_nodes_initialization[nodeIndex].step);
+            _gatewayInitializationSendBaseInitializationPacket(nodeIndex, _gateway_nodes[nodeIndex].initialization.step);
             break;
         
         // Analog registers
@@ -156,9 +196,10 @@ void _gatewayInitializationContinueInProcess(
             _gatewayInitializationSendRegistersInitializationPacket(nodeIndex, GATEWAY_PACKET_AO_REGISTERS_STRUCTURE, 0);
             break;
 
-        // Start initialization
+        // Start initialization, sequencing support have to be known before other packets
         case GATEWAY_PACKET_NONE:
-            _gatewayInitializationSendBaseInitializationPacket(nodeIndex, GATEWAY_PACKET_HW_MODEL);
+        case GATEWAY_PACKET_PING:
+            _gatewayInitializationProbeSequencing(nodeIndex);
             break;
 
         default:
@@ -173,11 +214,11 @@ bool _gatewayInitializationIsUnfinished(
 ) {
     if (
         // Check if node has finished addressing procedure
-        gatewayAddressingHasAssignedAddress(nodeIndex) == true
+        _gateway_nodes[nodeIndex].addressing.address != PJON_NOT_ASSIGNED
         // Check if node is not lost
-        && gatewayIsNodeLost(nodeIndex) == false
+        && _gateway_nodes[nodeIndex].lost == 0
         // Check if node is not initialized
-        && _gateway_nodes_initialization[nodeIndex].state == false
+        && _gateway_nodes[nodeIndex].initialization.state == false
     ) {
         return true;
     }
@@ -200,11 +241,6 @@ void _gatewayInitializationBaseDefinitionHandler(
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     uint8_t bytes_length = (uint8_t) payload[1];
 
     char content[bytes_length];
@@ -224,7 +260,7 @@ void _gatewayInitializationBaseDefinitionHandler(
     DEBUG_MSG(
         PSTR("[INFO][GATEWAY][INITIALIZATION] Received node description: %s for node with address: %d\n"),
         (char *) content,
-        gatewayAddressingGet(nodeIndex)
+        _gateway_nodes[nodeIndex].addressing.address
     );
 
     switch (packetId)
@@ -237,19 +273,19 @@ void _gatewayInitializationBaseDefinitionHandler(
         case GATEWAY_PACKET_HW_MODEL:
             gatewaySetHardwareModel(nodeIndex, content);
 
-            _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_HW_MANUFACTURER;
+            _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_HW_MANUFACTURER;
             break;
 
         case GATEWAY_PACKET_HW_MANUFACTURER:
             gatewaySetHardwareManufacturer(nodeIndex, content);
 
-            _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_HW_VERSION;
+            _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_HW_VERSION;
             break;
 
         case GATEWAY_PACKET_HW_VERSION:
             gatewaySetHardwareVersion(nodeIndex, content);
 
-            _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_FW_MODEL;
+            _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_FW_MODEL;
             break;
 
     /**
@@ -259,19 +295,19 @@ void _gatewayInitializationBaseDefinitionHandler(
         case GATEWAY_PACKET_FW_MODEL:
             gatewaySetFirmwareModel(nodeIndex, content);
 
-            _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_FW_MANUFACTURER;
+            _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_FW_MANUFACTURER;
             break;
 
         case GATEWAY_PACKET_FW_MANUFACTURER:
             gatewaySetFirmwareManufacturer(nodeIndex, content);
 
-            _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_FW_VERSION;
+            _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_FW_VERSION;
             break;
 
         case GATEWAY_PACKET_FW_VERSION:
             gatewaySetFirmwareVersion(nodeIndex, content);
 
-            _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_REGISTERS_SIZE;
+            _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_REGISTERS_SIZE;
             break;
 
     /**
@@ -283,7 +319,7 @@ void _gatewayInitializationBaseDefinitionHandler(
     }
 
     // Reset incomming handler
-    gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+    gatewayCommunicationResetWaitingPacket(nodeIndex);
     
     // Reset reading attempts counter
     gatewayCommunicationResetAttempts(nodeIndex);
@@ -307,11 +343,6 @@ void _gatewayInitializationRegistersDefinitionsHandler(
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     // Validate packet structure
     if (payloadLength != 6) {
         DEBUG_MSG(PSTR("[ERR][GATEWAY][INITIALIZATION] Packet structure is invalid. Packet lengt is not as expected\n"));
@@ -321,11 +352,14 @@ void _gatewayInitializationRegistersDefinitionsHandler(
 
     gatewayRegistersResetReading(nodeIndex);
 
-    gatewayRegistersInitializeDigitalInputs(nodeIndex, (uint8_t) payload[1]);
-    gatewayRegistersInitializeDigitalOutputs(nodeIndex, (uint8_t) payload[2]);
-    gatewayRegistersInitializeAnalogInputs(nodeIndex, (uint8_t) payload[3]);
-    gatewayRegistersInitializeAnalogOutputs(nodeIndex, (uint8_t) payload[4]);
-    gatewayRegistersInitializeEventInputs(nodeIndex, (uint8_t) payload[5]);
+    gatewayRegistersInitialize(
+        nodeIndex,
+        (uint8_t) payload[1],
+        (uint8_t) payload[2],
+        (uint8_t) payload[3],
+        (uint8_t) payload[4],
+        (uint8_t) payload[5]
+    );
  
     DEBUG_MSG(
         PSTR("[INFO][GATEWAY][INITIALIZATION] Received node registers structure (DI: %d, DO: %d, AI: %d, AO: %d, EV: %d) for node with address: %d\n"),
@@ -334,16 +368,16 @@ void _gatewayInitializationRegistersDefinitionsHandler(
         gatewayRegistersAnalogInputsSize(nodeIndex),
         gatewayRegistersAnalogOutputsSize(nodeIndex),
         gatewayRegistersEventInputsSize(nodeIndex),
-        gatewayAddressingGet(nodeIndex)
+        _gateway_nodes[nodeIndex].addressing.address
     );
 
     if (gatewayRegistersAnalogInputsSize(nodeIndex) > 0) {
-        _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_AI_REGISTERS_STRUCTURE;
-        _gateway_nodes_initialization[nodeIndex].register_position = 0;
+        _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_AI_REGISTERS_STRUCTURE;
+        _gateway_nodes_details[nodeIndex]->register_position = 0;
 
     } else if (gatewayRegistersAnalogOutputsSize(nodeIndex) > 0) {
-        _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_AO_REGISTERS_STRUCTURE;
-        _gateway_nodes_initialization[nodeIndex].register_position = 0;
+        _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_AO_REGISTERS_STRUCTURE;
+        _gateway_nodes_details[nodeIndex]->register_position = 0;
 
     } else {
         // Node initiliazation successfully finished
@@ -351,7 +385,7 @@ void _gatewayInitializationRegistersDefinitionsHandler(
     }
 
     // Reset incomming handler
-    gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+    gatewayCommunicationResetWaitingPacket(nodeIndex);
     
     // Reset reading attempts counter
     gatewayCommunicationResetAttempts(nodeIndex);
@@ -375,11 +409,6 @@ void _gatewayInitializationRegistersStructureHandler(
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     word register_address = (word) payload[1] << 8 | (word) payload[2];
 
     uint8_t bytes_length = (uint8_t) payload[3];
@@ -408,7 +437,7 @@ void _gatewayInitializationRegistersStructureHandler(
     }
 
     // Reset incomming handler
-    gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+    gatewayCommunicationResetWaitingPacket(nodeIndex);
     
     // Reset reading attempts counter
     gatewayCommunicationResetAttempts(nodeIndex);
@@ -417,15 +446,15 @@ void _gatewayInitializationRegistersStructureHandler(
     {
         case GATEWAY_PACKET_AI_REGISTERS_STRUCTURE:
             if (gatewayRegistersAnalogInputsSize(nodeIndex) > bytes_length) {
-                _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_AI_REGISTERS_STRUCTURE;
-                _gateway_nodes_initialization[nodeIndex].register_position = (register_address + bytes_length);
+                _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_AI_REGISTERS_STRUCTURE;
+                _gateway_nodes_details[nodeIndex]->register_position = (register_address + bytes_length);
 
                 return;
             }
 
             if (gatewayRegistersAnalogOutputsSize(nodeIndex) > 0) {
-                _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_AO_REGISTERS_STRUCTURE;
-                _gateway_nodes_initialization[nodeIndex].register_position = 0;
+                _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_AO_REGISTERS_STRUCTURE;
+                _gateway_nodes_details[nodeIndex]->register_position = 0;
 
                 return;
             }
@@ -433,8 +462,8 @@ void _gatewayInitializationRegistersStructureHandler(
 
         case GATEWAY_PACKET_AO_REGISTERS_STRUCTURE:
             if (gatewayRegistersAnalogOutputsSize(nodeIndex) > bytes_length) {
-                _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_AO_REGISTERS_STRUCTURE;
-                _gateway_nodes_initialization[nodeIndex].register_position = (register_address + bytes_length);
+                _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_AO_REGISTERS_STRUCTURE;
+                _gateway_nodes_details[nodeIndex]->register_position = (register_address + bytes_length);
 
                 return;
             }
@@ -466,9 +495,15 @@ void gatewayInitializationReset(
         return;
     }
 
-    _gateway_nodes_initialization[nodeIndex].state = false;
-    _gateway_nodes_initialization[nodeIndex].step = GATEWAY_PACKET_NONE;
-    _gateway_nodes_initialization[nodeIndex].register_position = 0;
+    _gateway_nodes[nodeIndex].initialization.state = false;
+    _gateway_nodes[nodeIndex].initialization.step = GATEWAY_PACKET_NONE;
+
+    // Not used slot has no initialization process
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
+        return;
+    }
+
+    _gateway_nodes_details[nodeIndex]->register_position = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -481,14 +516,15 @@ bool gatewayInitializationIsNodeInitialized(
         return false;
     }
 
-    return _gateway_nodes_initialization[nodeIndex].state == true;
+    return _gateway_nodes[nodeIndex].initialization.state == true;
 }
 
 // -----------------------------------------------------------------------------
 
-bool gatewayInitializationHandler(
+void gatewayInitializationHandler(
     const uint8_t packetId,
-    const uint8_t address,
+    const uint8_t nodeIndex,
+    const uint8_t senderAddress,
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
@@ -500,26 +536,21 @@ bool gatewayInitializationHandler(
         case GATEWAY_PACKET_FW_MODEL:
         case GATEWAY_PACKET_FW_MANUFACTURER:
         case GATEWAY_PACKET_FW_VERSION:
-            _gatewayInitializationBaseDefinitionHandler(packetId, gatewayAddressingGetNodeIndex(address), payload, payloadLength);
+            _gatewayInitializationBaseDefinitionHandler(packetId, nodeIndex, payload, payloadLength);
             break;
 
         case GATEWAY_PACKET_REGISTERS_SIZE:
-            _gatewayInitializationRegistersDefinitionsHandler(gatewayAddressingGetNodeIndex(address), payload, payloadLength);
+            _gatewayInitializationRegistersDefinitionsHandler(nodeIndex, payload, payloadLength);
             break;
 
         case GATEWAY_PACKET_AI_REGISTERS_STRUCTURE:
-            _gatewayInitializationRegistersStructureHandler(packetId, gatewayAddressingGetNodeIndex(address), payload, payloadLength);
+            _gatewayInitializationRegistersStructureHandler(packetId, nodeIndex, payload, payloadLength);
             break;
 
         case GATEWAY_PACKET_AO_REGISTERS_STRUCTURE:
-            _gatewayInitializationRegistersStructureHandler(packetId, gatewayAddressingGetNodeIndex(address), payload, payloadLength);
+            _gatewayInitializationRegistersStructureHandler(packetId, nodeIndex, payload, payloadLength);
             break;
-
-        default:
-            return false;
     }
-
-    return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -529,11 +560,6 @@ bool gatewayInitializationHandler(
 bool gatewayInitializationLoop(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return false;
-    }
-
     // Check if all connected nodes have finished initialization process
     if (_gatewayInitializationIsUnfinished(nodeIndex)) {
         _gatewayInitializationContinueInProcess(nodeIndex);
@@ -14,10 +14,28 @@ PJON<ThroughSerial> _gateway_bus(FB_GATEWAY_MASTER_ID);
 
 SoftwareSerial * _gateway_serial_bus;
 
-uint8_t _gateway_reading_node_index = 0;
-
+// Nodes scheduling state, accessed in every gateway loop
 gateway_node_t _gateway_nodes[FB_GATEWAY_MAX_NODES];
 
+// Nodes descriptions & registers, allocated only for used slots
+gateway_node_details_t * _gateway_nodes_details[FB_GATEWAY_MAX_NODES];
+
+// Shared details of not used slots, so reading details of any slot is safe
+gateway_node_details_t _gateway_node_details_empty;
+
+// Packets queued on bus, indexed by bus packets buffer position
+gateway_packet_sending_t _gateway_packets_sending[PJON_MAX_PACKETS];
+
+// Static RAM used by one node slot across all gateway sub-modules
+#define GATEWAY_NODE_SLOT_SIZE (sizeof(gateway_node_t) + sizeof(gateway_node_details_t *) + sizeof(gateway_scheduler_job_t) + sizeof(uint8_t))
+
+static_assert(FB_GATEWAY_MAX_NODES < INDEX_NONE, "FB_GATEWAY_MAX_NODES have to be lower than INDEX_NONE");
+static_assert(FB_GATEWAY_MAX_ADDRESS < FB_GATEWAY_MASTER_ID, "FB_GATEWAY_MAX_ADDRESS have to be lower than FB_GATEWAY_MASTER_ID");
+static_assert(FB_GATEWAY_RESERVED_IN_FLIGHT < FB_GATEWAY_MAX_IN_FLIGHT, "FB_GATEWAY_RESERVED_IN_FLIGHT have to be lower than FB_GATEWAY_MAX_IN_FLIGHT");
+static_assert(GATEWAY_NODE_SLOT_SIZE <= FB_GATEWAY_NODE_RAM_BUDGET, "Node slot exceeds FB_GATEWAY_NODE_RAM_BUDGET");
+static_assert(sizeof(gateway_node_details_t) <= FB_GATEWAY_NODE_DETAILS_RAM_BUDGET, "Node details exceed FB_GATEWAY_NODE_DETAILS_RAM_BUDGET");
+static_assert((FB_GATEWAY_MAX_NODES * GATEWAY_NODE_SLOT_SIZE) + FB_GATEWAY_MAX_ADDRESS + 1 <= FB_GATEWAY_RAM_BUDGET, "Node slots exceed FB_GATEWAY_RAM_BUDGET, lower FB_GATEWAY_MAX_NODES");
+
 // -----------------------------------------------------------------------------
 // MODULE PRIVATE
 // -----------------------------------------------------------------------------
@@ -36,14 +54,6 @@ void _gatewayResetNode(
     // Reset lost status
     _gateway_nodes[nodeIndex].lost = 0;
 
-    strcpy(_gateway_nodes[nodeIndex].hardware.manufacturer, (char *) GATEWAY_DESCRIPTION_NOT_SET);
-    strcpy(_gateway_nodes[nodeIndex].hardware.model, (char *) GATEWAY_DESCRIPTION_NOT_SET);
-    strcpy(_gateway_nodes[nodeIndex].hardware.version, (char *) GATEWAY_DESCRIPTION_NOT_SET);
-
-    strcpy(_gateway_nodes[nodeIndex].firmware.manufacturer, (char *) GATEWAY_DESCRIPTION_NOT_SET);
-    strcpy(_gateway_nodes[nodeIndex].firmware.model, (char *) GATEWAY_DESCRIPTION_NOT_SET);
-    strcpy(_gateway_nodes[nodeIndex].firmware.version, (char *) GATEWAY_DESCRIPTION_NOT_SET);
-
     // Reset node initialization process
     gatewayInitializationReset(nodeIndex);
 
@@ -58,70 +68,190 @@ void _gatewayResetNode(
 
     // Reset registers reading process
     gatewayRegistersResetReading(nodeIndex);
+
+    // Reset node scheduling
+    gatewaySchedulerReset(nodeIndex);
+
+    // Reset node mapping in other modules
+    gatewayModulesNodeReset(nodeIndex);
 }
 
-// -----------------------------------------------------------------------------
-// PACKETS
 // -----------------------------------------------------------------------------
 
-bool _gatewayIsPacketInGroup(
-    const uint8_t packetId,
-    const int * group,
-    const uint8_t length
+/**
+ * Process one scheduled job of node and return timestamp of its next job
+ */
+uint32_t _gatewayProcessNode(
+    const uint8_t nodeIndex,
+    const uint32_t time
 ) {
-    for (uint8_t i = 0; i < length; i++) {
-        if ((uint8_t) pgm_read_byte(&group[i]) == packetId) {
-            return true;
+    // Validate node index, sub-modules steps below rely on it
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return time + FB_GATEWAY_IDLE_INTERVAL;
+    }
+
+    // Not used slot is not processed until node is allocated into it
+    if (_gateway_nodes_details[nodeIndex] == &_gateway_node_details_empty) {
+        return time + GATEWAY_NODE_SLOT_PARK_TIME;
+    }
+
+    if (_gateway_nodes[nodeIndex].lost > 0) {
+        uint32_t lost_delay = gatewayCommunicationGetLostDelay(nodeIndex);
+
+        if ((time - _gateway_nodes[nodeIndex].lost) < lost_delay) {
+            return _gateway_nodes[nodeIndex].lost + lost_delay;
         }
+
+        // Update lost timestamp
+        _gateway_nodes[nodeIndex].lost = time;
+
+        // Each unanswered probe widen delay before the next one
+        gatewayCommunicationIncrementLostProbes(nodeIndex);
     }
 
-    return false;
+    // Attempts counter reached maximum
+    if (gatewayCommunicationIsMaxFailuresReached(nodeIndex)) {
+        // Mark node as lost
+        gatewayMarkNodeAsLost(nodeIndex);
+
+        return time + gatewayCommunicationGetLostDelay(nodeIndex);
+    }
+
+    if (gatewayAddressingLoop(nodeIndex)) {
+        // Address was broadcasted, node needs more time to confirm it
+        return time + FB_GATEWAY_ADDRESS_CONFIRM_TIME;
+    }
+
+    if (
+        gatewayInitializationLoop(nodeIndex)
+        || gatewayCheckingLoop(nodeIndex)
+        || gatewayRegistersLoop(nodeIndex)
+    ) {
+        // Request was sent, give node a time to reply
+        return time + gatewayCommunicationGetRetryDelay(nodeIndex);
+    }
+
+    return gatewaySchedulerGetNextPollingDue(nodeIndex, time);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if bus is kept free for nodes replies to broadcast
+ */
+bool _gatewayIsBusReserved()
+{
+    return gatewayAddressingIsCollecting() || gatewayReportingIsCollecting();
 }
 
 // -----------------------------------------------------------------------------
 
-uint8_t _gatewayGetPacketIndexInGroup(
-    const uint8_t packetId,
-    const int * group,
-    const uint8_t length
+/**
+ * Serve nodes queued for requested jobs, control class first
+ */
+void _gatewayProcessRequestedNodes(
+    const uint32_t time
 ) {
-    for (uint8_t i = 0; i < length; i++) {
-        if ((uint8_t) pgm_read_byte(&group[i]) == packetId) {
-            return i;
+    for (uint8_t priority = GATEWAY_PRIORITY_CONTROL; priority < GATEWAY_PRIORITY_REQUESTED; priority++) {
+        for (uint8_t i = 0; i < FB_GATEWAY_MAX_IN_FLIGHT; i++) {
+            // Nothing is sent until searching or reporting window is closed, requests stay queued
+            if (_gatewayIsBusReserved()) {
+                return;
+            }
+
+            // Control writes preempt polling, queries wait for reserved slot
+            if (
+                priority != GATEWAY_PRIORITY_CONTROL
+                && !gatewayCommunicationHasFreeSlot(priority)
+            ) {
+                return;
+            }
+
+            uint8_t node_index = gatewaySchedulerGetRequestedNode(priority);
+
+            if (node_index == INDEX_NONE) {
+                break;
+            }
+
+            // Released node has no pending job
+            if (!gatewayIsNodeAllocated(node_index)) {
+                continue;
+            }
+
+            // Lost or not initialized node could not be served, request is kept until node is ready
+            if (
+                !gatewayIsNodeReady(node_index)
+                || _gateway_nodes[node_index].lost > 0
+                // Query is served when node replies to its pending request
+                || (
+                    priority != GATEWAY_PRIORITY_CONTROL
+                    && gatewayCommunicationGetPacketWaitingFor(node_index) != GATEWAY_PACKET_NONE
+                )
+            ) {
+                gatewaySchedulerRequest(node_index, priority);
+
+                continue;
+            }
+
+            gatewaySchedulerSchedule(node_index, _gatewayProcessNode(node_index, time));
         }
     }
+}
 
-    return 0;
+// -----------------------------------------------------------------------------
+// PACKETS
+// -----------------------------------------------------------------------------
+
+// Handler & expected states for packet identifier, resolved by the compiler
+#define GATEWAY_PACKET_DISPATCH(id) { \
+    ( \
+        (id) == GATEWAY_PACKET_SEARCH_NODES_CONFIRM || (id) == GATEWAY_PACKET_NODE_ADDRESS_CONFIRM || (id) == GATEWAY_PACKET_ADDRESS_DISCARD ? gatewayAddressingHandler : \
+        (id) >= GATEWAY_PACKET_HW_MODEL && (id) <= GATEWAY_PACKET_AO_REGISTERS_STRUCTURE ? gatewayInitializationHandler : \
+        (id) >= GATEWAY_PACKET_READ_SINGLE_DI && (id) <= GATEWAY_PACKET_READ_CHANGES ? gatewayRegistersHandler : \
+        (id) == GATEWAY_PACKET_REPORT_CHANGES || (id) == GATEWAY_PACKET_READ_EVENTS ? gatewayRegistersHandler : \
+        (id) >= GATEWAY_PACKET_WRITE_ONE_DO && (id) <= GATEWAY_PACKET_WRITE_MULTI_AO ? gatewayRegistersHandler : \
+        (id) == GATEWAY_PACKET_PONG || (id) == GATEWAY_PACKET_HELLO ? gatewayCheckingHandler : \
+        (gateway_packet_handler_f) NULL \
+    ), ( \
+        (id) == GATEWAY_PACKET_SEARCH_NODES_CONFIRM || (id) == GATEWAY_PACKET_NODE_ADDRESS_CONFIRM || (id) == GATEWAY_PACKET_ADDRESS_DISCARD ? GATEWAY_PACKET_EXPECT_ANY : \
+        (id) == GATEWAY_PACKET_REPORT_CHANGES ? GATEWAY_PACKET_EXPECT_NODE : \
+        (GATEWAY_PACKET_EXPECT_NODE | GATEWAY_PACKET_EXPECT_REPLY) \
+    ) \
 }
 
+#define GATEWAY_PACKET_DISPATCH_4(id)   GATEWAY_PACKET_DISPATCH(id), GATEWAY_PACKET_DISPATCH(id + 1), GATEWAY_PACKET_DISPATCH(id + 2), GATEWAY_PACKET_DISPATCH(id + 3)
+#define GATEWAY_PACKET_DISPATCH_16(id)  GATEWAY_PACKET_DISPATCH_4(id), GATEWAY_PACKET_DISPATCH_4(id + 4), GATEWAY_PACKET_DISPATCH_4(id + 8), GATEWAY_PACKET_DISPATCH_4(id + 12)
+#define GATEWAY_PACKET_DISPATCH_64(id)  GATEWAY_PACKET_DISPATCH_16(id), GATEWAY_PACKET_DISPATCH_16(id + 16), GATEWAY_PACKET_DISPATCH_16(id + 32), GATEWAY_PACKET_DISPATCH_16(id + 48)
+
+// Received packets dispatch table indexed directly by packet identifier
+PROGMEM const gateway_packet_dispatch_t _gateway_packets_dispatch[256] = {
+    GATEWAY_PACKET_DISPATCH_64(0), GATEWAY_PACKET_DISPATCH_64(64), GATEWAY_PACKET_DISPATCH_64(128), GATEWAY_PACKET_DISPATCH_64(192)
+};
+
 // -----------------------------------------------------------------------------
 
+#if DEBUG_SUPPORT
 String _gatewayPacketName(
     const uint8_t packetId
 ) {
     char buffer[50] = {0};
 
-    if (_gatewayIsPacketInGroup(packetId, gateway_packets_searching, GATEWAY_PACKET_SEARCH_MAX)) {
-        strncpy_P(buffer, gateway_packets_searching_string[_gatewayGetPacketIndexInGroup(packetId, gateway_packets_searching, GATEWAY_PACKET_SEARCH_MAX)], sizeof(buffer));
-
-    } else if (_gatewayIsPacketInGroup(packetId, gateway_packets_node_initialization, GATEWAY_PACKET_NODE_INIT_MAX)) {
-        strncpy_P(buffer, gateway_packets_node_initialization_string[_gatewayGetPacketIndexInGroup(packetId, gateway_packets_node_initialization, GATEWAY_PACKET_NODE_INIT_MAX)], sizeof(buffer));
+    if (
+        packetId < (sizeof(gateway_packets_names) / sizeof(gateway_packets_names[0]))
+        && pgm_read_dword(&gateway_packets_names[packetId]) != 0
+    ) {
+        strncpy_P(buffer, (const char *) pgm_read_dword(&gateway_packets_names[packetId]), sizeof(buffer));
 
-    } else if (_gatewayIsPacketInGroup(packetId, gateway_packets_registers_reading, GATEWAY_PACKET_REGISTERS_READING_MAX)) {
-        strncpy_P(buffer, gateway_packets_registers_reading_string[_gatewayGetPacketIndexInGroup(packetId, gateway_packets_registers_reading, GATEWAY_PACKET_REGISTERS_READING_MAX)], sizeof(buffer));
-
-    } else if (_gatewayIsPacketInGroup(packetId, gateway_packets_registers_writing, GATEWAY_PACKET_REGISTERS_WRITING_MAX)) {
-        strncpy_P(buffer, gateway_packets_registers_writing_string[_gatewayGetPacketIndexInGroup(packetId, gateway_packets_registers_writing, GATEWAY_PACKET_REGISTERS_WRITING_MAX)], sizeof(buffer));
-
-    } else if (_gatewayIsPacketInGroup(packetId, gateway_packets_misc, GATEWAY_PACKET_MISC_MAX)) {
-        strncpy_P(buffer, gateway_packets_misc_string[_gatewayGetPacketIndexInGroup(packetId, gateway_packets_misc, GATEWAY_PACKET_MISC_MAX)], sizeof(buffer));
+    } else if (packetId == GATEWAY_PACKET_NONE) {
+        strncpy_P(buffer, gateway_packet_none, sizeof(buffer));
 
     } else {
-        strncpy_P(buffer, "unknown", sizeof(buffer));
+        strncpy_P(buffer, PSTR("unknown"), sizeof(buffer));
     }
     
     return String(buffer);
 }
+#endif
 
 // -----------------------------------------------------------------------------
 // COMMUNICATION HANDLERS
@@ -139,81 +269,100 @@ void _gatewayReceiveHandler(
         sender_address = packetInfo.sender_id;
     }
 
+    // Packet have to contain at least identifier
+    if (length < 1) {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY] Received packet is too short\n"));
+
+        return;
+    }
+
     // Get packet identifier from payload
     uint8_t packet_id = (uint8_t) payload[0];
 
     // DEBUG_MSG(PSTR("[INFO][GATEWAY] Received packet: %s for node with address: %d\n"), _gatewayPacketName(packet_id).c_str(), sender_address);
 
-    bool handler_result = false;
+    gateway_packet_handler_f handler = (gateway_packet_handler_f) pgm_read_dword(&_gateway_packets_dispatch[packet_id].handler);
+    uint8_t expects = pgm_read_byte(&_gateway_packets_dispatch[packet_id].expects);
 
-    // Addressing process handlers
-    handler_result = gatewayAddressingRequestHandler(packet_id, sender_address, payload, length);
+    if (handler == NULL) {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY] Received packet: %s for node with address: %d without any handler\n"), _gatewayPacketName(packet_id).c_str(), sender_address);
 
-    // Check if handler was successful
-    if (handler_result) {
         return;
     }
 
-    // Node address have to be valid    
-    if (sender_address == PJON_NOT_ASSIGNED) {
-        DEBUG_MSG(PSTR("[ERR][GATEWAY] Received packet is without sender address\n"));
+    uint8_t node_index = INDEX_NONE;
 
-        return;
-    }
+    if (expects & GATEWAY_PACKET_EXPECT_NODE) {
+        // Node address have to be valid
+        if (sender_address == PJON_NOT_ASSIGNED) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY] Received packet is without sender address\n"));
 
-    uint8_t node_index = gatewayAddressingGetNodeIndex(sender_address);
+            return;
+        }
 
-    // Validate node index
-    if (node_index >= FB_GATEWAY_MAX_NODES) {
-        DEBUG_MSG(PSTR("[ERR][GATEWAY] Received packet is for unknown sender address: %d\n"), sender_address);
+        node_index = gatewayAddressingGetNodeIndex(sender_address);
 
-        return;
-    }
+        // Validate node index
+        if (node_index >= FB_GATEWAY_MAX_NODES) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY] Received packet is for unknown sender address: %d\n"), sender_address);
 
-    // Check if gateway is waiting for reply from node (initiliazation sequence)
-    if (gatewayCommunicationIsWaitingForPacket(node_index, GATEWAY_PACKET_NONE)) {
-        DEBUG_MSG(
-            PSTR("[ERR][GATEWAY] Received packet for node with address: %d but gateway is not waiting for packet from this node\n"),
-            sender_address
-        );
+            return;
+        }
+    }
 
-        return;
+    // Reply to sequencing probe tells if node echoes sequence byte
+    if (expects & GATEWAY_PACKET_EXPECT_REPLY) {
+        gatewayCommunicationLearnSequencing(node_index, payload, length);
     }
 
-    // Check if gateway is waiting for reply from node (initiliazation sequence)
-    if (!gatewayCommunicationIsWaitingForPacket(node_index, packet_id)) {
-        DEBUG_MSG(
-            PSTR("[ERR][GATEWAY] Received packet: %s for node with address: %d but gateway is waiting for: %s\n"),
-            _gatewayPacketName(packet_id).c_str(),
-            sender_address,
-            _gatewayPacketName(gatewayCommunicationGetPacketWaitingFor(node_index)).c_str()
-        );
+    uint8_t sequence = 0;
+    uint8_t content_length = (uint8_t) length;
 
-        return;
-    }
-    
-    handler_result = gatewayInitializationHandler(packet_id, sender_address, payload, length);
+    // Only nodes known to support it append echoed sequence number as last byte
+    if (gatewayCommunicationIsSequenced(node_index)) {
+        if (length < 2) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY] Received packet is without sequence number\n"));
 
-    // Check if handler was successful
-    if (handler_result) {
-        return;
-    }
+            return;
+        }
 
-    handler_result = gatewayRegistersHandler(packet_id, sender_address, payload, length);
+        sequence = (uint8_t) payload[length - 1];
 
-    // Check if handler was successful
-    if (handler_result) {
-        return;
+        // Sequence byte is not part of packet content
+        content_length = (uint8_t) (length - 1);
     }
 
-    handler_result = gatewayCheckingRequestHandler(packet_id, sender_address, payload, length);
+    if (expects & GATEWAY_PACKET_EXPECT_REPLY) {
+        // Check if gateway is waiting for reply from node
+        if (gatewayCommunicationIsWaitingForPacket(node_index, GATEWAY_PACKET_NONE)) {
+            DEBUG_MSG(
+                PSTR("[ERR][GATEWAY] Received packet for node with address: %d but gateway is not waiting for packet from this node\n"),
+                sender_address
+            );
 
-    // Check if handler was successful
-    if (handler_result) {
-        return;
+            return;
+        }
+
+        // Check if reply belongs to request which is still in flight
+        if (!gatewayCommunicationAcceptReply(node_index, packet_id, sequence)) {
+            DEBUG_MSG(
+                PSTR("[ERR][GATEWAY] Received packet: %s with sequence: %d for node with address: %d but gateway is waiting for: %s. Packet is dropped\n"),
+                _gatewayPacketName(packet_id).c_str(),
+                sequence,
+                sender_address,
+                _gatewayPacketName(gatewayCommunicationGetPacketWaitingFor(node_index)).c_str()
+            );
+
+            return;
+        }
     }
 
-    DEBUG_MSG(PSTR("[ERR][GATEWAY] Received packet: %s for node with address: %d without any handler\n"), _gatewayPacketName(packet_id).c_str(), sender_address);
+    handler(packet_id, node_index, sender_address, payload, content_length);
+
+    if (expects & GATEWAY_PACKET_EXPECT_REPLY) {
+        // Node replied, continue with its next job
+        gatewaySchedulerWake(node_index);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -226,6 +375,11 @@ void _gatewayErrorHandler(
     if (code == PJON_CONNECTION_LOST) {
         DEBUG_MSG(PSTR("[ERR][GATEWAY] Node with address: %d is lost\n"), (_gateway_bus.packets[data].content[0] - 1));
 
+        // Bus removes packet after this handler, result is reported in gateway loop
+        if (data < PJON_MAX_PACKETS) {
+            _gateway_packets_sending[data].result = GATEWAY_SEND_FAILED;
+        }
+
     } else if (code == PJON_PACKETS_BUFFER_FULL) {
         DEBUG_MSG(PSTR("[ERR][GATEWAY] Buffer is full\n"));
 
@@ -237,78 +391,284 @@ void _gatewayErrorHandler(
     }
 }
 
+// -----------------------------------------------------------------------------
+
+/**
+ * Report result of queued packet and release its sending slot
+ */
+void _gatewaySendingFinish(
+    const uint8_t position
+) {
+    if (_gateway_packets_sending[position].packet_id == GATEWAY_PACKET_NONE) {
+        return;
+    }
+
+    gateway_packet_sending_t sending = _gateway_packets_sending[position];
+
+    _gateway_packets_sending[position].callback = NULL;
+    _gateway_packets_sending[position].packet_id = GATEWAY_PACKET_NONE;
+
+    if (sending.result == GATEWAY_SEND_SUCCESS) {
+        gatewayCommunicationPacketTransmitted(sending.sequence);
+
+    } else {
+        DEBUG_MSG(
+            PSTR("[ERR][GATEWAY] Sending packet: %s for node: %d failed, %s\n"),
+            _gatewayPacketName(sending.packet_id).c_str(),
+            sending.address,
+            sending.result == GATEWAY_SEND_TIMEOUT ? "timeout" : "not acknowledged"
+        );
+
+        gatewayCommunicationPacketDropped(sending.sequence);
+    }
+
+    if (sending.callback != NULL) {
+        sending.callback(
+            sending.address == PJON_BROADCAST ? INDEX_NONE : gatewayAddressingGetNodeIndex(sending.address),
+            sending.packet_id,
+            sending.result
+        );
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Collect results of packets queued on bus
+ */
+void _gatewaySendingLoop()
+{
+    uint32_t time = millis();
+
+    for (uint8_t i = 0; i < PJON_MAX_PACKETS; i++) {
+        if (_gateway_packets_sending[i].packet_id == GATEWAY_PACKET_NONE) {
+            continue;
+        }
+
+        // Packet is still waiting in bus queue
+        if (_gateway_bus.packets[i].state != 0) {
+            if ((time - _gateway_packets_sending[i].queued) <= FB_GATEWAY_SEND_TIMEOUT) {
+                continue;
+            }
+
+            _gateway_bus.remove(i);
+
+            _gateway_packets_sending[i].result = GATEWAY_SEND_TIMEOUT;
+        }
+
+        _gatewaySendingFinish(i);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // COMMUNICATION
 // -----------------------------------------------------------------------------
 
-bool gatewaySendPacket(
+/**
+ * Queue packet on bus, sequence byte is appended only when requested,
+ * sending result is reported to callback from gateway loop
+ */
+bool _gatewaySendPacket(
     const uint8_t address,
     const char * payload,
-    const uint8_t length
+    const uint8_t length,
+    gateway_send_callback_f callback,
+    const bool sequenced,
+    uint8_t & sequence
 ) {
-    uint16_t result = _gateway_bus.send_packet(
-        address,    // Node address
-        payload,    // Content
-        length      // Content length
-    );
+    char output_content[length + 1];
 
-    if (result != PJON_ACK) {
-        if (result == PJON_BUSY ) {
-            DEBUG_MSG(PSTR("[ERR][GATEWAY] Sending packet: %s for node: %d failed, bus is busy\n"), _gatewayPacketName(payload[0]).c_str(), address);
+    memcpy(output_content, payload, length);
 
-        } else if (result == PJON_FAIL) {
-            DEBUG_MSG(PSTR("[ERR][GATEWAY] Sending packet: %s for node: %d failed\n"), _gatewayPacketName(payload[0]).c_str(), address);
+    sequence = gatewayCommunicationNextSequence();
 
-        } else {
-            DEBUG_MSG(PSTR("[ERR][GATEWAY] Sending packet: %s for node: %d failed, unknonw error\n"), _gatewayPacketName(payload[0]).c_str(), address);
-        }
+    // Request sequence number have to be echoed back by node
+    if (sequenced) {
+        output_content[length] = (char) sequence;
+    }
+
+    uint16_t position = _gateway_bus.send(
+        address,                                // Node address
+        output_content,                         // Content
+        (sequenced ? (length + 1) : length)     // Content length
+    );
+
+    // Bus reports PJON_FAIL when its packets buffer is full
+    if (position >= PJON_MAX_PACKETS) {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY] Sending packet: %s for node: %d failed, bus queue is full\n"), _gatewayPacketName(payload[0]).c_str(), address);
 
         return false;
     }
 
-    if (address == PJON_BROADCAST) {
-        // DEBUG_MSG(PSTR("[INFO][GATEWAY] Successfully sent broadcast packet: %s\n"), _gatewayPacketName(payload[0]).c_str());
+    // Result of previous packet on this position could be still not reported
+    _gatewaySendingFinish(position);
 
-    } else {
-        // DEBUG_MSG(PSTR("[INFO][GATEWAY] Successfully sent packet: %s for node with address: %d\n"), _gatewayPacketName(payload[0]).c_str(), address);
-    }
+    _gateway_packets_sending[position].callback = callback;
+    _gateway_packets_sending[position].address = address;
+    _gateway_packets_sending[position].packet_id = payload[0];
+    _gateway_packets_sending[position].sequence = sequence;
+    _gateway_packets_sending[position].result = GATEWAY_SEND_SUCCESS;
+    _gateway_packets_sending[position].queued = millis();
 
     return true;
 }
 
 // -----------------------------------------------------------------------------
 
-void gatewayBroadcastPacket(
+/**
+ * Send packet to node, sequence of queued packet is provided for expected reply registration
+ */
+bool gatewaySendPacket(
+    const uint8_t address,
+    const char * payload,
+    const uint8_t length,
+    gateway_send_callback_f callback,
+    uint8_t & sequence,
+    bool & sequenced
+) {
+    // Sequence byte is appended only for nodes which are known to echo it back
+    sequenced = (address != PJON_BROADCAST && gatewayCommunicationIsSequenced(gatewayAddressingGetNodeIndex(address)));
+
+    return _gatewaySendPacket(
+        address,
+        payload,
+        length,
+        callback,
+        sequenced,
+        sequence
+    );
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Send packet with sequence byte to node which support of it is not known yet
+ */
+bool gatewaySendSequencingProbe(
+    const uint8_t address,
+    const char * payload,
+    const uint8_t length,
+    uint8_t & sequence
+) {
+    return _gatewaySendPacket(
+        address,
+        payload,
+        length,
+        NULL,
+        true,
+        sequence
+    );
+}
+
+// -----------------------------------------------------------------------------
+
+bool gatewayBroadcastPacket(
     const char * payload,
     const uint8_t length,
-    const uint8_t waitingTime
+    gateway_send_callback_f callback
 ) {
-    gatewaySendPacket(
+    uint8_t sequence;
+
+    // Replies are processed by standard receive handler
+    return _gatewaySendPacket(
         PJON_BROADCAST,
         payload,
-        length
+        length,
+        callback,
+        false,
+        sequence
     );
+}
 
-    if (waitingTime > 0) {
-        // Store start timestamp
-        uint32_t time = millis();
-    
-        while((millis() - time) <= waitingTime) {
-            if (_gateway_bus.receive() == PJON_ACK) {
-                return;
+// -----------------------------------------------------------------------------
+// MODULE API
+// -----------------------------------------------------------------------------
+
+/**
+ * Get node descriptions without copying registers
+ */
+const gateway_node_details_t & gatewayGetNodeDetails(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return _gateway_node_details_empty;
+    }
+
+    return *_gateway_nodes_details[nodeIndex];
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Allocate free slot for new node, returns INDEX_NONE when no slot or memory is available
+ */
+uint8_t gatewayAllocateNode()
+{
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+        if (_gateway_nodes_details[i] == &_gateway_node_details_empty) {
+            gateway_node_details_t * details = new gateway_node_details_t();
+
+            if (details == NULL) {
+                DEBUG_MSG(PSTR("[ERR][GATEWAY] Not enough memory for new node\n"));
+
+                return INDEX_NONE;
             }
+
+            strcpy(details->hardware.manufacturer, (char *) GATEWAY_DESCRIPTION_NOT_SET);
+            strcpy(details->hardware.model, (char *) GATEWAY_DESCRIPTION_NOT_SET);
+            strcpy(details->hardware.version, (char *) GATEWAY_DESCRIPTION_NOT_SET);
+
+            strcpy(details->firmware.manufacturer, (char *) GATEWAY_DESCRIPTION_NOT_SET);
+            strcpy(details->firmware.model, (char *) GATEWAY_DESCRIPTION_NOT_SET);
+            strcpy(details->firmware.version, (char *) GATEWAY_DESCRIPTION_NOT_SET);
+
+            _gateway_nodes_details[i] = details;
+
+            _gatewayResetNode(i);
+
+            return i;
         }
     }
+
+    return INDEX_NONE;
 }
 
 // -----------------------------------------------------------------------------
-// MODULE API
+
+/**
+ * Return node slot back to free slots
+ */
+void gatewayReleaseNode(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    if (_gateway_nodes_details[nodeIndex] == &_gateway_node_details_empty) {
+        return;
+    }
+
+    _gatewayResetNode(nodeIndex);
+
+    delete _gateway_nodes_details[nodeIndex];
+
+    _gateway_nodes_details[nodeIndex] = &_gateway_node_details_empty;
+}
+
 // -----------------------------------------------------------------------------
 
-gateway_node_t gatewayGetNode(
+bool gatewayIsNodeAllocated(
     const uint8_t nodeIndex
 ) {
-    return _gateway_nodes[nodeIndex];
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return false;
+    }
+
+    return _gateway_nodes_details[nodeIndex] != &_gateway_node_details_empty;
 }
 
 // -----------------------------------------------------------------------------
@@ -317,12 +677,12 @@ void gatewaySetSerialNumber(
     const uint8_t nodeIndex,
     const char * serialNumber
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    strcpy(_gateway_nodes[nodeIndex].serial_number, serialNumber);
+    strcpy(_gateway_nodes_details[nodeIndex]->serial_number, serialNumber);
 }
 
 // -----------------------------------------------------------------------------
@@ -336,7 +696,7 @@ void gatewayGetSerialNumber(
         return;
     }
 
-    strcpy(serialNumber, _gateway_nodes[nodeIndex].serial_number);
+    strcpy(serialNumber, _gateway_nodes_details[nodeIndex]->serial_number);
 }
 
 // -----------------------------------------------------------------------------
@@ -345,12 +705,12 @@ void gatewaySetHardwareModel(
     const uint8_t nodeIndex,
     const char * model
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    strcpy(_gateway_nodes[nodeIndex].hardware.model, model);
+    strcpy(_gateway_nodes_details[nodeIndex]->hardware.model, model);
 }
 
 // -----------------------------------------------------------------------------
@@ -364,7 +724,7 @@ void gatewayGetHardwareModel(
         return;
     }
 
-    strcpy(model, _gateway_nodes[nodeIndex].hardware.model);
+    strcpy(model, _gateway_nodes_details[nodeIndex]->hardware.model);
 }
 
 // -----------------------------------------------------------------------------
@@ -373,12 +733,12 @@ void gatewaySetHardwareManufacturer(
     const uint8_t nodeIndex,
     const char * manufacturer
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    strcpy(_gateway_nodes[nodeIndex].hardware.manufacturer, manufacturer);
+    strcpy(_gateway_nodes_details[nodeIndex]->hardware.manufacturer, manufacturer);
 }
 
 // -----------------------------------------------------------------------------
@@ -392,7 +752,7 @@ void gatewayGetHardwareManufacturer(
         return;
     }
 
-    strcpy(manufacturer, _gateway_nodes[nodeIndex].hardware.manufacturer);
+    strcpy(manufacturer, _gateway_nodes_details[nodeIndex]->hardware.manufacturer);
 }
 
 // -----------------------------------------------------------------------------
@@ -401,12 +761,12 @@ void gatewaySetHardwareVersion(
     const uint8_t nodeIndex,
     const char * version
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    strcpy(_gateway_nodes[nodeIndex].hardware.version, version);
+    strcpy(_gateway_nodes_details[nodeIndex]->hardware.version, version);
 }
 
 // -----------------------------------------------------------------------------
@@ -420,7 +780,7 @@ void gatewayGetHardwareVersion(
         return;
     }
 
-    strcpy(version, _gateway_nodes[nodeIndex].hardware.version);
+    strcpy(version, _gateway_nodes_details[nodeIndex]->hardware.version);
 }
 
 // -----------------------------------------------------------------------------
@@ -429,12 +789,12 @@ void gatewaySetFirmwareModel(
     const uint8_t nodeIndex,
     const char * model
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    strcpy(_gateway_nodes[nodeIndex].firmware.model, model);
+    strcpy(_gateway_nodes_details[nodeIndex]->firmware.model, model);
 }
 
 // -----------------------------------------------------------------------------
@@ -448,7 +808,7 @@ void gatewayGetFirmwareModel(
         return;
     }
 
-    strcpy(model, _gateway_nodes[nodeIndex].firmware.model);
+    strcpy(model, _gateway_nodes_details[nodeIndex]->firmware.model);
 }
 
 // -----------------------------------------------------------------------------
@@ -457,12 +817,12 @@ void gatewaySetFirmwareManufacturer(
     const uint8_t nodeIndex,
     const char * manufacturer
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    strcpy(_gateway_nodes[nodeIndex].firmware.manufacturer, manufacturer);
+    strcpy(_gateway_nodes_details[nodeIndex]->firmware.manufacturer, manufacturer);
 }
 
 // -----------------------------------------------------------------------------
@@ -476,7 +836,7 @@ void gatewayGetFirmwareManufacturer(
         return;
     }
 
-    strcpy(manufacturer, _gateway_nodes[nodeIndex].firmware.manufacturer);
+    strcpy(manufacturer, _gateway_nodes_details[nodeIndex]->firmware.manufacturer);
 }
 
 // -----------------------------------------------------------------------------
@@ -485,12 +845,12 @@ void gatewaySetFirmwareVersion(
     const uint8_t nodeIndex,
     const char * version
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    strcpy(_gateway_nodes[nodeIndex].firmware.version, version);
+    strcpy(_gateway_nodes_details[nodeIndex]->firmware.version, version);
 }
 
 // -----------------------------------------------------------------------------
@@ -504,7 +864,7 @@ void gatewayGetFirmwareVersion(
         return;
     }
 
-    strcpy(version, _gateway_nodes[nodeIndex].firmware.version);
+    strcpy(version, _gateway_nodes_details[nodeIndex]->firmware.version);
 }
 
 // -----------------------------------------------------------------------------
@@ -545,14 +905,15 @@ void gatewayMarkNodeAsLost(
     } else {
         DEBUG_MSG(PSTR("[WARN][GATEWAY] Node with address: %d is lost\n"), gatewayAddressingGet(nodeIndex));
 
-        // Reset counter
+        // Reset counters
         gatewayCommunicationResetAttempts(nodeIndex);
+        gatewayCommunicationResetLostProbes(nodeIndex);
 
         // Lost node have to be checked when is back alive
         _gateway_nodes[nodeIndex].ready = false;
 
         // Lost node is not waiting for any packet
-        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_NONE);
+        gatewayCommunicationResetWaitingPacket(nodeIndex);
 
         // Notify other modules
         gatewayModulesNodeIsLost(nodeIndex);
@@ -628,7 +989,7 @@ void gatewayResetNodeFlags(
 
 void gatewaySetup()
 {
-    _gateway_serial_bus = new SoftwareSerial(FB_GATEWAY_TX_PIN, FB_GATEWAY_RX_PIN);
+    _gateway_serial_bus = new SoftwareSerial(FB_GATEWAY_TX_PIN, FB_GATEWAY_RX_PIN, false, FB_GATEWAY_RX_BUFFER_SIZE);
     _gateway_serial_bus->begin(SERIAL_BAUDRATE);
 
     _gateway_bus.strategy.set_serial(_gateway_serial_bus);
@@ -639,6 +1000,13 @@ void gatewaySetup()
 
     _gateway_bus.begin();
 
+    // All slots are free until nodes are restored or found
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+        _gateway_nodes_details[i] = &_gateway_node_details_empty;
+    }
+
+    gatewaySchedulerSetup();
+    gatewayAddressingSetup();
     gatewayStorageSetup();
     gatewayModulesSetup();
 
@@ -657,49 +1025,43 @@ void gatewayLoop()
         return;
     }
 
-    if (_gateway_reading_node_index >= FB_GATEWAY_MAX_NODES) {
-        _gateway_reading_node_index = 0;
-    }
+    // Global addressing jobs (nodes searching & reservations timeouts)
+    gatewayAddressingLoop();
 
-    for (uint8_t i = _gateway_reading_node_index; i < FB_GATEWAY_MAX_NODES; i++) {
-        _gateway_reading_node_index++;
+    // Slots for changes pushed by nodes
+    gatewayReportingLoop();
 
-        if (gatewayIsNodeLost(i)) {
-            if ((time - _gateway_nodes[i].lost) < FB_GATEWAY_LOST_DELAY) {
-                break;
-            }
-
-            // Update lost timestamp
-            _gateway_nodes[i].lost = time;
-        }
+    // Postponed & heartbeat reports of analog registers
+    gatewayDeadbandsLoop();
 
-        // Attempts counter reached maximum
-        if (gatewayCommunicationIsMaxFailuresReached(i)) {
-            // Mark node as lost
-            gatewayMarkNodeAsLost(i);
+    // Release requests without reply
+    gatewayCommunicationLoop();
 
-            break;
-        }
-        
-        if (gatewayAddressingLoop(i)) {
-            break;
-        }
+    // Control writes & queries requested by user are served before timed jobs
+    _gatewayProcessRequestedNodes(time);
 
-        if (gatewayInitializationLoop(i)) {
-            break;
-        }
+    // Process the most overdue nodes while there is free slot for their requests
+    // Bus is kept free for unaddressed nodes replies during searching window & for nodes reports during reporting window
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_IN_FLIGHT && gatewayCommunicationHasFreeSlot(GATEWAY_PRIORITY_POLLING) && !_gatewayIsBusReserved(); i++) {
+        uint8_t node_index = gatewaySchedulerGetDueNode(time);
 
-        if (gatewayCheckingLoop(i)) {
+        if (node_index == INDEX_NONE) {
             break;
         }
 
-        if (gatewayRegistersLoop(i)) {
-            break;
-        }
+        gatewaySchedulerSchedule(node_index, _gatewayProcessNode(node_index, time));
     }
 
+    // Transmit queued packets and report their results
     _gateway_bus.update();
-    _gateway_bus.receive(50000);
+
+    _gatewaySendingLoop();
+
+    // Bytes are buffered by serial RX interrupt and bus strategy assembles frames
+    // incrementally from buffered bytes, so the loop never waits for idle bus
+    for (uint8_t i = 0; i < FB_GATEWAY_RECEIVE_ATTEMPTS && _gateway_serial_bus->available() > 0; i++) {
+        _gateway_bus.receive();
+    }
 }
 
 #endif // FB_GATEWAY_SUPPORT
\ No newline at end of file
@@ -18,471 +18,831 @@ uint8_t _gateway_do_register_channel_property_index = INDEX_NONE;
 uint8_t _gateway_ai_register_channel_property_index = INDEX_NONE;
 uint8_t _gateway_ao_register_channel_property_index = INDEX_NONE;
 uint8_t _gateway_ev_register_channel_property_index = INDEX_NONE;
+uint8_t _gateway_ev_register_channel_timestamp_index = INDEX_NONE;
+
+// Registers spaces short names used in statistics
+const char * const _gateway_registers_names[GATEWAY_REGISTER_MAX] = { "di", "do", "ai", "ao", "ev" };
+
+#if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
+    // Channels names prefixes of each registers space
+    const char * const _gateway_fastybird_channels_prefixes[GATEWAY_REGISTER_MAX] = {
+        FASTYBIRD_CHANNEL_BINARY_SENSOR,
+        FASTYBIRD_CHANNEL_BINARY_ACTOR,
+        FASTYBIRD_CHANNEL_ANALOG_SENSOR,
+        FASTYBIRD_CHANNEL_ANALOG_ACTOR,
+        FASTYBIRD_CHANNEL_EVENT
+    };
+
+    // Gateway node represented by each FastyBird node, filled when channels mapping is built
+    uint8_t _gateway_fastybird_nodes_map[INDEX_NONE];
+#endif
 
 // -----------------------------------------------------------------------------
 // MODULE: SUB-MODULE PRIVATE
 // -----------------------------------------------------------------------------
 
-#if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-    String _gatewayModulesCreateFastyBirdChannelName(
-        String channelPrefix,
-        uint8_t index
+/**
+ * Format actual polling intervals of node registers spaces, eg. di=100,ai=4500
+ */
+void _gatewayModulesFormatPollIntervals(
+    const uint8_t nodeIndex,
+    char * buffer,
+    const uint8_t bufferLength
+) {
+    uint8_t length = 0;
+
+    buffer[0] = '\0';
+
+    for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+        if (gatewayRegistersSize(nodeIndex, i) == 0) {
+            continue;
+        }
+
+        length += snprintf_P(
+            (buffer + length),
+            (bufferLength - length),
+            PSTR("%s%s=%u"),
+            (length > 0 ? "," : ""),
+            _gateway_registers_names[i],
+            gatewaySchedulerGetPollInterval(nodeIndex, i)
+        );
+
+        if (length >= bufferLength) {
+            return;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Apply stored default deadbands of analog registers
+ */
+void _gatewayModulesLoadDeadbandsDefaults()
+{
+    gateway_register_deadband_t settings;
+
+    settings.absolute = getSetting("gwDbAbsolute", FB_GATEWAY_DEADBAND_ABSOLUTE).toFloat();
+    settings.percent = getSetting("gwDbPercent", FB_GATEWAY_DEADBAND_PERCENT).toInt();
+    settings.min_interval = getSetting("gwDbMinInterval", FB_GATEWAY_DEADBAND_MIN_INTERVAL).toInt();
+    settings.max_interval = getSetting("gwDbMaxInterval", FB_GATEWAY_DEADBAND_MAX_INTERVAL).toInt();
+
+    gatewayDeadbandsSetDefaults(settings);
+}
+
+// -----------------------------------------------------------------------------
+
+#if FASTYBIRD_SUPPORT || (WEB_SUPPORT && WS_SUPPORT)
+    uint8_t _gatewayModulesFindNodeBySerialNumber(
+        const char * serialNumber
     ) {
-        // Create channel name with replacable suffix: somechannel-%d
-        char channel_with_suffix[channelPrefix.length() + 5];
-        strcpy(channel_with_suffix, channelPrefix.c_str());
-        strcat(channel_with_suffix, FASTYBIRD_CHANNEL_ARRAY_SUFFIX);
+        if (serialNumber == NULL) {
+            return INDEX_NONE;
+        }
 
-        char channel_name[strlen(channel_with_suffix) + 5];
-        sprintf(channel_name, channel_with_suffix, index);
+        for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+            if (gatewayIsNodeAllocated(i) && strcmp(gatewayGetNodeDetails(i).serial_number, serialNumber) == 0) {
+                return i;
+            }
+        }
 
-        return String(channel_name);
+        return INDEX_NONE;
     }
 
 // -----------------------------------------------------------------------------
 
-    void _gatewayModulesFastyBirdReportRegisterValue(
-        const uint8_t nodeIndex,
-        const uint8_t dataRegister,
-        const uint8_t address,
-        String payload
+    uint8_t _gatewayModulesFindRegisterByName(
+        const char * name
     ) {
-        gateway_node_t gateway_node = gatewayGetNode(nodeIndex);
+        if (name == NULL) {
+            return GATEWAY_REGISTER_NONE;
+        }
+
+        for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+            if (strcmp(_gateway_registers_names[i], name) == 0) {
+                return i;
+            }
+        }
 
-        uint8_t fb_node_index = fastybirdNodesFindNodeIndex(String(gateway_node.serial_number));
+        return GATEWAY_REGISTER_NONE;
+    }
 
-        if (fb_node_index != INDEX_NONE) {
-            String channel_name;
+// -----------------------------------------------------------------------------
+
+    /**
+     * Provide module configuration schema
+     */
+    void _gatewayModulesReportConfigurationSchema(
+        JsonArray& configuration
+    ) {
+        JsonObject& absolute = configuration.createNestedObject();
+
+        absolute["name"] = "gateway_deadband_absolute";
+        absolute["type"] = "number";
+        absolute["min"] = 0;
+        absolute["max"] = 10000;
+        absolute["step"] = 0.01;
+        absolute["default"] = FB_GATEWAY_DEADBAND_ABSOLUTE;
+
+        JsonObject& percent = configuration.createNestedObject();
+
+        percent["name"] = "gateway_deadband_percent";
+        percent["type"] = "number";
+        percent["min"] = 0;
+        percent["max"] = 100;
+        percent["step"] = 1;
+        percent["default"] = FB_GATEWAY_DEADBAND_PERCENT;
+
+        JsonObject& min_interval = configuration.createNestedObject();
+
+        min_interval["name"] = "gateway_report_min_interval";
+        min_interval["type"] = "number";
+        min_interval["min"] = 0;
+        min_interval["max"] = 60000;
+        min_interval["step"] = 100;
+        min_interval["default"] = FB_GATEWAY_DEADBAND_MIN_INTERVAL;
+
+        JsonObject& max_interval = configuration.createNestedObject();
+
+        max_interval["name"] = "gateway_report_max_interval";
+        max_interval["type"] = "number";
+        max_interval["min"] = 0;
+        max_interval["max"] = 86400000;
+        max_interval["step"] = 1000;
+        max_interval["default"] = FB_GATEWAY_DEADBAND_MAX_INTERVAL;
+    }
+
+// -----------------------------------------------------------------------------
+
+    /**
+     * Report module configuration, registers own deadbands are listed per node
+     */
+    void _gatewayModulesReportConfiguration(
+        JsonObject& configuration
+    ) {
+        const gateway_register_deadband_t & defaults = gatewayDeadbandsGetDefaults();
+
+        configuration["gateway_deadband_absolute"] = defaults.absolute;
+        configuration["gateway_deadband_percent"] = defaults.percent;
+        configuration["gateway_report_min_interval"] = defaults.min_interval;
+        configuration["gateway_report_max_interval"] = defaults.max_interval;
 
-            switch (dataRegister)
-            {
-                case GATEWAY_REGISTER_DI:
-                    channel_name = _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_BINARY_SENSOR, (address + 1));
-                    break;
+        JsonArray& deadbands = configuration.createNestedArray("gateway_deadbands");
 
-                case GATEWAY_REGISTER_DO:
-                    channel_name = _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_BINARY_ACTOR, (address + 1));
-                    break;
+        for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+            if (!gatewayIsNodeAllocated(i)) {
+                continue;
+            }
 
-                case GATEWAY_REGISTER_AI:
-                    channel_name = _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_ANALOG_SENSOR, (address + 1));
-                    break;
+            for (uint8_t data_register = GATEWAY_REGISTER_AI; data_register <= GATEWAY_REGISTER_AO; data_register++) {
+                for (uint8_t address = 0; address < gatewayRegistersSize(i, data_register); address++) {
+                    if (!gatewayDeadbandsIsOverridden(i, data_register, address)) {
+                        continue;
+                    }
 
-                case GATEWAY_REGISTER_AO:
-                    channel_name = _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_ANALOG_ACTOR, (address + 1));
-                    break;
+                    const gateway_register_deadband_t * settings = gatewayDeadbandsGet(i, data_register, address);
 
-                case GATEWAY_REGISTER_EV:
-                    channel_name = _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_EVENT, (address + 1));
-                    break;
+                    JsonObject& deadband = deadbands.createNestedObject();
 
-                default:
-                    return;
+                    deadband["node"] = gatewayGetNodeDetails(i).serial_number;
+                    deadband["register"] = _gateway_registers_names[data_register];
+                    deadband["address"] = address;
+                    deadband["absolute"] = settings->absolute;
+                    deadband["percent"] = settings->percent;
+                    deadband["min_interval"] = settings->min_interval;
+                    deadband["max_interval"] = settings->max_interval;
+                }
             }
+        }
+    }
+
+// -----------------------------------------------------------------------------
+
+    /**
+     * Update registers own deadbands, entry with "reset" flag returns register to defaults
+     *
+     * [{"node": "serial", "register": "ai", "address": 0, "absolute": 0.5, "percent": 0, "min_interval": 1000, "max_interval": 60000}]
+     */
+    bool _gatewayModulesUpdateDeadbands(
+        JsonArray& deadbands
+    ) {
+        bool is_updated = false;
+        bool updated_nodes[FB_GATEWAY_MAX_NODES] = { false };
+
+        for (JsonObject& deadband : deadbands) {
+            uint8_t node_index = _gatewayModulesFindNodeBySerialNumber(deadband["node"].as<const char *>());
+            uint8_t data_register = _gatewayModulesFindRegisterByName(deadband["register"].as<const char *>());
+            uint8_t address = deadband["address"].as<uint8_t>();
 
-            uint8_t fb_channel_index = fastybirdNodesFindChannelIndex(fb_node_index, channel_name);
+            bool result = false;
 
-            if (fb_channel_index != INDEX_NONE) {
-                uint8_t property_index = fastybirdNodesFindChannelPropertyIndex(fb_channel_index, FASTYBIRD_PROPERTY_STATE);
+            if (node_index == INDEX_NONE || data_register == GATEWAY_REGISTER_NONE) {
+                DEBUG_MSG(PSTR("[WARN][GATEWAY][MODULES] Deadband register was not found\n"));
 
-                if (property_index != INDEX_NONE) {
-                    DEBUG_MSG(PSTR("[INFO][GATEWAY][MODULES] Sending register value\n"));
+                continue;
+            }
+
+            if (deadband["reset"].as<bool>()) {
+                result = gatewayDeadbandsRestoreDefaults(node_index, data_register, address);
 
-                    fastybirdNodesReportChannelPropertyValue(
-                        fb_node_index,
-                        fb_channel_index,
-                        property_index,
-                        payload.c_str()
-                    );
+            } else if (gatewayDeadbandsGet(node_index, data_register, address) != NULL) {
+                // Partial update keeps not provided settings of register
+                gateway_register_deadband_t settings = *gatewayDeadbandsGet(node_index, data_register, address);
 
-                } else {
-                    fastybird_node_channel_t channel = fastybirdNodesGetChannel(fb_channel_index);
+                if (deadband.containsKey("absolute") && deadband["absolute"].as<float>() >= 0) {
+                    settings.absolute = deadband["absolute"].as<float>();
+                }
 
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Channel property for channel: %s was not found\n"), channel.name.c_str());
+                if (deadband.containsKey("percent") && deadband["percent"].as<int>() >= 0 && deadband["percent"].as<int>() <= 100) {
+                    settings.percent = deadband["percent"].as<uint8_t>();
                 }
 
-            } else {
-                fastybird_node_t node = fastybirdNodesGetNode(fb_node_index);
+                if (deadband.containsKey("min_interval")) {
+                    settings.min_interval = deadband["min_interval"].as<uint16_t>();
+                }
 
-                DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Channel for node: %s was not found\n"), node.id);
+                if (deadband.containsKey("max_interval")) {
+                    settings.max_interval = deadband["max_interval"].as<uint32_t>();
+                }
+
+                result = gatewayDeadbandsSet(node_index, data_register, address, settings);
             }
 
-        } else {
-            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Node was not found\n"));
+            if (!result) {
+                DEBUG_MSG(PSTR("[WARN][GATEWAY][MODULES] Deadband of register: %d could not be updated\n"), address);
+
+                continue;
+            }
+
+            DEBUG_MSG(PSTR("[INFO][GATEWAY][MODULES] Updated deadband of node: %s register: %s address: %d\n"), gatewayGetNodeDetails(node_index).serial_number, _gateway_registers_names[data_register], address);
+
+            updated_nodes[node_index] = true;
+            is_updated = true;
         }
+
+        for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+            if (updated_nodes[i]) {
+                gatewayStorageStoreDeadbands(i);
+            }
+        }
+
+        return is_updated;
     }
 
 // -----------------------------------------------------------------------------
 
-    void _gatewayModulesFastyBirdDoRegisterChannelProperyPayload(
-        const uint8_t fbNodeIndex,
-        const uint8_t fbChannelIndex,
-        const uint8_t fbPropertyIndex,
-        const char * payload
+    /**
+     * Update module configuration via WS or MQTT etc.
+     */
+    bool _gatewayModulesUpdateConfiguration(
+        JsonObject& configuration
     ) {
-        // TODO: implement it
+        DEBUG_MSG(PSTR("[INFO][GATEWAY][MODULES] Updating module\n"));
+
+        bool is_updated = false;
+        bool defaults_updated = false;
+
+        if (
+            configuration.containsKey("gateway_deadband_absolute")
+            && configuration["gateway_deadband_absolute"].as<float>() >= 0
+            && configuration["gateway_deadband_absolute"].as<float>() != getSetting("gwDbAbsolute", FB_GATEWAY_DEADBAND_ABSOLUTE).toFloat()
+        ) {
+            DEBUG_MSG(PSTR("[INFO][GATEWAY][MODULES] Setting: \"gateway_deadband_absolute\" to: %s\n"), String(configuration["gateway_deadband_absolute"].as<float>()).c_str());
+
+            setSetting("gwDbAbsolute", configuration["gateway_deadband_absolute"].as<float>());
+
+            defaults_updated = true;
+        }
+
+        if (
+            configuration.containsKey("gateway_deadband_percent")
+            && configuration["gateway_deadband_percent"].as<int>() >= 0
+            && configuration["gateway_deadband_percent"].as<int>() <= 100
+            && configuration["gateway_deadband_percent"].as<uint8_t>() != getSetting("gwDbPercent", FB_GATEWAY_DEADBAND_PERCENT).toInt()
+        ) {
+            DEBUG_MSG(PSTR("[INFO][GATEWAY][MODULES] Setting: \"gateway_deadband_percent\" to: %d\n"), configuration["gateway_deadband_percent"].as<uint8_t>());
+
+            setSetting("gwDbPercent", configuration["gateway_deadband_percent"].as<uint8_t>());
+
+            defaults_updated = true;
+        }
+
+        if (
+            configuration.containsKey("gateway_report_min_interval")
+            && configuration["gateway_report_min_interval"].as<uint16_t>() != getSetting("gwDbMinInterval", FB_GATEWAY_DEADBAND_MIN_INTERVAL).toInt()
+        ) {
+            DEBUG_MSG(PSTR("[INFO][GATEWAY][MODULES] Setting: \"gateway_report_min_interval\" to: %d\n"), configuration["gateway_report_min_interval"].as<uint16_t>());
+
+            setSetting("gwDbMinInterval", configuration["gateway_report_min_interval"].as<uint16_t>());
+
+            defaults_updated = true;
+        }
+
+        if (
+            configuration.containsKey("gateway_report_max_interval")
+            && configuration["gateway_report_max_interval"].as<uint32_t>() != (uint32_t) getSetting("gwDbMaxInterval", FB_GATEWAY_DEADBAND_MAX_INTERVAL).toInt()
+        ) {
+            DEBUG_MSG(PSTR("[INFO][GATEWAY][MODULES] Setting: \"gateway_report_max_interval\" to: %d\n"), configuration["gateway_report_max_interval"].as<uint32_t>());
+
+            setSetting("gwDbMaxInterval", configuration["gateway_report_max_interval"].as<uint32_t>());
+
+            defaults_updated = true;
+        }
+
+        if (defaults_updated) {
+            _gatewayModulesLoadDeadbandsDefaults();
+
+            is_updated = true;
+        }
+
+        if (
+            configuration.containsKey("gateway_deadbands")
+            && _gatewayModulesUpdateDeadbands(configuration["gateway_deadbands"].as<JsonArray&>())
+        ) {
+            is_updated = true;
+        }
+
+        return is_updated;
     }
+#endif // FASTYBIRD_SUPPORT || (WEB_SUPPORT && WS_SUPPORT)
 
 // -----------------------------------------------------------------------------
 
-    void _gatewayModulesFastyBirdAoRegisterChannelProperyPayload(
-        const uint8_t fbNodeIndex,
-        const uint8_t fbChannelIndex,
-        const uint8_t fbPropertyIndex,
-        const char * payload
+#if WEB_SUPPORT && WS_SUPPORT
+    /**
+     * Nodes statistics, only part of module payload which changes during runtime
+     */
+    void _gatewayWSReportNodes(
+        JsonObject& module
+    ) {
+        // Statistics container
+        JsonArray& nodes = module.createNestedArray("nodes");
+
+        for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+            if (!gatewayIsNodeAllocated(i)) {
+                continue;
+            }
+
+            JsonObject& node = nodes.createNestedObject();
+
+            node["serial_number"] = gatewayGetNodeDetails(i).serial_number;
+            node["ready"] = gatewayIsNodeReady(i);
+
+            JsonObject& poll_interval = node.createNestedObject("poll_interval");
+
+            for (uint8_t j = 0; j < GATEWAY_REGISTER_MAX; j++) {
+                if (gatewayRegistersSize(i, j) > 0) {
+                    poll_interval[_gateway_registers_names[j]] = gatewaySchedulerGetPollInterval(i, j);
+                }
+            }
+        }
+    }
+
+// -----------------------------------------------------------------------------
+
+    // Send refreshed nodes statistics to WS clients
+    void _gatewayWSOnUpdate(
+        JsonObject& root
     ) {
-        // TODO: implement it
+        JsonArray& modules = root.containsKey("modules") ? root["modules"] : root.createNestedArray("modules");
+        JsonObject& module = modules.createNestedObject();
+
+        module["module"] = "gateway";
+
+        _gatewayWSReportNodes(module);
     }
 
 // -----------------------------------------------------------------------------
 
-    void _gatewayModulesFastyBirdDiRegisterChannelProperyQuery(
-        const uint8_t fbNodeIndex,
-        const uint8_t fbChannelIndex,
-        const uint8_t fbPropertyIndex
+    // New WS client is connected
+    void _gatewayWSOnConnect(
+        JsonObject& root
     ) {
-        fastybird_node_t fb_node = fastybirdNodesGetNode(fbNodeIndex);
+        JsonArray& modules = root.containsKey("modules") ? root["modules"] : root.createNestedArray("modules");
+        JsonObject& module = modules.createNestedObject();
 
-        char stored_sn[15] = GATEWAY_DESCRIPTION_NOT_SET;
+        module["module"] = "gateway";
+        module["visible"] = true;
 
-        for (uint8_t node_index = 0; node_index < FB_GATEWAY_MAX_NODES; node_index++) {
-            gatewayGetSerialNumber(node_index, stored_sn);
+        _gatewayWSReportNodes(module);
 
-            // At first, find gateway node by node serial number
-            if (strcmp(stored_sn, fb_node.id) == 0) {
-                for (uint8_t address = 0; address < fb_node.channels.size(); address++) {
-                    // Transform channel index to gateway node register address
-                    if (fb_node.channels[address] == fbChannelIndex) {
-                        String value;
+        // Configuration container
+        JsonObject& configuration = module.createNestedObject("config");
 
-                        switch (_gatewayRegistersGetRegisterDataType(node_index, GATEWAY_REGISTER_DI, address))
-                        {
-                            case GATEWAY_DATA_TYPE_BOOL:
-                                bool bool_stored_value;
+        // Configuration values container
+        JsonObject& configuration_values = configuration.createNestedObject("values");
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_DI, address, bool_stored_value);
+        _gatewayModulesReportConfiguration(configuration_values);
 
-                                value = bool_stored_value ? FASTYBIRD_SWITCH_PAYLOAD_ON : FASTYBIRD_SWITCH_PAYLOAD_OFF;
-                                break;
+        // Configuration schema container
+        JsonArray& configuration_schema = configuration.createNestedArray("schema");
 
-                            default:
-                                DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Provided unknown data type for reading from register\n"));
+        _gatewayModulesReportConfigurationSchema(configuration_schema);
+    }
 
-                                return;
-                        }
+// -----------------------------------------------------------------------------
 
-                        _gatewayModulesFastyBirdReportRegisterValue(
-                            node_index,
-                            GATEWAY_REGISTER_DI,
-                            address,
-                            value
-                        );
-                    }
+    // WS client requested configuration update
+    void _gatewayWSOnConfigure(
+        const uint32_t clientId,
+        JsonObject& module
+    ) {
+        if (module.containsKey("module") && module["module"] == "gateway") {
+            if (module.containsKey("config")) {
+                // Extract configuration container
+                JsonObject& configuration = module["config"].as<JsonObject&>();
+
+                if (
+                    configuration.containsKey("values")
+                    && _gatewayModulesUpdateConfiguration(configuration["values"])
+                ) {
+                    wsSend_P(clientId, PSTR("{\"message\": \"gateway_updated\"}"));
                 }
             }
-
-            strcpy(stored_sn, GATEWAY_DESCRIPTION_NOT_SET);
         }
     }
+#endif
 
 // -----------------------------------------------------------------------------
 
-    void _gatewayModulesFastyBirdDoRegisterChannelProperyQuery(
-        const uint8_t fbNodeIndex,
-        const uint8_t fbChannelIndex,
-        const uint8_t fbPropertyIndex
-    ) {
-        fastybird_node_t fb_node = fastybirdNodesGetNode(fbNodeIndex);
+void _gatewayModulesOnHeartbeat()
+{
+    #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
+        char poll_intervals[50];
 
-        char stored_sn[15] = GATEWAY_DESCRIPTION_NOT_SET;
+        for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+            if (!gatewayIsNodeAllocated(i) || !gatewayIsNodeReady(i)) {
+                continue;
+            }
 
-        for (uint8_t node_index = 0; node_index < FB_GATEWAY_MAX_NODES; node_index++) {
-            gatewayGetSerialNumber(node_index, stored_sn);
+            _gatewayModulesFormatPollIntervals(i, poll_intervals, sizeof(poll_intervals));
 
-            // At first, find gateway node by node serial number
-            if (strcmp(stored_sn, fb_node.id) == 0) {
-                for (uint8_t address = 0; address < fb_node.channels.size(); address++) {
-                    // Transform channel index to gateway node register address
-                    if (fb_node.channels[address] == fbChannelIndex) {
-                        String value;
+            fastybirdApiPropagateDevicePropertyValue(
+                gatewayGetNodeDetails(i).serial_number,
+                FASTYBIRD_PROPERTY_POLL_INTERVAL,
+                poll_intervals
+            );
+        }
+    #endif
 
-                        switch (_gatewayRegistersGetRegisterDataType(node_index, GATEWAY_REGISTER_DO, address))
-                        {
-                            case GATEWAY_DATA_TYPE_BOOL:
-                                bool bool_stored_value;
+    #if WEB_SUPPORT && WS_SUPPORT
+        if (wsConnected()) {
+            wsSend(_gatewayWSOnUpdate);
+        }
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+
+#if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
+    String _gatewayModulesCreateFastyBirdChannelName(
+        String channelPrefix,
+        uint8_t index
+    ) {
+        // Create channel name with replacable suffix: somechannel-%d
+        char channel_with_suffix[channelPrefix.length() + 5];
+        strcpy(channel_with_suffix, channelPrefix.c_str());
+        strcat(channel_with_suffix, FASTYBIRD_CHANNEL_ARRAY_SUFFIX);
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_DO, address, bool_stored_value);
+        char channel_name[strlen(channel_with_suffix) + 5];
+        sprintf(channel_name, channel_with_suffix, index);
 
-                                value = bool_stored_value ? FASTYBIRD_SWITCH_PAYLOAD_ON : FASTYBIRD_SWITCH_PAYLOAD_OFF;
-                                break;
+        return String(channel_name);
+    }
 
-                            default:
-                                DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Provided unknown data type for reading from register\n"));
+// -----------------------------------------------------------------------------
 
-                                return;
-                        }
+    /**
+     * Channel property which is carrying registers values of given registers space
+     */
+    uint8_t _gatewayModulesFastyBirdStatePropertyIndex(
+        const uint8_t dataRegister
+    ) {
+        switch (dataRegister)
+        {
+            case GATEWAY_REGISTER_DI:
+                return _gateway_di_register_channel_property_index;
 
-                        _gatewayModulesFastyBirdReportRegisterValue(
-                            node_index,
-                            GATEWAY_REGISTER_DO,
-                            address,
-                            value
-                        );
-                    }
-                }
-            }
+            case GATEWAY_REGISTER_DO:
+                return _gateway_do_register_channel_property_index;
 
-            strcpy(stored_sn, GATEWAY_DESCRIPTION_NOT_SET);
+            case GATEWAY_REGISTER_AI:
+                return _gateway_ai_register_channel_property_index;
+
+            case GATEWAY_REGISTER_AO:
+                return _gateway_ao_register_channel_property_index;
+
+            case GATEWAY_REGISTER_EV:
+                return _gateway_ev_register_channel_property_index;
         }
+
+        return INDEX_NONE;
     }
 
 // -----------------------------------------------------------------------------
 
-    void _gatewayModulesFastyBirdAiRegisterChannelProperyQuery(
-        const uint8_t fbNodeIndex,
-        const uint8_t fbChannelIndex,
-        const uint8_t fbPropertyIndex
+    /**
+     * Release registers to channels mapping of gateway node
+     */
+    void _gatewayModulesFastyBirdResetMapping(
+        const uint8_t nodeIndex
     ) {
-        fastybird_node_t fb_node = fastybirdNodesGetNode(fbNodeIndex);
-
-        char stored_sn[15] = GATEWAY_DESCRIPTION_NOT_SET;
+        // Free slots share empty details placeholder which is never mapped
+        if (!gatewayIsNodeAllocated(nodeIndex)) {
+            return;
+        }
 
-        for (uint8_t node_index = 0; node_index < FB_GATEWAY_MAX_NODES; node_index++) {
-            gatewayGetSerialNumber(node_index, stored_sn);
+        gateway_fastybird_mapping_t & mapping = _gateway_nodes_details[nodeIndex]->fastybird;
 
-            // At first, find gateway node by node serial number
-            if (strcmp(stored_sn, fb_node.id) == 0) {
-                for (uint8_t address = 0; address < fb_node.channels.size(); address++) {
-                    // Transform channel index to gateway node register address
-                    if (fb_node.channels[address] == fbChannelIndex) {
-                        String value;
+        if (mapping.channels != NULL) {
+            delete[] mapping.channels;
 
-                        switch (_gatewayRegistersGetRegisterDataType(node_index, GATEWAY_REGISTER_AI, address))
-                        {
-                            case GATEWAY_DATA_TYPE_UINT8:
-                                uint8_t uint8_stored_value;
+            mapping.channels = NULL;
+        }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AI, address, uint8_stored_value);
+        if (mapping.node != INDEX_NONE && _gateway_fastybird_nodes_map[mapping.node] == nodeIndex) {
+            _gateway_fastybird_nodes_map[mapping.node] = INDEX_NONE;
+        }
 
-                                value = String(uint8_stored_value);
-                                break;
+        mapping.node = INDEX_NONE;
 
-                            case GATEWAY_DATA_TYPE_UINT16:
-                                uint16_t uint16_stored_value;
+        for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+            mapping.size[i] = 0;
+            mapping.offset[i] = 0;
+        }
+    }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AI, address, uint16_stored_value);
+// -----------------------------------------------------------------------------
 
-                                value = String(uint16_stored_value);
-                                break;
+    /**
+     * FastyBird channel mapped to gateway node register, INDEX_NONE when register is not mapped
+     */
+    uint8_t _gatewayModulesFastyBirdGetMappedChannel(
+        const uint8_t nodeIndex,
+        const uint8_t dataRegister,
+        const uint8_t address
+    ) {
+        const gateway_fastybird_mapping_t & mapping = _gateway_nodes_details[nodeIndex]->fastybird;
 
-                            case GATEWAY_DATA_TYPE_UINT32:
-                                uint32_t uint32_stored_value;
+        if (mapping.channels == NULL || address >= mapping.size[dataRegister]) {
+            return INDEX_NONE;
+        }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AI, address, uint32_stored_value);
+        return mapping.channels[mapping.offset[dataRegister] + address];
+    }
 
-                                value = String(uint32_stored_value);
-                                break;
+// -----------------------------------------------------------------------------
 
-                            case GATEWAY_DATA_TYPE_INT8:
-                                int8_t int8_stored_value;
+    void _gatewayModulesFastyBirdReportRegisterProperty(
+        const uint8_t nodeIndex,
+        const uint8_t dataRegister,
+        const uint8_t address,
+        const uint8_t fbPropertyIndex,
+        const char * payload
+    ) {
+        // Validate node index & register type index
+        if (nodeIndex >= FB_GATEWAY_MAX_NODES || dataRegister >= GATEWAY_REGISTER_MAX) {
+            return;
+        }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AI, address, int8_stored_value);
+        uint8_t fb_channel_index = _gatewayModulesFastyBirdGetMappedChannel(nodeIndex, dataRegister, address);
 
-                                value = String(int8_stored_value);
-                                break;
+        if (fb_channel_index == INDEX_NONE) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Channel for register: %d was not found\n"), address);
 
-                            case GATEWAY_DATA_TYPE_INT16:
-                                int16_t int16_stored_value;
+            return;
+        }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AI, address, int16_stored_value);
+        fastybirdNodesReportChannelPropertyValue(
+            _gateway_nodes_details[nodeIndex]->fastybird.node,
+            fb_channel_index,
+            fbPropertyIndex,
+            payload
+        );
+    }
 
-                                value = String(int16_stored_value);
-                                break;
+// -----------------------------------------------------------------------------
 
-                            case GATEWAY_DATA_TYPE_INT32:
-                                int32_t int32_stored_value;
+    void _gatewayModulesFastyBirdReportRegisterValue(
+        const uint8_t nodeIndex,
+        const uint8_t dataRegister,
+        const uint8_t address,
+        const char * payload
+    ) {
+        _gatewayModulesFastyBirdReportRegisterProperty(nodeIndex, dataRegister, address, _gatewayModulesFastyBirdStatePropertyIndex(dataRegister), payload);
+    }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AI, address, int32_stored_value);
+// -----------------------------------------------------------------------------
 
-                                value = String(int32_stored_value);
-                                break;
+    /**
+     * Event time is published before event code, so subscriber could pair them
+     */
+    void _gatewayModulesFastyBirdReportRegisterEvent(
+        const uint8_t nodeIndex,
+        const uint8_t address,
+        const char * payload,
+        const uint32_t timestamp
+    ) {
+        char timestamp_payload[11];
 
-                            case GATEWAY_DATA_TYPE_FLOAT32:
-                                float float_stored_value;
+        ultoa(timestamp, timestamp_payload, 10);
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AI, address, float_stored_value);
+        _gatewayModulesFastyBirdReportRegisterProperty(nodeIndex, GATEWAY_REGISTER_EV, address, _gateway_ev_register_channel_timestamp_index, timestamp_payload);
+        _gatewayModulesFastyBirdReportRegisterProperty(nodeIndex, GATEWAY_REGISTER_EV, address, _gateway_ev_register_channel_property_index, payload);
+    }
 
-                                value = String(float_stored_value);
-                                break;
+// -----------------------------------------------------------------------------
 
-                            default:
-                                DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Provided unknown data type for writing into register\n"));
+    /**
+     * Find gateway node which is represented by FastyBird node
+     */
+    uint8_t _gatewayModulesFastyBirdFindGatewayNode(
+        const uint8_t fbNodeIndex
+    ) {
+        if (fbNodeIndex >= INDEX_NONE) {
+            return INDEX_NONE;
+        }
 
-                                return;
-                        }
-                        
-                        _gatewayModulesFastyBirdReportRegisterValue(
-                            node_index,
-                            GATEWAY_REGISTER_AI,
-                            address,
-                            value
-                        );
-                    }
-                }
-            }
+        uint8_t node_index = _gateway_fastybird_nodes_map[fbNodeIndex];
 
-            strcpy(stored_sn, GATEWAY_DESCRIPTION_NOT_SET);
+        // Slot could be released or reused by other node in the meantime
+        if (!gatewayIsNodeAllocated(node_index) || _gateway_nodes_details[node_index]->fastybird.node != fbNodeIndex) {
+            return INDEX_NONE;
         }
+
+        return node_index;
     }
 
 // -----------------------------------------------------------------------------
 
-    void _gatewayModulesFastyBirdAoRegisterChannelProperyQuery(
-        const uint8_t fbNodeIndex,
-        const uint8_t fbChannelIndex,
-        const uint8_t fbPropertyIndex
+    /**
+     * Transform channel index to register address of given registers space
+     */
+    uint8_t _gatewayModulesFastyBirdFindRegisterAddress(
+        const uint8_t nodeIndex,
+        const uint8_t dataRegister,
+        const uint8_t fbChannelIndex
     ) {
-        fastybird_node_t fb_node = fastybirdNodesGetNode(fbNodeIndex);
+        const gateway_fastybird_mapping_t & mapping = _gateway_nodes_details[nodeIndex]->fastybird;
 
-        char stored_sn[15] = GATEWAY_DESCRIPTION_NOT_SET;
+        if (mapping.channels == NULL) {
+            return INDEX_NONE;
+        }
 
-        for (uint8_t node_index = 0; node_index < FB_GATEWAY_MAX_NODES; node_index++) {
-            gatewayGetSerialNumber(node_index, stored_sn);
+        for (uint8_t address = 0; address < mapping.size[dataRegister]; address++) {
+            if (mapping.channels[mapping.offset[dataRegister] + address] == fbChannelIndex) {
+                return address;
+            }
+        }
 
-            // At first, find gateway node by node serial number
-            if (strcmp(stored_sn, fb_node.id) == 0) {
-                for (uint8_t address = 0; address < fb_node.channels.size(); address++) {
-                    // Transform channel index to gateway node register address
-                    if (fb_node.channels[address] == fbChannelIndex) {
-                        String value;
+        return INDEX_NONE;
+    }
 
-                        switch (_gatewayRegistersGetRegisterDataType(node_index, GATEWAY_REGISTER_AO, address))
-                        {
-                            case GATEWAY_DATA_TYPE_UINT8:
-                                uint8_t uint8_stored_value;
+// -----------------------------------------------------------------------------
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AO, address, uint8_stored_value);
+    /**
+     * Value is queued for writing, it is reported back when node confirm it
+     */
+    void _gatewayModulesFastyBirdRegisterChannelProperyPayload(
+        const uint8_t fbNodeIndex,
+        const uint8_t fbChannelIndex,
+        const uint8_t dataRegister,
+        const char * payload
+    ) {
+        uint8_t node_index = _gatewayModulesFastyBirdFindGatewayNode(fbNodeIndex);
 
-                                value = String(uint8_stored_value);
-                                break;
+        if (node_index == INDEX_NONE) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Node was not found\n"));
 
-                            case GATEWAY_DATA_TYPE_UINT16:
-                                uint16_t uint16_stored_value;
+            return;
+        }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AO, address, uint16_stored_value);
+        uint8_t address = _gatewayModulesFastyBirdFindRegisterAddress(node_index, dataRegister, fbChannelIndex);
 
-                                value = String(uint16_stored_value);
-                                break;
+        if (address == INDEX_NONE) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Channel for node was not found\n"));
 
-                            case GATEWAY_DATA_TYPE_UINT32:
-                                uint32_t uint32_stored_value;
+            return;
+        }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AO, address, uint32_stored_value);
+        if (!gatewayRegistersWrite(node_index, dataRegister, address, payload)) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Value: %s could not be written into register: %d\n"), payload, address);
+        }
+    }
 
-                                value = String(uint32_stored_value);
-                                break;
+// -----------------------------------------------------------------------------
 
-                            case GATEWAY_DATA_TYPE_INT8:
-                                int8_t int8_stored_value;
+    void _gatewayModulesFastyBirdDoRegisterChannelProperyPayload(
+        const uint8_t fbNodeIndex,
+        const uint8_t fbChannelIndex,
+        const uint8_t fbPropertyIndex,
+        const char * payload
+    ) {
+        _gatewayModulesFastyBirdRegisterChannelProperyPayload(fbNodeIndex, fbChannelIndex, GATEWAY_REGISTER_DO, payload);
+    }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AO, address, int8_stored_value);
+// -----------------------------------------------------------------------------
 
-                                value = String(int8_stored_value);
-                                break;
+    void _gatewayModulesFastyBirdAoRegisterChannelProperyPayload(
+        const uint8_t fbNodeIndex,
+        const uint8_t fbChannelIndex,
+        const uint8_t fbPropertyIndex,
+        const char * payload
+    ) {
+        _gatewayModulesFastyBirdRegisterChannelProperyPayload(fbNodeIndex, fbChannelIndex, GATEWAY_REGISTER_AO, payload);
+    }
 
-                            case GATEWAY_DATA_TYPE_INT16:
-                                int16_t int16_stored_value;
+// -----------------------------------------------------------------------------
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AO, address, int16_stored_value);
+    void _gatewayModulesFastyBirdRegisterChannelProperyQuery(
+        const uint8_t fbNodeIndex,
+        const uint8_t fbChannelIndex,
+        const uint8_t dataRegister
+    ) {
+        char value[GATEWAY_REGISTER_VALUE_FORMAT_LENGTH];
 
-                                value = String(int16_stored_value);
-                                break;
+        uint8_t node_index = _gatewayModulesFastyBirdFindGatewayNode(fbNodeIndex);
 
-                            case GATEWAY_DATA_TYPE_INT32:
-                                int32_t int32_stored_value;
+        if (node_index == INDEX_NONE) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Node was not found\n"));
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AO, address, int32_stored_value);
+            return;
+        }
 
-                                value = String(int32_stored_value);
-                                break;
+        // Transform channel index to gateway node register address
+        uint8_t address = _gatewayModulesFastyBirdFindRegisterAddress(node_index, dataRegister, fbChannelIndex);
 
-                            case GATEWAY_DATA_TYPE_FLOAT32:
-                                float float_stored_value;
+        if (address == INDEX_NONE) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Channel for node was not found\n"));
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_AO, address, float_stored_value);
+            return;
+        }
 
-                                value = String(float_stored_value);
-                                break;
+        if (!gatewayRegistersFormatValue(node_index, dataRegister, address, value)) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Provided unknown data type for reading from register\n"));
 
-                            default:
-                                DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Provided unknown data type for writing into register\n"));
+            return;
+        }
 
-                                return;
-                        }
-                        
-                        _gatewayModulesFastyBirdReportRegisterValue(
-                            node_index,
-                            GATEWAY_REGISTER_AO,
-                            address,
-                            value
-                        );
-                    }
-                }
-            }
+        _gatewayModulesFastyBirdReportRegisterValue(
+            node_index,
+            dataRegister,
+            address,
+            value
+        );
 
-            strcpy(stored_sn, GATEWAY_DESCRIPTION_NOT_SET);
-        }
+        // Stored value is refreshed out of polling order, changes are reported when read
+        gatewaySchedulerQueryRegister(node_index, dataRegister);
     }
 
 // -----------------------------------------------------------------------------
 
-    void _gatewayModulesFastyBirdEvRegisterChannelProperyQuery(
+    void _gatewayModulesFastyBirdDiRegisterChannelProperyQuery(
         const uint8_t fbNodeIndex,
         const uint8_t fbChannelIndex,
         const uint8_t fbPropertyIndex
     ) {
-        fastybird_node_t fb_node = fastybirdNodesGetNode(fbNodeIndex);
-
-        char stored_sn[15] = GATEWAY_DESCRIPTION_NOT_SET;
-
-        for (uint8_t node_index = 0; node_index < FB_GATEWAY_MAX_NODES; node_index++) {
-            gatewayGetSerialNumber(node_index, stored_sn);
+        _gatewayModulesFastyBirdRegisterChannelProperyQuery(fbNodeIndex, fbChannelIndex, GATEWAY_REGISTER_DI);
+    }
 
-            // At first, find gateway node by node serial number
-            if (strcmp(stored_sn, fb_node.id) == 0) {
-                for (uint8_t address = 0; address < fb_node.channels.size(); address++) {
-                    // Transform channel index to gateway node register address
-                    if (fb_node.channels[address] == fbChannelIndex) {
-                        String value;
+// -----------------------------------------------------------------------------
 
-                        switch (_gatewayRegistersGetRegisterDataType(node_index, GATEWAY_REGISTER_EV, address))
-                        {
-                            case GATEWAY_DATA_TYPE_UINT8:
-                                uint8_t uint8_stored_value;
+    void _gatewayModulesFastyBirdDoRegisterChannelProperyQuery(
+        const uint8_t fbNodeIndex,
+        const uint8_t fbChannelIndex,
+        const uint8_t fbPropertyIndex
+    ) {
+        _gatewayModulesFastyBirdRegisterChannelProperyQuery(fbNodeIndex, fbChannelIndex, GATEWAY_REGISTER_DO);
+    }
 
-                                gatewayRegistersReadValue(node_index, GATEWAY_REGISTER_EV, address, uint8_stored_value);
+// -----------------------------------------------------------------------------
 
-                                value = String(uint8_stored_value);
-                                break;
+    void _gatewayModulesFastyBirdAiRegisterChannelProperyQuery(
+        const uint8_t fbNodeIndex,
+        const uint8_t fbChannelIndex,
+        const uint8_t fbPropertyIndex
+    ) {
+        _gatewayModulesFastyBirdRegisterChannelProperyQuery(fbNodeIndex, fbChannelIndex, GATEWAY_REGISTER_AI);
+    }
 
-                            default:
-                                DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Provided unknown data type for writing into register\n"));
+// -----------------------------------------------------------------------------
 
-                                return;
-                        }
+    void _gatewayModulesFastyBirdAoRegisterChannelProperyQuery(
+        const uint8_t fbNodeIndex,
+        const uint8_t fbChannelIndex,
+        const uint8_t fbPropertyIndex
+    ) {
+        _gatewayModulesFastyBirdRegisterChannelProperyQuery(fbNodeIndex, fbChannelIndex, GATEWAY_REGISTER_AO);
+    }
 
-                        _gatewayModulesFastyBirdReportRegisterValue(
-                            node_index,
-                            GATEWAY_REGISTER_EV,
-                            address,
-                            value
-                        );
-                    }
-                }
-            }
+// -----------------------------------------------------------------------------
 
-            strcpy(stored_sn, GATEWAY_DESCRIPTION_NOT_SET);
-        }
+    void _gatewayModulesFastyBirdEvRegisterChannelProperyQuery(
+        const uint8_t fbNodeIndex,
+        const uint8_t fbChannelIndex,
+        const uint8_t fbPropertyIndex
+    ) {
+        _gatewayModulesFastyBirdRegisterChannelProperyQuery(fbNodeIndex, fbChannelIndex, GATEWAY_REGISTER_EV);
     }
 
 // -----------------------------------------------------------------------------
@@ -523,7 +883,7 @@ uint8_t _gateway_ev_register_channel_property_index = INDEX_NONE;
             FASTYBIRD_PROPERTY_STATE,
             FASTYBIRD_PROPERTY_DATA_TYPE_ENUM,
             "",
-            di_format,
+            do_format,
             _gatewayModulesFastyBirdDoRegisterChannelProperyPayload,
             _gatewayModulesFastyBirdDoRegisterChannelProperyQuery
         );
@@ -564,6 +924,14 @@ uint8_t _gateway_ev_register_channel_property_index = INDEX_NONE;
             "",
             _gatewayModulesFastyBirdEvRegisterChannelProperyQuery
         );
+
+        // Register events time property to collection
+        _gateway_ev_register_channel_timestamp_index = fastybirdNodesRegisterNodeProperty(
+            FASTYBIRD_PROPERTY_TIMESTAMP,
+            FASTYBIRD_PROPERTY_DATA_TYPE_INTEGER,
+            "ms",
+            ""
+        );
     }
 
 // -----------------------------------------------------------------------------
@@ -571,8 +939,6 @@ uint8_t _gateway_ev_register_channel_property_index = INDEX_NONE;
     void _gatewayModulesInitializeFastyBirdNode(
         const uint8_t nodeIndex
     ) {
-        gateway_node_t gatewayNode = gatewayGetNode(nodeIndex);
-
         char stored_sn[15] = GATEWAY_DESCRIPTION_NOT_SET;
 
         char hw_manufacturer[20] = GATEWAY_DESCRIPTION_NOT_SET;
@@ -601,78 +967,66 @@ uint8_t _gateway_ev_register_channel_property_index = INDEX_NONE;
             fw_model,
             fw_version,
             fw_manufacturer,
-            gatewayNode.ready
+            gatewayIsNodeReady(nodeIndex)
         );
 
-        uint8_t fb_channel_index = INDEX_NONE;
-
-        // DI registers channel
-        if (gatewayRegistersDigitalInputsSize(nodeIndex) > 0) {
-            for (uint8_t i = 0; i < gatewayRegistersDigitalInputsSize(nodeIndex); i++) {
-                // Register channel to collection
-                fb_channel_index = fastybirdNodesRegisterNodeChannel(
-                    _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_BINARY_SENSOR, (i + 1)).c_str()
-                );
+        // Release previous mapping, channels are mapped again by actual registers structure
+        _gatewayModulesFastyBirdResetMapping(nodeIndex);
 
-                // Mapp all together
-                fastybirdNodesMapChannelToNode(fb_node_index, fb_channel_index);
-                fastybirdNodesMapPropertyToChannel(fb_channel_index, _gateway_di_register_channel_property_index);
-            }
+        if (!gatewayIsNodeAllocated(nodeIndex)) {
+            return;
         }
 
-        // DO registers channel
-        if (gatewayRegistersDigitalOutputsSize(nodeIndex) > 0) {
-            for (uint8_t i = 0; i < gatewayRegistersDigitalOutputsSize(nodeIndex); i++) {
-                // Register channel to collection
-                fb_channel_index = fastybirdNodesRegisterNodeChannel(
-                    _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_BINARY_ACTOR, (i + 1)).c_str()
-                );
+        gateway_fastybird_mapping_t & mapping = _gateway_nodes_details[nodeIndex]->fastybird;
 
-                // Mapp all together
-                fastybirdNodesMapChannelToNode(fb_node_index, fb_channel_index);
-                fastybirdNodesMapPropertyToChannel(fb_channel_index, _gateway_do_register_channel_property_index);
-            }
-        }
+        uint16_t length = 0;
 
-        // AI registers channel
-        if (gatewayRegistersAnalogInputsSize(nodeIndex) > 0) {
-            for (uint8_t i = 0; i < gatewayRegistersAnalogInputsSize(nodeIndex); i++) {
-                // Register channel to collection
-                fb_channel_index = fastybirdNodesRegisterNodeChannel(
-                    _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_ANALOG_SENSOR, (i + 1)).c_str()
-                );
+        for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+            mapping.size[i] = gatewayRegistersSize(nodeIndex, i);
+            mapping.offset[i] = length;
 
-                // Mapp all together
-                fastybirdNodesMapChannelToNode(fb_node_index, fb_channel_index);
-                fastybirdNodesMapPropertyToChannel(fb_channel_index, _gateway_ai_register_channel_property_index);
-            }
+            length = length + mapping.size[i];
         }
 
-        // AO registers channel
-        if (gatewayRegistersAnalogOutputsSize(nodeIndex) > 0) {
-            for (uint8_t i = 0; i < gatewayRegistersAnalogOutputsSize(nodeIndex); i++) {
-                // Register channel to collection
-                fb_channel_index = fastybirdNodesRegisterNodeChannel(
-                    _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_ANALOG_ACTOR, (i + 1)).c_str()
-                );
+        if (fb_node_index == INDEX_NONE || length == 0) {
+            return;
+        }
 
-                // Mapp all together
-                fastybirdNodesMapChannelToNode(fb_node_index, fb_channel_index);
-                fastybirdNodesMapPropertyToChannel(fb_channel_index, _gateway_ao_register_channel_property_index);
-            }
+        mapping.channels = new uint8_t[length];
+
+        if (mapping.channels == NULL) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][MODULES] Not enough memory for node channels mapping\n"));
+
+            _gatewayModulesFastyBirdResetMapping(nodeIndex);
+
+            return;
         }
 
-        // EV register channel
-        if (gatewayRegistersEventInputsSize(nodeIndex) > 0) {
-            for (uint8_t i = 0; i < gatewayRegistersEventInputsSize(nodeIndex); i++) {
-                // Register channel to collection
-                fb_channel_index = fastybirdNodesRegisterNodeChannel(
-                    _gatewayModulesCreateFastyBirdChannelName(FASTYBIRD_CHANNEL_EVENT, (i + 1)).c_str()
-                );
+        mapping.node = fb_node_index;
+
+        _gateway_fastybird_nodes_map[fb_node_index] = nodeIndex;
+
+        for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+            for (uint8_t address = 0; address < mapping.size[i]; address++) {
+                String channel_name = _gatewayModulesCreateFastyBirdChannelName(_gateway_fastybird_channels_prefixes[i], (address + 1));
+
+                // Channels of reinitialized node are reused
+                uint8_t fb_channel_index = fastybirdNodesFindChannelIndex(fb_node_index, channel_name);
+
+                if (fb_channel_index == INDEX_NONE) {
+                    // Register channel to collection
+                    fb_channel_index = fastybirdNodesRegisterNodeChannel(channel_name.c_str());
+                }
 
                 // Mapp all together
                 fastybirdNodesMapChannelToNode(fb_node_index, fb_channel_index);
-                fastybirdNodesMapPropertyToChannel(fb_channel_index, _gateway_ev_register_channel_property_index);
+                fastybirdNodesMapPropertyToChannel(fb_channel_index, _gatewayModulesFastyBirdStatePropertyIndex(i));
+
+                if (i == GATEWAY_REGISTER_EV) {
+                    fastybirdNodesMapPropertyToChannel(fb_channel_index, _gateway_ev_register_channel_timestamp_index);
+                }
+
+                mapping.channels[mapping.offset[i] + address] = fb_channel_index;
             }
         }
     }
@@ -814,13 +1168,28 @@ void gatewayModulesNodeInitialized(
 
 // -----------------------------------------------------------------------------
 
+void gatewayModulesNodeReset(
+    const uint8_t nodeIndex
+) {
+    #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
+        // Validate node index
+        if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+            return;
+        }
+
+        _gatewayModulesFastyBirdResetMapping(nodeIndex);
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+
 void gatewayModulesNodeIsLost(
     const uint8_t nodeIndex
 ) {
     #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        gateway_node_t gateway_node = gatewayGetNode(nodeIndex);
+        const gateway_node_details_t & gateway_node = gatewayGetNodeDetails(nodeIndex);
 
-        uint8_t fb_node_index = fastybirdNodesFindNodeIndex(String(gateway_node.serial_number));
+        uint8_t fb_node_index = fastybirdNodesFindNodeIndex(gateway_node.serial_number);
 
         if (fb_node_index != INDEX_NONE) {
             fastybirdNodesNodeIsLost(fb_node_index);
@@ -842,9 +1211,9 @@ void gatewayModulesNodeIsReady(
     const uint8_t nodeIndex
 ) {
     #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        gateway_node_t gateway_node = gatewayGetNode(nodeIndex);
+        const gateway_node_details_t & gateway_node = gatewayGetNodeDetails(nodeIndex);
 
-        uint8_t fb_node_index = fastybirdNodesFindNodeIndex(String(gateway_node.serial_number));
+        uint8_t fb_node_index = fastybirdNodesFindNodeIndex(gateway_node.serial_number);
 
         if (fb_node_index != INDEX_NONE) {
             fastybirdNodesNodeIsReady(fb_node_index);
@@ -861,140 +1230,35 @@ void gatewayModulesRegisterValueUpdated(
     const uint8_t nodeIndex,
     const uint8_t dataRegister,
     const uint8_t address,
-    const bool payload
-) {
-    #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        _gatewayModulesFastyBirdReportRegisterValue(
-            nodeIndex,
-            dataRegister,
-            address,
-            payload ? FASTYBIRD_SWITCH_PAYLOAD_ON : FASTYBIRD_SWITCH_PAYLOAD_OFF
-        );
-    #endif
-}
-
-// -----------------------------------------------------------------------------
-
-void gatewayModulesRegisterValueUpdated(
-    const uint8_t nodeIndex,
-    const uint8_t dataRegister,
-    const uint8_t address,
-    const uint8_t payload
-) {
-    #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        _gatewayModulesFastyBirdReportRegisterValue(
-            nodeIndex,
-            dataRegister,
-            address,
-            String(payload)
-        );
-    #endif
-}
-
-// -----------------------------------------------------------------------------
-
-void gatewayModulesRegisterValueUpdated(
-    const uint8_t nodeIndex,
-    const uint8_t dataRegister,
-    const uint8_t address,
-    const uint16_t payload
-) {
-    #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        _gatewayModulesFastyBirdReportRegisterValue(
-            nodeIndex,
-            dataRegister,
-            address,
-            String(payload)
-        );
-    #endif
-}
-
-// -----------------------------------------------------------------------------
-
-void gatewayModulesRegisterValueUpdated(
-    const uint8_t nodeIndex,
-    const uint8_t dataRegister,
-    const uint8_t address,
-    const uint32_t payload
+    const char * payload
 ) {
     #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
         _gatewayModulesFastyBirdReportRegisterValue(
             nodeIndex,
             dataRegister,
             address,
-            String(payload)
+            payload
         );
     #endif
 }
 
 // -----------------------------------------------------------------------------
 
-void gatewayModulesRegisterValueUpdated(
-    const uint8_t nodeIndex,
-    const uint8_t dataRegister,
-    const uint8_t address,
-    const int8_t payload
-) {
-    #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        _gatewayModulesFastyBirdReportRegisterValue(
-            nodeIndex,
-            dataRegister,
-            address,
-            String(payload)
-        );
-    #endif
-}
-
-// -----------------------------------------------------------------------------
-
-void gatewayModulesRegisterValueUpdated(
-    const uint8_t nodeIndex,
-    const uint8_t dataRegister,
-    const uint8_t address,
-    const int16_t payload
-) {
-    #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        _gatewayModulesFastyBirdReportRegisterValue(
-            nodeIndex,
-            dataRegister,
-            address,
-            String(payload)
-        );
-    #endif
-}
-
-// -----------------------------------------------------------------------------
-
-void gatewayModulesRegisterValueUpdated(
-    const uint8_t nodeIndex,
-    const uint8_t dataRegister,
-    const uint8_t address,
-    const int32_t payload
-) {
-    #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        _gatewayModulesFastyBirdReportRegisterValue(
-            nodeIndex,
-            dataRegister,
-            address,
-            String(payload)
-        );
-    #endif
-}
-
-// -----------------------------------------------------------------------------
-
-void gatewayModulesRegisterValueUpdated(
+/**
+ * Event drained from node events queue, timestamp is on gateway clock
+ */
+void gatewayModulesRegisterEventReceived(
     const uint8_t nodeIndex,
-    const uint8_t dataRegister,
     const uint8_t address,
-    const float payload
+    const char * payload,
+    const uint32_t timestamp
 ) {
     #if FASTYBIRD_SUPPORT && FASTYBIRD_NODES_SUPPORT
-        _gatewayModulesFastyBirdReportRegisterValue(
+        _gatewayModulesFastyBirdReportRegisterEvent(
             nodeIndex,
-            dataRegister,
             address,
-            String(payload)
+            payload,
+            timestamp
         );
     #endif
 }
@@ -1005,13 +1269,29 @@ void gatewayModulesRegisterValueUpdated(
 
 void gatewayModulesSetup()
 {
-    #if WEqwB_SUPPORT
+    #if WEB_SUPPORT
         webServer()->on(FB_GATEWAY_WEB_API_CONFIGURATION, HTTP_GET, _gatewayOnGetConfig);
         webServer()->on(FB_GATEWAY_WEB_API_CONFIGURATION, HTTP_POST, _gatewayOnPostConfig, _gatewayOnPostConfigData);
     #endif
 
+    _gatewayModulesLoadDeadbandsDefaults();
+
+    #if WEB_SUPPORT && WS_SUPPORT
+        wsOnConnectRegister(_gatewayWSOnConnect);
+        wsOnConfigureRegister(_gatewayWSOnConfigure);
+    #endif
+
+    systemOnHeartbeatRegister(_gatewayModulesOnHeartbeat);
+
     #if FASTYBIRD_SUPPORT
+        // Module schema report
+        fastybirdReportConfigurationSchemaRegister(_gatewayModulesReportConfigurationSchema);
+        fastybirdReportConfigurationRegister(_gatewayModulesReportConfiguration);
+        fastybirdOnConfigureRegister(_gatewayModulesUpdateConfiguration);
+
         #if FASTYBIRD_NODES_SUPPORT
+        memset(_gateway_fastybird_nodes_map, INDEX_NONE, sizeof(_gateway_fastybird_nodes_map));
+
         _gatewayModulesInitializeFastyBirdChannelProperties();
         #endif
 
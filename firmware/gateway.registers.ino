@@ -8,73 +8,77 @@ Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
 
 #if FB_GATEWAY_SUPPORT
 
-gateway_registers_t _gateway_nodes_registers[FB_GATEWAY_MAX_NODES];
-
-gateway_register_reading_t _gateway_nodes_registers_reading[FB_GATEWAY_MAX_NODES];
-
 // -----------------------------------------------------------------------------
 // MODULE: SUB-MODULE PRIVATE
 // -----------------------------------------------------------------------------
 
-bool _gatewayRegistersIsAddressCorrect(
-    const uint8_t nodeIndex,
-    const uint8_t dataRegister,
-    const uint8_t address
+uint8_t _gatewayRegistersDataTypeSize(
+    const uint8_t datatype
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return false;
+    switch (datatype)
+    {
+        case GATEWAY_DATA_TYPE_BOOL:
+        case GATEWAY_DATA_TYPE_UINT8:
+        case GATEWAY_DATA_TYPE_INT8:
+            return 1;
+
+        case GATEWAY_DATA_TYPE_UINT16:
+        case GATEWAY_DATA_TYPE_INT16:
+            return 2;
+
+        case GATEWAY_DATA_TYPE_UINT32:
+        case GATEWAY_DATA_TYPE_INT32:
+        case GATEWAY_DATA_TYPE_FLOAT32:
+            return 4;
     }
 
-    if (dataRegister == GATEWAY_REGISTER_DI) {
-        return (address < _gateway_nodes_registers[nodeIndex].digital_inputs.size());
+    return 0;
+}
 
-    } else if (dataRegister == GATEWAY_REGISTER_DO) {
-        return (address < _gateway_nodes_registers[nodeIndex].digital_outputs.size());
+// -----------------------------------------------------------------------------
 
-    } else if (dataRegister == GATEWAY_REGISTER_AI) {
-        return (address < _gateway_nodes_registers[nodeIndex].analog_inputs.size());
+/**
+ * Count of arena bytes needed for registers space of given size
+ */
+uint16_t _gatewayRegistersSpaceLength(
+    const uint8_t dataRegister,
+    const uint8_t size
+) {
+    switch (dataRegister)
+    {
+        case GATEWAY_REGISTER_DI:
+        case GATEWAY_REGISTER_DO:
+            return (size + 7) / 8;
 
-    } else if (dataRegister == GATEWAY_REGISTER_AO) {
-        return (address < _gateway_nodes_registers[nodeIndex].analog_outputs.size());
+        case GATEWAY_REGISTER_AI:
+        case GATEWAY_REGISTER_AO:
+            return (uint16_t) size * (1 + GATEWAY_REGISTER_ANALOG_VALUE_SIZE);
 
-    } else if (dataRegister == GATEWAY_REGISTER_EV) {
-        return (address < _gateway_nodes_registers[nodeIndex].event_inputs.size());
+        case GATEWAY_REGISTER_EV:
+            return size;
     }
 
-    return false;
+    return 0;
 }
 
 // -----------------------------------------------------------------------------
 
-bool _gatewayRegistersIsSizeCorrect(
+bool _gatewayRegistersIsAddressCorrect(
     const uint8_t nodeIndex,
     const uint8_t dataRegister,
-    const uint8_t address,
-    const uint8_t size
+    const uint8_t address
 ) {
     // Validate node index
     if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
         return false;
     }
 
-    if (dataRegister == GATEWAY_REGISTER_DI) {
-        return (_gateway_nodes_registers[nodeIndex].digital_inputs[address].size == size);
-
-    } else if (dataRegister == GATEWAY_REGISTER_DO) {
-        return (_gateway_nodes_registers[nodeIndex].digital_outputs[address].size == size);
-
-    } else if (dataRegister == GATEWAY_REGISTER_AI) {
-        return (_gateway_nodes_registers[nodeIndex].analog_inputs[address].size == size);
-
-    } else if (dataRegister == GATEWAY_REGISTER_AO) {
-        return (_gateway_nodes_registers[nodeIndex].analog_outputs[address].size == size);
-
-    } else if (dataRegister == GATEWAY_REGISTER_EV) {
-        return (_gateway_nodes_registers[nodeIndex].event_inputs[address].size == size);
+    // Validate register type index
+    if (dataRegister >= GATEWAY_REGISTER_MAX) {
+        return false;
     }
 
-    return false;
+    return (address < _gateway_nodes_details[nodeIndex]->registers.size[dataRegister]);
 }
 
 // -----------------------------------------------------------------------------
@@ -84,27 +88,22 @@ uint8_t _gatewayRegistersGetRegisterDataType(
     const uint8_t dataRegister,
     const uint8_t address
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    if (_gatewayRegistersIsAddressCorrect(nodeIndex, dataRegister, address) == false) {
         return GATEWAY_DATA_TYPE_UNKNOWN;
     }
 
     switch (dataRegister)
     {
         case GATEWAY_REGISTER_DI:
-            return _gateway_nodes_registers[nodeIndex].digital_inputs[address].datatype;
-
         case GATEWAY_REGISTER_DO:
-            return _gateway_nodes_registers[nodeIndex].digital_outputs[address].datatype;
+            return GATEWAY_DATA_TYPE_BOOL;
 
         case GATEWAY_REGISTER_AI:
-            return _gateway_nodes_registers[nodeIndex].analog_inputs[address].datatype;
-
         case GATEWAY_REGISTER_AO:
-            return _gateway_nodes_registers[nodeIndex].analog_outputs[address].datatype;
+            return _gateway_nodes_details[nodeIndex]->registers.arena[_gateway_nodes_details[nodeIndex]->registers.offset[dataRegister] + address];
 
         case GATEWAY_REGISTER_EV:
-            return _gateway_nodes_registers[nodeIndex].event_inputs[address].datatype;
+            return GATEWAY_DATA_TYPE_UINT8;
     }
 
     return GATEWAY_DATA_TYPE_UNKNOWN;
@@ -112,50 +111,51 @@ uint8_t _gatewayRegistersGetRegisterDataType(
 
 // -----------------------------------------------------------------------------
 
-void _gatewayRegistersUpdateReadingPointer(
+bool _gatewayRegistersIsSizeCorrect(
     const uint8_t nodeIndex,
-    const uint8_t dataRegister
+    const uint8_t dataRegister,
+    const uint8_t address,
+    const uint8_t size
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
+    return _gatewayRegistersDataTypeSize(_gatewayRegistersGetRegisterDataType(nodeIndex, dataRegister, address)) == size;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Position of analog or event register value in node arena
+ */
+uint8_t * _gatewayRegistersValuePointer(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address
+) {
+    gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
+
+    if (dataRegister == GATEWAY_REGISTER_EV) {
+        return registers.arena + registers.offset[dataRegister] + address;
     }
 
+    // Analog values are stored after space datatypes
+    return registers.arena + registers.offset[dataRegister] + registers.size[dataRegister] + (address * GATEWAY_REGISTER_ANALOG_VALUE_SIZE);
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewayRegistersUpdateReadingPointer(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister
+) {
     // Validate register type index
-    if (dataRegister >= 5) {
+    if (dataRegister >= GATEWAY_REGISTER_MAX) {
         return;
     }
 
-    if (
-        _gateway_nodes_registers_reading[nodeIndex].register_type == dataRegister
-        || _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_NONE
-    ) {
-        if (
-            (
-                dataRegister == GATEWAY_REGISTER_DI
-                && _gateway_nodes_registers[nodeIndex].digital_inputs.size() > 0
-            ) || (
-                dataRegister == GATEWAY_REGISTER_DO
-                && _gateway_nodes_registers[nodeIndex].digital_outputs.size() > 0
-            ) || (
-                dataRegister == GATEWAY_REGISTER_AI
-                && _gateway_nodes_registers[nodeIndex].analog_inputs.size() > 0
-            ) || (
-                dataRegister == GATEWAY_REGISTER_AO
-                && _gateway_nodes_registers[nodeIndex].analog_outputs.size() > 0
-            ) || (
-                dataRegister == GATEWAY_REGISTER_EV
-                && _gateway_nodes_registers[nodeIndex].event_inputs.size() > 0
-            )
-        ) {
-            _gateway_nodes_registers_reading[nodeIndex].register_type = dataRegister;
-            _gateway_nodes_registers_reading[nodeIndex].start = 0;
-
-            return;
-        }
-    }
+    // Whole registers space was requested, plan its next polling
+    gatewaySchedulerMarkRegisterPolled(nodeIndex, dataRegister);
 
-    _gateway_nodes_registers_reading[nodeIndex].register_type = GATEWAY_REGISTER_NONE;
+    _gateway_nodes_details[nodeIndex]->reading.register_type = GATEWAY_REGISTER_NONE;
+    _gateway_nodes_details[nodeIndex]->reading.start = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -169,44 +169,27 @@ bool _gatewayRegistersWriteValue(
     const void * value,
     const uint8_t size
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return false;
-    }
-
-    if (_gatewayRegistersIsAddressCorrect(nodeIndex, dataRegister, address) == false) {
+    if (_gatewayRegistersIsSizeCorrect(nodeIndex, dataRegister, address, size) == false) {
         return false;
     }
 
-    if (_gatewayRegistersIsSizeCorrect(nodeIndex, dataRegister, address, size)) {
-        if (dataRegister == GATEWAY_REGISTER_DI) {
-            memcpy(_gateway_nodes_registers[nodeIndex].digital_inputs[address].value, value, size);
-
-            return true;
-
-        } else if (dataRegister == GATEWAY_REGISTER_DO) {
-            memcpy(_gateway_nodes_registers[nodeIndex].digital_outputs[address].value, value, size);
-
-            return true;
-
-        } else if (dataRegister == GATEWAY_REGISTER_AI) {
-            memcpy(_gateway_nodes_registers[nodeIndex].analog_inputs[address].value, value, size);
-
-            return true;
-
-        } else if (dataRegister == GATEWAY_REGISTER_AO) {
-            memcpy(_gateway_nodes_registers[nodeIndex].analog_outputs[address].value, value, size);
+    gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
 
-            return true;
+    if (dataRegister == GATEWAY_REGISTER_DI || dataRegister == GATEWAY_REGISTER_DO) {
+        uint8_t * bits = registers.arena + registers.offset[dataRegister] + (address / 8);
 
-        } else if (dataRegister == GATEWAY_REGISTER_EV) {
-            memcpy(_gateway_nodes_registers[nodeIndex].event_inputs[address].value, value, size);
+        if (*((bool *) value)) {
+            *bits |= (1 << (address % 8));
 
-            return true;
+        } else {
+            *bits &= ~(1 << (address % 8));
         }
+
+    } else {
+        memcpy(_gatewayRegistersValuePointer(nodeIndex, dataRegister, address), value, size);
     }
 
-    return false;
+    return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -221,195 +204,181 @@ bool _gatewayRegistersWriteValue(const uint8_t nodeIndex, const uint8_t dataRegi
 bool _gatewayRegistersWriteValue(const uint8_t nodeIndex, const uint8_t dataRegister, const uint8_t address, const int32_t value) { return _gatewayRegistersWriteValue(nodeIndex, dataRegister, address, &value, 4); }
 bool _gatewayRegistersWriteValue(const uint8_t nodeIndex, const uint8_t dataRegister, const uint8_t address, const float value) { return _gatewayRegistersWriteValue(nodeIndex, dataRegister, address, &value, 4); }
 
+// -----------------------------------------------------------------------------
+// REGISTERS CODECS
 // -----------------------------------------------------------------------------
 
 /**
- * Transform received 4 bytes value into register value
+ * Decode block of received same-typed values, store changed ones & notify modules
  */
-void _gatewayRegistersWriteReceivedValue(
+template<uint8_t datatype> void _gatewayRegistersStoreReceivedBlock(
     const uint8_t nodeIndex,
     const uint8_t dataRegister,
-    const uint8_t address,
-    char * value
+    const uint8_t startAddress,
+    const uint8_t count,
+    const uint8_t * bytes,
+    const uint8_t stride
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
+    typedef gateway_data_type_traits_t<datatype> traits;
 
-    switch (_gatewayRegistersGetRegisterDataType(nodeIndex, dataRegister, address))
-    {
-        case GATEWAY_DATA_TYPE_BOOL:
-            bool bool_stored_value;
-            BOOL_UNION_t bool_write_value;
+    typename traits::type received_value;
+    typename traits::type stored_value;
 
-            bool_write_value.bytes[0] = value[0];
-            bool_write_value.bytes[1] = value[1];
-            bool_write_value.bytes[2] = value[2];
-            bool_write_value.bytes[3] = value[3];
+    char payload[GATEWAY_REGISTER_VALUE_FORMAT_LENGTH];
 
-            gatewayRegistersReadValue(nodeIndex, dataRegister, address, bool_stored_value);
+    for (uint8_t i = 0; i < count; i++) {
+        received_value = traits::decode(bytes + (i * stride));
 
-            if (bool_stored_value != bool_write_value.number) {
-                if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, address, bool_write_value.number)) {
-                    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, bool_write_value.number);
+        gatewayRegistersReadValue(nodeIndex, dataRegister, (startAddress + i), stored_value);
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
-                }
-            }
-            break;
+        if (stored_value == received_value) {
+            continue;
+        }
 
-        case GATEWAY_DATA_TYPE_UINT8:
-            uint8_t uint8_stored_value;
-            UINT8_UNION_t uint8_write_value;
+        if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, (startAddress + i), received_value)) {
+            gatewaySchedulerMarkRegisterChanged(nodeIndex, dataRegister);
 
-            uint8_write_value.bytes[0] = value[0];
-            uint8_write_value.bytes[1] = value[1];
-            uint8_write_value.bytes[2] = value[2];
-            uint8_write_value.bytes[3] = value[3];
+            // Analog values are propagated only when crossing their deadband
+            if (gatewayDeadbandsValueChanged(nodeIndex, dataRegister, (startAddress + i), (float) received_value)) {
+                traits::format(received_value, payload);
 
-            gatewayRegistersReadValue(nodeIndex, dataRegister, address, uint8_stored_value);
+                gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, (startAddress + i), payload);
+            }
 
-            if (uint8_stored_value != uint8_write_value.number) {
-                if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, address, uint8_write_value.number)) {
-                    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, uint8_write_value.number);
+        } else {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
+        }
+    }
+}
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
-                }
-            }
-            break;
+// -----------------------------------------------------------------------------
 
-        case GATEWAY_DATA_TYPE_UINT16:
-            uint16_t uint16_stored_value;
-            UINT16_UNION_t uint16_write_value;
+template<uint8_t datatype> void _gatewayRegistersFormatStoredValue(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address,
+    char * buffer
+) {
+    typename gateway_data_type_traits_t<datatype>::type stored_value;
 
-            uint16_write_value.bytes[0] = value[0];
-            uint16_write_value.bytes[1] = value[1];
-            uint16_write_value.bytes[2] = value[2];
-            uint16_write_value.bytes[3] = value[3];
+    gatewayRegistersReadValue(nodeIndex, dataRegister, address, stored_value);
 
-            gatewayRegistersReadValue(nodeIndex, dataRegister, address, uint16_stored_value);
+    gateway_data_type_traits_t<datatype>::format(stored_value, buffer);
+}
 
-            if (uint16_stored_value != uint16_write_value.number) {
-                if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, address, uint16_write_value.number)) {
-                    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, uint16_write_value.number);
+// -----------------------------------------------------------------------------
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
-                }
-            }
-            break;
+template<uint8_t datatype> void _gatewayRegistersParseValue(
+    const char * payload,
+    uint8_t * bytes
+) {
+    gateway_data_type_traits_t<datatype>::encode(gateway_data_type_traits_t<datatype>::parse(payload), bytes);
+}
 
-        case GATEWAY_DATA_TYPE_UINT32:
-            uint32_t uint32_stored_value;
-            UINT32_UNION_t uint32_write_value;
+// -----------------------------------------------------------------------------
 
-            uint32_write_value.bytes[0] = value[0];
-            uint32_write_value.bytes[1] = value[1];
-            uint32_write_value.bytes[2] = value[2];
-            uint32_write_value.bytes[3] = value[3];
+template<uint8_t datatype> float _gatewayRegistersStoredNumericValue(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address
+) {
+    typename gateway_data_type_traits_t<datatype>::type stored_value;
 
-            gatewayRegistersReadValue(nodeIndex, dataRegister, address, uint32_stored_value);
+    gatewayRegistersReadValue(nodeIndex, dataRegister, address, stored_value);
 
-            if (uint32_stored_value != uint32_write_value.number) {
-                if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, address, uint32_write_value.number)) {
-                    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, uint32_write_value.number);
+    return (float) stored_value;
+}
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
-                }
-            }
-            break;
+// -----------------------------------------------------------------------------
 
-        case GATEWAY_DATA_TYPE_INT8:
-            int8_t int8_stored_value;
-            INT8_UNION_t int8_write_value;
+/**
+ * Store block of received values which have same datatype
+ */
+void _gatewayRegistersStoreReceivedValues(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t datatype,
+    const uint8_t startAddress,
+    const uint8_t count,
+    const uint8_t * bytes,
+    const uint8_t stride
+) {
+    switch (datatype)
+    {
+        case GATEWAY_DATA_TYPE_BOOL:
+            _gatewayRegistersStoreReceivedBlock<GATEWAY_DATA_TYPE_BOOL>(nodeIndex, dataRegister, startAddress, count, bytes, stride);
+            break;
 
-            int8_write_value.bytes[0] = value[0];
-            int8_write_value.bytes[1] = value[1];
-            int8_write_value.bytes[2] = value[2];
-            int8_write_value.bytes[3] = value[3];
+        case GATEWAY_DATA_TYPE_UINT8:
+            _gatewayRegistersStoreReceivedBlock<GATEWAY_DATA_TYPE_UINT8>(nodeIndex, dataRegister, startAddress, count, bytes, stride);
+            break;
 
-            gatewayRegistersReadValue(nodeIndex, dataRegister, address, int8_stored_value);
+        case GATEWAY_DATA_TYPE_UINT16:
+            _gatewayRegistersStoreReceivedBlock<GATEWAY_DATA_TYPE_UINT16>(nodeIndex, dataRegister, startAddress, count, bytes, stride);
+            break;
 
-            if (int8_stored_value != int8_write_value.number) {
-                if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, address, int8_write_value.number)) {
-                    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, int8_write_value.number);
+        case GATEWAY_DATA_TYPE_UINT32:
+            _gatewayRegistersStoreReceivedBlock<GATEWAY_DATA_TYPE_UINT32>(nodeIndex, dataRegister, startAddress, count, bytes, stride);
+            break;
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
-                }
-            }
+        case GATEWAY_DATA_TYPE_INT8:
+            _gatewayRegistersStoreReceivedBlock<GATEWAY_DATA_TYPE_INT8>(nodeIndex, dataRegister, startAddress, count, bytes, stride);
             break;
 
         case GATEWAY_DATA_TYPE_INT16:
-            int16_t int16_stored_value;
-            INT16_UNION_t int16_write_value;
-
-            int16_write_value.bytes[0] = value[0];
-            int16_write_value.bytes[1] = value[1];
-            int16_write_value.bytes[2] = value[2];
-            int16_write_value.bytes[3] = value[3];
+            _gatewayRegistersStoreReceivedBlock<GATEWAY_DATA_TYPE_INT16>(nodeIndex, dataRegister, startAddress, count, bytes, stride);
+            break;
 
-            gatewayRegistersReadValue(nodeIndex, dataRegister, address, int16_stored_value);
+        case GATEWAY_DATA_TYPE_INT32:
+            _gatewayRegistersStoreReceivedBlock<GATEWAY_DATA_TYPE_INT32>(nodeIndex, dataRegister, startAddress, count, bytes, stride);
+            break;
 
-            if (int16_stored_value != int16_write_value.number) {
-                if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, address, int16_write_value.number)) {
-                    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, int16_write_value.number);
+        case GATEWAY_DATA_TYPE_FLOAT32:
+            _gatewayRegistersStoreReceivedBlock<GATEWAY_DATA_TYPE_FLOAT32>(nodeIndex, dataRegister, startAddress, count, bytes, stride);
+            break;
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
-                }
-            }
+        default:
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Provided unknown data type for writing into register\n"));
             break;
+    }
+}
 
-        case GATEWAY_DATA_TYPE_INT32:
-            int32_t int32_stored_value;
-            INT32_UNION_t int32_write_value;
+// -----------------------------------------------------------------------------
 
-            int32_write_value.bytes[0] = value[0];
-            int32_write_value.bytes[1] = value[1];
-            int32_write_value.bytes[2] = value[2];
-            int32_write_value.bytes[3] = value[3];
+/**
+ * Store received bit-packed digital values directly into registers bitset
+ */
+void _gatewayRegistersStoreReceivedBits(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t startAddress,
+    const uint16_t count,
+    const uint8_t * bytes
+) {
+    gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
 
-            gatewayRegistersReadValue(nodeIndex, dataRegister, address, int32_stored_value);
+    uint8_t * bits = registers.arena + registers.offset[dataRegister];
 
-            if (int32_stored_value != int32_write_value.number) {
-                if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, address, int32_write_value.number)) {
-                    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, int32_write_value.number);
+    char payload[GATEWAY_REGISTER_VALUE_FORMAT_LENGTH];
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
-                }
-            }
-            break;
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t address = startAddress + i;
+        uint8_t mask = 1 << (address % 8);
 
-        case GATEWAY_DATA_TYPE_FLOAT32:
-            float float_stored_value;
-            FLOAT32_UNION_t float_write_value;
+        bool received_value = (bytes[i / 8] >> (i % 8)) & 0x01;
 
-            float_write_value.bytes[0] = value[0];
-            float_write_value.bytes[1] = value[1];
-            float_write_value.bytes[2] = value[2];
-            float_write_value.bytes[3] = value[3];
+        // Only changed bits are stored & reported
+        if (((bits[address / 8] & mask) != 0) == received_value) {
+            continue;
+        }
 
-            gatewayRegistersReadValue(nodeIndex, dataRegister, address, float_stored_value);
+        bits[address / 8] ^= mask;
 
-            if (float_stored_value != float_write_value.number) {
-                if (_gatewayRegistersWriteValue(nodeIndex, dataRegister, address, float_write_value.number)) {
-                    gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, float_write_value.number);
+        gatewaySchedulerMarkRegisterChanged(nodeIndex, dataRegister);
 
-                } else {
-                    DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Value could not be stored in register\n"));
-                }
-            }
-            break;
+        gateway_data_type_traits_t<GATEWAY_DATA_TYPE_BOOL>::format(received_value, payload);
 
-        default:
-            DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Provided unknown data type for writing into register\n"));
-            break;
+        gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, address, payload);
     }
 }
 
@@ -421,11 +390,6 @@ void _gatewayRegistersRequestReadingDigitalRegisters(
     const uint8_t nodeIndex,
     const uint8_t dataRegister
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     uint8_t packet_id = GATEWAY_PACKET_NONE;
 
     // Validate register index
@@ -444,15 +408,15 @@ void _gatewayRegistersRequestReadingDigitalRegisters(
     switch (dataRegister)
     {
         case GATEWAY_REGISTER_DI:
-            register_size = _gateway_nodes_registers[nodeIndex].digital_inputs.size();
+            register_size = _gateway_nodes_details[nodeIndex]->registers.size[GATEWAY_REGISTER_DI];
             break;
 
         case GATEWAY_REGISTER_DO:
-            register_size = _gateway_nodes_registers[nodeIndex].digital_outputs.size();
+            register_size = _gateway_nodes_details[nodeIndex]->registers.size[GATEWAY_REGISTER_DO];
             break;
     }
 
-    uint8_t start = _gateway_nodes_registers_reading[nodeIndex].start;
+    uint8_t start = _gateway_nodes_details[nodeIndex]->reading.start;
 
     char output_content[5];
 
@@ -497,11 +461,14 @@ void _gatewayRegistersRequestReadingDigitalRegisters(
         }
     }
 
+    uint8_t packet_sequence;
+    bool packet_sequenced;
+
     // Record requested packet
-    if (gatewaySendPacket((nodeIndex + 1), output_content, 5)) {
-        gatewayCommunicationSetWaitingPacket(nodeIndex, packet_id);
+    if (gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 5, NULL, packet_sequence, packet_sequenced)) {
+        gatewayCommunicationSetWaitingPacket(nodeIndex, packet_id, packet_sequence, packet_sequenced);
 
-        _gateway_nodes_registers_reading[nodeIndex].start = start;
+        _gateway_nodes_details[nodeIndex]->reading.start = start;
 
          if (start == 0) {
             _gatewayRegistersUpdateReadingPointer(nodeIndex, dataRegister);
@@ -516,11 +483,6 @@ void _gatewayRegistersRequestReadingDigitalRegisters(
 void _gatewayRegistersRequestReadingMultipleDigitalInputRegisters(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     _gatewayRegistersRequestReadingDigitalRegisters(
         nodeIndex,
         GATEWAY_REGISTER_DI
@@ -532,11 +494,6 @@ void _gatewayRegistersRequestReadingMultipleDigitalInputRegisters(
 void _gatewayRegistersRequestReadingMultipleDigitalOutputRegisters(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     _gatewayRegistersRequestReadingDigitalRegisters(
         nodeIndex,
         GATEWAY_REGISTER_DO
@@ -551,11 +508,6 @@ void _gatewayRegistersRequestReadingAnalogRegisters(
     const uint8_t nodeIndex,
     const uint8_t dataRegister
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     uint8_t packet_id = GATEWAY_PACKET_NONE;
 
     // Validate register index
@@ -574,15 +526,15 @@ void _gatewayRegistersRequestReadingAnalogRegisters(
     switch (dataRegister)
     {
         case GATEWAY_REGISTER_AI:
-            register_size = _gateway_nodes_registers[nodeIndex].analog_inputs.size();
+            register_size = _gateway_nodes_details[nodeIndex]->registers.size[GATEWAY_REGISTER_AI];
             break;
 
         case GATEWAY_REGISTER_AO:
-            register_size = _gateway_nodes_registers[nodeIndex].analog_outputs.size();
+            register_size = _gateway_nodes_details[nodeIndex]->registers.size[GATEWAY_REGISTER_AO];
             break;
     }
 
-    uint8_t start = _gateway_nodes_registers_reading[nodeIndex].start;
+    uint8_t start = _gateway_nodes_details[nodeIndex]->reading.start;
 
     char output_content[5];
 
@@ -627,11 +579,14 @@ void _gatewayRegistersRequestReadingAnalogRegisters(
         }
     }
 
+    uint8_t packet_sequence;
+    bool packet_sequenced;
+
     // Record requested packet
-    if (gatewaySendPacket((nodeIndex + 1), output_content, 5)) {
-        gatewayCommunicationSetWaitingPacket(nodeIndex, packet_id);
+    if (gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 5, NULL, packet_sequence, packet_sequenced)) {
+        gatewayCommunicationSetWaitingPacket(nodeIndex, packet_id, packet_sequence, packet_sequenced);
 
-        _gateway_nodes_registers_reading[nodeIndex].start = start;
+        _gateway_nodes_details[nodeIndex]->reading.start = start;
 
          if (start == 0) {
             _gatewayRegistersUpdateReadingPointer(nodeIndex, dataRegister);
@@ -646,11 +601,6 @@ void _gatewayRegistersRequestReadingAnalogRegisters(
 void _gatewayRegistersRequestReadingMultipleAnalogInputRegisters(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     _gatewayRegistersRequestReadingAnalogRegisters(
         nodeIndex,
         GATEWAY_REGISTER_AI
@@ -662,11 +612,6 @@ void _gatewayRegistersRequestReadingMultipleAnalogInputRegisters(
 void _gatewayRegistersRequestReadingMultipleAnalogOutputRegisters(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     _gatewayRegistersRequestReadingAnalogRegisters(
         nodeIndex,
         GATEWAY_REGISTER_AO
@@ -681,11 +626,6 @@ void _gatewayRegistersRequestReadingEventRegisters(
     const uint8_t nodeIndex,
     const uint8_t dataRegister
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     uint8_t packet_id = GATEWAY_PACKET_NONE;
 
     // Validate register index
@@ -701,11 +641,11 @@ void _gatewayRegistersRequestReadingEventRegisters(
     switch (dataRegister)
     {
         case GATEWAY_REGISTER_EV:
-            register_size = _gateway_nodes_registers[nodeIndex].event_inputs.size();
+            register_size = _gateway_nodes_details[nodeIndex]->registers.size[GATEWAY_REGISTER_EV];
             break;
     }
 
-    uint8_t start = _gateway_nodes_registers_reading[nodeIndex].start;
+    uint8_t start = _gateway_nodes_details[nodeIndex]->reading.start;
 
     char output_content[5];
 
@@ -750,11 +690,14 @@ void _gatewayRegistersRequestReadingEventRegisters(
         }
     }
 
+    uint8_t packet_sequence;
+    bool packet_sequenced;
+
     // Record requested packet
-    if (gatewaySendPacket((nodeIndex + 1), output_content, 5)) {
-        gatewayCommunicationSetWaitingPacket(nodeIndex, packet_id);
+    if (gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 5, NULL, packet_sequence, packet_sequenced)) {
+        gatewayCommunicationSetWaitingPacket(nodeIndex, packet_id, packet_sequence, packet_sequenced);
 
-        _gateway_nodes_registers_reading[nodeIndex].start = start;
+        _gateway_nodes_details[nodeIndex]->reading.start = start;
 
          if (start == 0) {
             _gatewayRegistersUpdateReadingPointer(nodeIndex, dataRegister);
@@ -769,11 +712,6 @@ void _gatewayRegistersRequestReadingEventRegisters(
 void _gatewayRegistersRequestReadingMultipleEventRegisters(
     const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
     _gatewayRegistersRequestReadingEventRegisters(
         nodeIndex,
         GATEWAY_REGISTER_EV
@@ -781,604 +719,1243 @@ void _gatewayRegistersRequestReadingMultipleEventRegisters(
 }
 
 // -----------------------------------------------------------------------------
-// DIGITAL REGISTERS WRITING (only for DO registers)
+// COMBINED REGISTERS READING
 // -----------------------------------------------------------------------------
 
-void _gatewayRegistersRequestWritingSingleDigitalRegister(
-    const uint8_t nodeIndex,
-    const uint8_t registerAddress,
-    bool value
+/**
+ * Count of reply bytes needed for values of registers range
+ */
+uint16_t _gatewayRegistersReplyValuesLength(
+    const uint8_t dataRegister,
+    const uint8_t length
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
+    if (dataRegister == GATEWAY_REGISTER_DI || dataRegister == GATEWAY_REGISTER_DO) {
+        return (length + 7) / 8;
     }
 
-    char output_content[6];
+    return (uint16_t) length * GATEWAY_REGISTER_ANALOG_VALUE_SIZE;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Request all due registers spaces which fit into one reply, returns false when spaces have to be read one by one
+ *
+ * PAYLOAD:
+ * 0    => Packet identifier            => GATEWAY_PACKET_READ_COMBINED
+ * 1    => Count of ranges
+ * 2-n  => Ranges: registers space, high byte of start address, low byte of start address, high byte of length, low byte of length
+ */
+bool _gatewayRegistersRequestReadingCombined(
+    const uint8_t nodeIndex
+) {
+    uint32_t time = millis();
+
+    // Reply is reduced by packet header (4 bytes), sequence byte & combined reply header (2 bytes)
+    uint16_t reply_capacity = gatewayCommunicationGetMaxPacketSize(nodeIndex) - 7;
 
-    output_content[0] = GATEWAY_PACKET_WRITE_ONE_DO;
+    char output_content[2 + (GATEWAY_REGISTER_MAX * 5)];
 
-    // Register write address
-    output_content[1] = (char) (registerAddress >> 8);
-    output_content[2] = (char) (registerAddress & 0xFF);
+    output_content[0] = GATEWAY_PACKET_READ_COMBINED;
 
-    uint16_t write_value;
+    uint8_t ranges_count = 0;
+    uint8_t ranges_spaces = 0;
 
-    if (value == true) {
-        write_value = 0xFF00;
+    uint8_t data_register = gatewaySchedulerGetDueRegister(nodeIndex, time);
 
-    } else {
-        write_value = 0x0000;
+    while (data_register != GATEWAY_REGISTER_NONE) {
+        uint8_t register_size = gatewayRegistersSize(nodeIndex, data_register);
+
+        // Range header (4 bytes) & values
+        uint16_t reply_length = 4 + _gatewayRegistersReplyValuesLength(data_register, register_size);
+
+        if (reply_length <= reply_capacity) {
+            uint8_t position = 2 + (ranges_count * 5);
+
+            output_content[position] = (char) data_register;
+            output_content[position + 1] = 0;
+            output_content[position + 2] = 0;
+            output_content[position + 3] = (char) (register_size >> 8);
+            output_content[position + 4] = (char) (register_size & 0xFF);
+
+            reply_capacity = reply_capacity - reply_length;
+
+            ranges_count++;
+
+        } else if (ranges_count == 0) {
+            // Whole space could not be read at once, it is read in chunks
+            return false;
+        }
+
+        ranges_spaces |= (1 << data_register);
+
+        data_register = GATEWAY_REGISTER_NONE;
+
+        // Next due space which was not processed yet
+        for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+            if ((ranges_spaces & (1 << i)) == 0 && gatewaySchedulerIsRegisterDue(nodeIndex, i, time)) {
+                data_register = i;
+
+                break;
+            }
+        }
+    }
+
+    if (ranges_count == 0) {
+        return false;
     }
 
-    output_content[3] = (char) (write_value >> 8);
-    output_content[4] = (char) (write_value & 0xFF);
+    output_content[1] = (char) ranges_count;
+
+    uint8_t packet_sequence;
+    bool packet_sequenced;
 
     // Record requested packet
-    if (gatewaySendPacket((nodeIndex + 1), output_content, 5)) {
-        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_WRITE_ONE_DO);
+    if (gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, (2 + (ranges_count * 5)), NULL, packet_sequence, packet_sequenced)) {
+        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_READ_COMBINED, packet_sequence, packet_sequenced);
+
+        for (uint8_t i = 0; i < ranges_count; i++) {
+            gatewaySchedulerMarkRegisterPolled(nodeIndex, output_content[2 + (i * 5)]);
+        }
+
+        if (_gateway_nodes_details[nodeIndex]->reading.combined == GATEWAY_READING_SUPPORT_UNKNOWN) {
+            _gateway_nodes_details[nodeIndex]->reading.combined_probes++;
+        }
     }
 
     gatewayCommunicationIncrementAttempts(nodeIndex);
+
+    return true;
 }
 
 // -----------------------------------------------------------------------------
-// ANALOG REGISTERS WRITING (only for AO registers)
+// CHANGES REGISTERS READING
 // -----------------------------------------------------------------------------
 
-void _gatewayRegistersRequestWritingSingleAnalogRegister(
-    const uint8_t nodeIndex,
-    const uint8_t registerAddress,
-    void * value,
-    const uint8_t size
+/**
+ * Request registers changed since last received change sequence
+ *
+ * Node is counting every change of its registers. When gateway is not synchronized
+ * or node history is not covering requested sequence, node replies with resync
+ * flag and its current sequence and gateway reads all spaces again.
+ *
+ * PAYLOAD:
+ * 0    => Packet identifier            => GATEWAY_PACKET_READ_CHANGES
+ * 1    => Gateway is synchronized      => 0 or 1
+ * 2    => High byte of last received change sequence
+ * 3    => Low byte of last received change sequence
+ */
+void _gatewayRegistersRequestReadingChanges(
+    const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
+    char output_content[4];
+
+    output_content[0] = GATEWAY_PACKET_READ_CHANGES;
+    output_content[1] = _gateway_nodes_details[nodeIndex]->reading.synchronized ? 1 : 0;
+    output_content[2] = (char) (_gateway_nodes_details[nodeIndex]->reading.sequence >> 8);
+    output_content[3] = (char) (_gateway_nodes_details[nodeIndex]->reading.sequence & 0xFF);
+
+    uint8_t packet_sequence;
+    bool packet_sequenced;
+
+    // Record requested packet
+    if (gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 4, NULL, packet_sequence, packet_sequenced)) {
+        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_READ_CHANGES, packet_sequence, packet_sequenced);
+
+        if (_gateway_nodes_details[nodeIndex]->reading.delta == GATEWAY_READING_SUPPORT_UNKNOWN) {
+            _gateway_nodes_details[nodeIndex]->reading.delta_probes++;
+        }
     }
 
-    char output_content[6];
+    gatewayCommunicationIncrementAttempts(nodeIndex);
+}
 
-    output_content[0] = GATEWAY_PACKET_WRITE_ONE_AO;
+// -----------------------------------------------------------------------------
+// EVENTS QUEUE READING
+// -----------------------------------------------------------------------------
 
-    char buffer[4] = { 0 };
+/**
+ * Request events queued by node since last reading
+ *
+ * Node is keeping EV events in queue with rolling sequence number. Events with
+ * sequence lower than expected one were received by gateway & node drops them.
+ *
+ * PAYLOAD:
+ * 0    => Packet identifier            => GATEWAY_PACKET_READ_EVENTS
+ * 1    => Expected sequence is valid   => 0 or 1
+ * 2    => Sequence of next expected event
+ */
+void _gatewayRegistersRequestReadingEvents(
+    const uint8_t nodeIndex
+) {
+    char output_content[3];
 
-    memcpy(buffer, value, size);
+    output_content[0] = GATEWAY_PACKET_READ_EVENTS;
+    output_content[1] = _gateway_nodes_details[nodeIndex]->events.synchronized ? 1 : 0;
+    output_content[2] = (char) _gateway_nodes_details[nodeIndex]->events.sequence;
 
-    // Register write address
-    output_content[1] = (char) (registerAddress >> 8);
-    output_content[2] = (char) (registerAddress & 0xFF);
-    output_content[3] = (char) buffer[0];
-    output_content[4] = (char) buffer[1];
-    output_content[5] = (char) buffer[2];
-    output_content[6] = (char) buffer[3];
+    uint8_t packet_sequence;
+    bool packet_sequenced;
 
     // Record requested packet
-    if (gatewaySendPacket((nodeIndex + 1), output_content, 6)) {
-        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_WRITE_ONE_AO);
+    if (gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, 3, NULL, packet_sequence, packet_sequenced)) {
+        gatewayCommunicationSetWaitingPacket(nodeIndex, GATEWAY_PACKET_READ_EVENTS, packet_sequence, packet_sequenced);
+
+        if (_gateway_nodes_details[nodeIndex]->events.support == GATEWAY_READING_SUPPORT_UNKNOWN) {
+            _gateway_nodes_details[nodeIndex]->events.probes++;
+        }
     }
 
     gatewayCommunicationIncrementAttempts(nodeIndex);
 }
 
 // -----------------------------------------------------------------------------
-
-// Specialized convenience setters (these do not cost memory because of inlining)
-void _gatewayRegistersRequestWritingSingleAnalogRegister(const uint8_t nodeIndex, const uint8_t registerAddress, uint8_t value) { _gatewayRegistersRequestWritingSingleAnalogRegister(nodeIndex, registerAddress, &value, 1); }
-void _gatewayRegistersRequestWritingSingleAnalogRegister(const uint8_t nodeIndex, const uint8_t registerAddress, uint16_t value) { _gatewayRegistersRequestWritingSingleAnalogRegister(nodeIndex, registerAddress, &value, 2); }
-void _gatewayRegistersRequestWritingSingleAnalogRegister(const uint8_t nodeIndex, const uint8_t registerAddress, uint32_t value) { _gatewayRegistersRequestWritingSingleAnalogRegister(nodeIndex, registerAddress, &value, 4); }
-void _gatewayRegistersRequestWritingSingleAnalogRegister(const uint8_t nodeIndex, const uint8_t registerAddress, int8_t value) { _gatewayRegistersRequestWritingSingleAnalogRegister(nodeIndex, registerAddress, &value, 1); }
-void _gatewayRegistersRequestWritingSingleAnalogRegister(const uint8_t nodeIndex, const uint8_t registerAddress, int16_t value) { _gatewayRegistersRequestWritingSingleAnalogRegister(nodeIndex, registerAddress, &value, 2); }
-void _gatewayRegistersRequestWritingSingleAnalogRegister(const uint8_t nodeIndex, const uint8_t registerAddress, int32_t value) { _gatewayRegistersRequestWritingSingleAnalogRegister(nodeIndex, registerAddress, &value, 4); }
-void _gatewayRegistersRequestWritingSingleAnalogRegister(const uint8_t nodeIndex, const uint8_t registerAddress, float value) { _gatewayRegistersRequestWritingSingleAnalogRegister(nodeIndex, registerAddress, &value, 4); }
-
-// -----------------------------------------------------------------------------
-// READING HANDLERS 
+// REGISTERS WRITING (only for DO & AO registers)
 // -----------------------------------------------------------------------------
 
-void _gatewayRegistersReadMultipleRegisterAddressesHandler(
+uint8_t _gatewayRegistersFindWrite(
     const uint8_t nodeIndex,
     const uint8_t dataRegister,
-    uint8_t * payload
+    const uint8_t address,
+    const bool sending
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
-    word start_address = (word) payload[1] << 8 | (word) payload[2];
+    for (uint8_t i = 0; i < FB_GATEWAY_WRITE_QUEUE_SIZE; i++) {
+        gateway_register_write_t & write = _gateway_nodes_details[nodeIndex]->writing[i];
 
-    uint8_t bytes_length = (uint8_t) payload[3];
+        if (
+            write.register_type == dataRegister
+            && write.address == address
+            && write.sending == sending
+        ) {
+            return i;
+        }
+    }
 
-    // DEBUG_MSG(
-    //     PSTR("[INFO][GATEWAY][REGISTERS] Received reading response from node: %d to register: %d at address: %d with byte length: %d\n"),
-    //     nodeIndex,
-    //     dataRegister,
-    //     start_address,
-    //     bytes_length
-    // );
+    return INDEX_NONE;
+}
 
-    uint8_t register_size = 0;
+// -----------------------------------------------------------------------------
 
-    switch (dataRegister)
+bool _gatewayRegistersIsWaitingForWriting(
+    const uint8_t nodeIndex
+) {
+    switch (gatewayCommunicationGetPacketWaitingFor(nodeIndex))
     {
-        case GATEWAY_REGISTER_DI:
-            register_size = _gateway_nodes_registers[nodeIndex].digital_inputs.size();
-            break;
-
-        case GATEWAY_REGISTER_DO:
-            register_size = _gateway_nodes_registers[nodeIndex].digital_outputs.size();
-            break;
-
-        case GATEWAY_REGISTER_AI:
-            register_size = _gateway_nodes_registers[nodeIndex].analog_inputs.size();
-            break;
-
-        case GATEWAY_REGISTER_AO:
-            register_size = _gateway_nodes_registers[nodeIndex].analog_outputs.size();
-            break;
-
-        case GATEWAY_REGISTER_EV:
-            register_size = _gateway_nodes_registers[nodeIndex].event_inputs.size();
-            break;
+        case GATEWAY_PACKET_WRITE_ONE_DO:
+        case GATEWAY_PACKET_WRITE_ONE_AO:
+        case GATEWAY_PACKET_WRITE_MULTI_DO:
+        case GATEWAY_PACKET_WRITE_MULTI_AO:
+            return true;
     }
 
-    if (
-        // Read start address must be between <0, register.size()>
-        start_address < register_size
-    ) {
-        if (dataRegister == GATEWAY_REGISTER_DI || dataRegister == GATEWAY_REGISTER_DO) {
-            uint8_t write_byte = 1;
-            uint8_t data_byte;
-
-            uint8_t write_address = start_address;
-
-            BOOL_UNION_t bool_write_value;
+    return false;
+}
 
-            bool_write_value.number = false;
+// -----------------------------------------------------------------------------
 
-            char write_value[4] = { 0 };
+/**
+ * Sent values without node confirmation are written again, unless they were replaced by newer value
+ */
+void _gatewayRegistersReleaseUnconfirmedWrites(
+    const uint8_t nodeIndex
+) {
+    for (uint8_t i = 0; i < FB_GATEWAY_WRITE_QUEUE_SIZE; i++) {
+        gateway_register_write_t & write = _gateway_nodes_details[nodeIndex]->writing[i];
 
-            while (
-                write_address < register_size
-                && write_byte <= bytes_length
-            ) {
-                data_byte = (uint8_t) payload[3 + write_byte];
+        if (write.register_type == GATEWAY_REGISTER_NONE || write.sending == false) {
+            continue;
+        }
 
-                for (uint8_t i = 0; i < 8; i++) {
-                    bool_write_value.number = (data_byte >> i) & 0x01 ? true : false;
+        if (_gatewayRegistersFindWrite(nodeIndex, write.register_type, write.address, false) != INDEX_NONE) {
+            write.register_type = GATEWAY_REGISTER_NONE;
+        }
 
-                    // Clear buffer
-                    memset(write_value, 0, sizeof(write_value));
+        write.sending = false;
+    }
+}
 
-                    write_value[0] = bool_write_value.bytes[0];
-                    write_value[1] = bool_write_value.bytes[1];
-                    write_value[2] = bool_write_value.bytes[2];
-                    write_value[3] = bool_write_value.bytes[3];
+// -----------------------------------------------------------------------------
 
-                    _gatewayRegistersWriteReceivedValue(nodeIndex, dataRegister, write_address, write_value);
+/**
+ * Convert received payload into raw register value
+ */
+bool _gatewayRegistersParsePayload(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address,
+    const char * payload,
+    uint8_t * value
+) {
+    switch (_gatewayRegistersGetRegisterDataType(nodeIndex, dataRegister, address))
+    {
+        case GATEWAY_DATA_TYPE_BOOL:
+            if (strcmp(payload, FASTYBIRD_SWITCH_PAYLOAD_TOGGLE) == 0) {
+                uint8_t position = _gatewayRegistersFindWrite(nodeIndex, dataRegister, address, false);
 
-                    // DEBUG_MSG(
-                    //     PSTR("[INFO][GATEWAY][REGISTERS] Value was written into register: %d at address: %d\n"),
-                    //     dataRegister,
-                    //     write_address
-                    // );
+                bool stored_value = false;
 
-                    write_address++;
+                // Toggle is applied to the latest requested value
+                if (position != INDEX_NONE) {
+                    stored_value = _gateway_nodes_details[nodeIndex]->writing[position].value[0] != 0;
 
-                    if (write_address >= register_size) {
-                        break;
-                    }
+                } else {
+                    gatewayRegistersReadValue(nodeIndex, dataRegister, address, stored_value);
                 }
 
-                write_byte++;
-            }
-
-        } else {
-            uint8_t write_byte = 4;
-            uint8_t data_byte;
-
-            uint8_t write_address = start_address;
+                gateway_data_type_traits_t<GATEWAY_DATA_TYPE_BOOL>::encode(!stored_value, value);
 
-            char write_value[4] = { 0 };
+            } else {
+                _gatewayRegistersParseValue<GATEWAY_DATA_TYPE_BOOL>(payload, value);
+            }
+            return true;
 
-            while (
-                write_address < register_size
-                && write_byte <= bytes_length
-            ) {
-                // Clear buffer
-                memset(write_value, 0, sizeof(write_value));
+        case GATEWAY_DATA_TYPE_UINT8:
+            _gatewayRegistersParseValue<GATEWAY_DATA_TYPE_UINT8>(payload, value);
+            return true;
 
-                write_value[0] = payload[write_byte];
-                write_value[1] = payload[write_byte + 1];
-                write_value[2] = payload[write_byte + 2];
-                write_value[3] = payload[write_byte + 3];
+        case GATEWAY_DATA_TYPE_UINT16:
+            _gatewayRegistersParseValue<GATEWAY_DATA_TYPE_UINT16>(payload, value);
+            return true;
 
-                _gatewayRegistersWriteReceivedValue(nodeIndex, dataRegister, write_address, write_value);
+        case GATEWAY_DATA_TYPE_UINT32:
+            _gatewayRegistersParseValue<GATEWAY_DATA_TYPE_UINT32>(payload, value);
+            return true;
 
-                // DEBUG_MSG(
-                //     PSTR("[INFO][GATEWAY][REGISTERS] Value was written into register: %d at address: %d\n"),
-                //     dataRegister,
-                //     write_address
-                // );
+        case GATEWAY_DATA_TYPE_INT8:
+            _gatewayRegistersParseValue<GATEWAY_DATA_TYPE_INT8>(payload, value);
+            return true;
 
-                write_byte = write_byte + 4;
-                write_address++;
-            }
-        }
+        case GATEWAY_DATA_TYPE_INT16:
+            _gatewayRegistersParseValue<GATEWAY_DATA_TYPE_INT16>(payload, value);
+            return true;
 
-        gatewayCommunicationResetAttempts(nodeIndex);
+        case GATEWAY_DATA_TYPE_INT32:
+            _gatewayRegistersParseValue<GATEWAY_DATA_TYPE_INT32>(payload, value);
+            return true;
 
-    } else {
-        DEBUG_MSG(
-            PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined register: %d address\n"),
-            dataRegister
-        );
+        case GATEWAY_DATA_TYPE_FLOAT32:
+            _gatewayRegistersParseValue<GATEWAY_DATA_TYPE_FLOAT32>(payload, value);
+            return true;
     }
+
+    return false;
 }
 
-// -----------------------------------------------------------------------------
-// WRITING HANDLERS
 // -----------------------------------------------------------------------------
 
-void _gatewayRegistersWriteSingleDigitalOutputHandler(
+/**
+ * Sending of writing packet failed, values are written again with next request
+ */
+void _gatewayRegistersWriteSentCallback(
     const uint8_t nodeIndex,
-    uint8_t * payload
+    const uint8_t packetId,
+    const uint8_t result
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    if (result == GATEWAY_SEND_SUCCESS || nodeIndex == INDEX_NONE) {
         return;
     }
 
-    word register_address = (word) payload[1] << 8 | (word) payload[2];
-    
-    char write_value[4] = { 0 };
-
-    write_value[0] = payload[3];
-    write_value[1] = payload[4];
-    write_value[2] = payload[5];
-    write_value[3] = payload[6];
-
-    if (
-        // Write address must be between <0, register.size()>
-        register_address < _gateway_nodes_registers[nodeIndex].digital_outputs.size()
-    ) {
-        _gatewayRegistersWriteReceivedValue(nodeIndex, GATEWAY_REGISTER_DO, register_address, write_value);
-
-        // DEBUG_MSG(PSTR("[INFO][GATEWAY][REGISTERS] Value was written into DO register\n"));
+    _gatewayRegistersReleaseUnconfirmedWrites(nodeIndex);
 
-        gatewayCommunicationResetAttempts(nodeIndex);
-        
-    } else {
-        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined DO register address\n"));
-    }
+    gatewaySchedulerRequest(nodeIndex, GATEWAY_PRIORITY_CONTROL);
 }
 
 // -----------------------------------------------------------------------------
 
-void _gatewayRegistersWriteMultipleDigitalOutputHandler(
-    const uint8_t nodeIndex,
-    uint8_t * payload
+/**
+ * Send the oldest waiting value together with waiting values of adjacent registers
+ *
+ * SINGLE REGISTER PAYLOAD:
+ * 0    => Packet identifier            => GATEWAY_PACKET_WRITE_ONE_DO | GATEWAY_PACKET_WRITE_ONE_AO
+ * 1    => High byte of register address
+ * 2    => Low byte of register address
+ * 3-n  => DO: 0xFF00 or 0x0000, AO: 4 bytes of value
+ *
+ * MULTIPLE REGISTERS PAYLOAD:
+ * 0    => Packet identifier            => GATEWAY_PACKET_WRITE_MULTI_DO | GATEWAY_PACKET_WRITE_MULTI_AO
+ * 1    => High byte of start address
+ * 2    => Low byte of start address
+ * 3    => High byte of registers count
+ * 4    => Low byte of registers count
+ * 5    => Count of values bytes
+ * 6-n  => DO: bit-packed values, AO: 4 bytes per value
+ */
+void _gatewayRegistersRequestWriting(
+    const uint8_t nodeIndex
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    gateway_register_write_t * writing = _gateway_nodes_details[nodeIndex]->writing;
+
+    uint8_t first = INDEX_NONE;
+
+    for (uint8_t i = 0; i < FB_GATEWAY_WRITE_QUEUE_SIZE; i++) {
+        if (writing[i].register_type != GATEWAY_REGISTER_NONE && writing[i].sending == false) {
+            first = i;
+
+            break;
+        }
+    }
+
+    if (first == INDEX_NONE) {
         return;
     }
 
-    word register_address = (word) payload[1] << 8 | (word) payload[2];
-    word read_length = (word) payload[3] << 8 | (word) payload[4];
+    uint8_t register_type = writing[first].register_type;
 
-    uint8_t bytes_length = (uint8_t) payload[5];
+    uint8_t max_packet_size = gatewayCommunicationGetMaxPacketSize(nodeIndex);
 
-    if (
-        // Write start address mus be between <0, register.size()>
-        register_address < _gateway_nodes_registers[nodeIndex].digital_outputs.size()
-        // Write length have to be same or smaller as registers size
-        && (register_address + read_length) <= _gateway_nodes_registers[nodeIndex].digital_outputs.size()
-    ) {
-        // TODO: implement response handling
+    // Packet header (4 bytes), writing header (6 bytes) & sequence byte
+    uint8_t capacity = max_packet_size > 11 ? (max_packet_size - 11) : 0;
 
-        gatewayCommunicationResetAttempts(nodeIndex);
+    // Count of bit-packed values could exceed one byte
+    uint16_t max_length = register_type == GATEWAY_REGISTER_DO ? ((uint16_t) capacity * 8) : (capacity / GATEWAY_REGISTER_ANALOG_VALUE_SIZE);
 
-    } else {
-        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined DO registers range\n"));
+    // Written run could not be longer than registers space
+    if (max_length > gatewayRegistersSize(nodeIndex, register_type)) {
+        max_length = gatewayRegistersSize(nodeIndex, register_type);
     }
-}
 
-// -----------------------------------------------------------------------------
+    uint8_t start = writing[first].address;
 
-void _gatewayRegistersWriteSingleAnalogOutputHandler(
-    const uint8_t nodeIndex,
-    uint8_t * payload
-) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
+    // Find beginning of adjacent waiting values
+    while (start > 0 && _gatewayRegistersFindWrite(nodeIndex, register_type, (start - 1), false) != INDEX_NONE) {
+        start--;
     }
 
-    word register_address = (word) payload[1] << 8 | (word) payload[2];
-    
-    char write_value[4] = { 0 };
-
-    write_value[0] = payload[3];
-    write_value[1] = payload[4];
-    write_value[2] = payload[5];
-    write_value[3] = payload[6];
+    uint8_t length = 1;
 
-    if (
-        // Write address must be between <0, register.size()>
-        register_address < _gateway_nodes_registers[nodeIndex].analog_outputs.size()
+    while (
+        length < max_length
+        && (start + length) <= UINT8_MAX
+        && _gatewayRegistersFindWrite(nodeIndex, register_type, (start + length), false) != INDEX_NONE
     ) {
-        _gatewayRegistersWriteReceivedValue(nodeIndex, GATEWAY_REGISTER_AO, register_address, write_value);
-
-        // DEBUG_MSG(PSTR("[INFO][GATEWAY][REGISTERS] Value was written into AO register\n"));
+        length++;
+    }
 
-        gatewayCommunicationResetAttempts(nodeIndex);
-        
-    } else {
-        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined AO register address\n"));
+    // Adjacent run is cut by packet size, oldest value have to be included
+    if (writing[first].address >= (start + length)) {
+        start = writing[first].address;
+        length = 1;
     }
-}
 
-// -----------------------------------------------------------------------------
+    char output_content[max_packet_size];
 
-void _gatewayRegistersWriteMultipleAnalogOutputHandler(
-    const uint8_t nodeIndex,
-    uint8_t * payload
-) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
+    uint8_t content_length = 0;
 
-    word register_address = (word) payload[1] << 8 | (word) payload[2];
-    word read_length = (word) payload[3] << 8 | (word) payload[4];
-    uint8_t bytes_length = (uint8_t) payload[5];
+    output_content[1] = (char) (start >> 8);
+    output_content[2] = (char) (start & 0xFF);
 
-    if (
-        // Write start address mus be between <0, register.size()>
-        register_address < _gateway_nodes_registers[nodeIndex].analog_outputs.size()
-        // Write length have to be same or smaller as registers size
-        && (register_address + read_length) <= _gateway_nodes_registers[nodeIndex].analog_outputs.size()
-    ) {
-        // TODO: implement response handling
+    if (length == 1) {
+        if (register_type == GATEWAY_REGISTER_DO) {
+            output_content[0] = GATEWAY_PACKET_WRITE_ONE_DO;
+            output_content[3] = (char) (writing[first].value[0] ? 0xFF : 0x00);
+            output_content[4] = (char) 0x00;
 
-        gatewayCommunicationResetAttempts(nodeIndex);
+            content_length = 5;
 
-    } else {
-        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined AO registers range\n"));
-    }
-}
+        } else {
+            output_content[0] = GATEWAY_PACKET_WRITE_ONE_AO;
 
-// -----------------------------------------------------------------------------
+            memcpy(output_content + 3, writing[first].value, GATEWAY_REGISTER_ANALOG_VALUE_SIZE);
+
+            content_length = 3 + GATEWAY_REGISTER_ANALOG_VALUE_SIZE;
+        }
+
+        writing[first].sending = true;
+
+    } else {
+        uint8_t bytes_length = register_type == GATEWAY_REGISTER_DO ? ((length + 7) / 8) : (length * GATEWAY_REGISTER_ANALOG_VALUE_SIZE);
+
+        output_content[0] = register_type == GATEWAY_REGISTER_DO ? GATEWAY_PACKET_WRITE_MULTI_DO : GATEWAY_PACKET_WRITE_MULTI_AO;
+        output_content[3] = (char) (length >> 8);
+        output_content[4] = (char) (length & 0xFF);
+        output_content[5] = (char) bytes_length;
+
+        memset(output_content + 6, 0, bytes_length);
+
+        for (uint8_t i = 0; i < length; i++) {
+            gateway_register_write_t & write = writing[_gatewayRegistersFindWrite(nodeIndex, register_type, (start + i), false)];
+
+            if (register_type == GATEWAY_REGISTER_DO) {
+                if (write.value[0]) {
+                    output_content[6 + (i / 8)] |= (1 << (i % 8));
+                }
+
+            } else {
+                memcpy(output_content + 6 + (i * GATEWAY_REGISTER_ANALOG_VALUE_SIZE), write.value, GATEWAY_REGISTER_ANALOG_VALUE_SIZE);
+            }
+
+            write.sending = true;
+        }
+
+        content_length = 6 + bytes_length;
+    }
+
+    uint8_t packet_sequence;
+    bool packet_sequenced;
+
+    // Record requested packet
+    if (gatewaySendPacket(_gateway_nodes[nodeIndex].addressing.address, output_content, content_length, _gatewayRegistersWriteSentCallback, packet_sequence, packet_sequenced)) {
+        gatewayCommunicationSetWaitingPacket(nodeIndex, output_content[0], packet_sequence, packet_sequenced);
+
+    } else {
+        _gatewayRegistersReleaseUnconfirmedWrites(nodeIndex);
+    }
+
+    gatewayCommunicationIncrementAttempts(nodeIndex);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Node confirmed writing, confirmed values are stored & reported back
+ */
+void _gatewayRegistersFinishWriting(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t startAddress,
+    const uint8_t length
+) {
+    char payload[GATEWAY_REGISTER_VALUE_FORMAT_LENGTH];
+
+    for (uint8_t i = 0; i < FB_GATEWAY_WRITE_QUEUE_SIZE; i++) {
+        gateway_register_write_t & write = _gateway_nodes_details[nodeIndex]->writing[i];
 
-bool _gatewayRegistersContinueInProcess(
-    uint8_t nodeIndex
-) {
-    if (
-        // Node have to be initialized
-        gatewayInitializationIsNodeInitialized(nodeIndex) == true
-        // Check if node is not lost
-        && gatewayIsNodeLost(nodeIndex) == false
-        // Check if node is ready to communicate
-        && gatewayIsNodeReady(nodeIndex) == true
-        // And have at leas one register
-        && (
-            _gateway_nodes_registers[nodeIndex].digital_inputs.size() > 0
-            || _gateway_nodes_registers[nodeIndex].digital_outputs.size() > 0
-            || _gateway_nodes_registers[nodeIndex].analog_inputs.size() > 0
-            || _gateway_nodes_registers[nodeIndex].analog_outputs.size() > 0
-            || _gateway_nodes_registers[nodeIndex].event_inputs.size() > 0
-        )
-    ) {
         if (
-            _gateway_nodes_registers[nodeIndex].digital_inputs.size() > 0
-            && (
-                _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_DI
-                || _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_NONE
-            )
+            write.register_type != dataRegister
+            || write.sending == false
+            || write.address < startAddress
+            || write.address >= (startAddress + length)
         ) {
-            _gatewayRegistersRequestReadingMultipleDigitalInputRegisters(nodeIndex);
+            continue;
+        }
 
-            return true;
+        uint8_t size = _gatewayRegistersDataTypeSize(_gatewayRegistersGetRegisterDataType(nodeIndex, dataRegister, write.address));
 
-        } else if (
-            _gateway_nodes_registers[nodeIndex].digital_outputs.size() > 0
-            && (
-                _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_DO
-                || _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_NONE
-            )
+        if (
+            _gatewayRegistersWriteValue(nodeIndex, dataRegister, write.address, write.value, size)
+            && gatewayRegistersFormatValue(nodeIndex, dataRegister, write.address, payload)
         ) {
-            _gatewayRegistersRequestReadingMultipleDigitalOutputRegisters(nodeIndex);
+            // Confirmation is reported even when value was not changed
+            gatewayModulesRegisterValueUpdated(nodeIndex, dataRegister, write.address, payload);
 
-            return true;
+            gatewayDeadbandsValueReported(nodeIndex, dataRegister, write.address);
+        }
 
-        } else if (
-            _gateway_nodes_registers[nodeIndex].analog_inputs.size() > 0
-            && (
-                _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_AI
-                || _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_NONE
-            )
-        ) {
-            _gatewayRegistersRequestReadingMultipleAnalogInputRegisters(nodeIndex);
+        write.register_type = GATEWAY_REGISTER_NONE;
+        write.sending = false;
+    }
 
-            return true;
+    gatewayCommunicationResetAttempts(nodeIndex);
 
-        } else if (
-            _gateway_nodes_registers[nodeIndex].analog_outputs.size() > 0
-            && (
-                _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_AO
-                || _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_NONE
-            )
-        ) {
-            _gatewayRegistersRequestReadingMultipleAnalogOutputRegisters(nodeIndex);
+    // Values requested during writing are waiting
+    if (gatewayRegistersIsWriting(nodeIndex)) {
+        gatewaySchedulerRequest(nodeIndex, GATEWAY_PRIORITY_CONTROL);
+    }
+}
 
-            return true;
+// -----------------------------------------------------------------------------
+// READING HANDLERS 
+// -----------------------------------------------------------------------------
 
-        } else if (
-            _gateway_nodes_registers[nodeIndex].event_inputs.size() > 0
-            && (
-                _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_EV
-                || _gateway_nodes_registers_reading[nodeIndex].register_type == GATEWAY_REGISTER_NONE
-            )
-        ) {
-            _gatewayRegistersRequestReadingMultipleEventRegisters(nodeIndex);
+/**
+ * Store received range of one registers space, returns count of processed bytes
+ *
+ * 0    => High byte of register address
+ * 1    => Low byte of register address
+ * 2    => Count of values bytes
+ * 3-n  => DI & DO: bit-packed values, AI & AO & EV: 4 bytes per value
+ */
+uint8_t _gatewayRegistersStoreReceivedRange(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    uint8_t * block,
+    const uint8_t blockLength
+) {
+    // Range header have to be in packet
+    if (blockLength < 3) {
+        return blockLength;
+    }
 
-            return true;
+    word start_address = (word) block[0] << 8 | (word) block[1];
+
+    uint8_t bytes_length = (uint8_t) block[2];
+
+    // Values could not be read behind packet end
+    if (bytes_length > (blockLength - 3)) {
+        bytes_length = blockLength - 3;
+    }
+
+    uint8_t register_size = gatewayRegistersSize(nodeIndex, dataRegister);
+
+    // Read start address must be between <0, register.size()>
+    if (start_address >= register_size) {
+        DEBUG_MSG(
+            PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined register: %d address\n"),
+            dataRegister
+        );
+
+        return 3 + bytes_length;
+    }
+
+    if (dataRegister == GATEWAY_REGISTER_DI || dataRegister == GATEWAY_REGISTER_DO) {
+        uint16_t count = (uint16_t) bytes_length * 8;
+
+        if (count > (register_size - start_address)) {
+            count = register_size - start_address;
+        }
+
+        _gatewayRegistersStoreReceivedBits(nodeIndex, dataRegister, start_address, count, (block + 3));
+
+        // Last range of space was received
+        if ((start_address + count) >= register_size) {
+            gatewaySchedulerMarkRegisterRead(nodeIndex, dataRegister);
+        }
+
+    } else {
+        uint8_t count = bytes_length / GATEWAY_REGISTER_ANALOG_VALUE_SIZE;
+
+        if (count > (register_size - start_address)) {
+            count = register_size - start_address;
+        }
+
+        uint8_t run_start = 0;
+
+        // Values are processed in runs of registers with same datatype
+        while (run_start < count) {
+            uint8_t datatype = _gatewayRegistersGetRegisterDataType(nodeIndex, dataRegister, (start_address + run_start));
+            uint8_t run_length = 1;
+
+            while (
+                (run_start + run_length) < count
+                && _gatewayRegistersGetRegisterDataType(nodeIndex, dataRegister, (start_address + run_start + run_length)) == datatype
+            ) {
+                run_length++;
+            }
+
+            _gatewayRegistersStoreReceivedValues(
+                nodeIndex,
+                dataRegister,
+                datatype,
+                (start_address + run_start),
+                run_length,
+                (block + 3 + (run_start * GATEWAY_REGISTER_ANALOG_VALUE_SIZE)),
+                GATEWAY_REGISTER_ANALOG_VALUE_SIZE
+            );
+
+            run_start = run_start + run_length;
+        }
+
+        // Last range of space was received
+        if ((start_address + count) >= register_size) {
+            gatewaySchedulerMarkRegisterRead(nodeIndex, dataRegister);
         }
     }
 
-    return false;
+    return 3 + bytes_length;
 }
 
 // -----------------------------------------------------------------------------
-// MODULE API
+
+void _gatewayRegistersReadMultipleRegisterAddressesHandler(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    uint8_t * payload,
+    const uint8_t payloadLength
+) {
+    // Received values have to be in packet
+    if (payloadLength < 4) {
+        return;
+    }
+
+    _gatewayRegistersStoreReceivedRange(nodeIndex, dataRegister, (payload + 1), (payloadLength - 1));
+
+    gatewayCommunicationResetAttempts(nodeIndex);
+}
+
 // -----------------------------------------------------------------------------
 
-void gatewayRegistersReset(
-    const uint8_t nodeIndex
+/**
+ * Parse received payload - Combined registers reading
+ *
+ * 0    => Received packet identifier   => GATEWAY_PACKET_READ_COMBINED
+ * 1    => Count of ranges
+ * 2-n  => Ranges: registers space, high byte of address, low byte of address, count of values bytes, values
+ */
+void _gatewayRegistersReadCombinedHandler(
+    const uint8_t nodeIndex,
+    uint8_t * payload,
+    const uint8_t payloadLength
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    if (payloadLength < 2) {
         return;
     }
 
-    // Reset registers
-    _gateway_nodes_registers[nodeIndex].digital_inputs.clear();
-    _gateway_nodes_registers[nodeIndex].digital_outputs.clear();
-    _gateway_nodes_registers[nodeIndex].analog_inputs.clear();
-    _gateway_nodes_registers[nodeIndex].analog_outputs.clear();
-    _gateway_nodes_registers[nodeIndex].event_inputs.clear();
+    _gateway_nodes_details[nodeIndex]->reading.combined = GATEWAY_READING_SUPPORTED;
+    _gateway_nodes_details[nodeIndex]->reading.combined_probes = 0;
+
+    uint8_t ranges_count = payload[1];
+    uint8_t position = 2;
+
+    for (uint8_t i = 0; i < ranges_count && (position + 1) < payloadLength; i++) {
+        uint8_t data_register = payload[position];
+
+        // Validate register type index
+        if (data_register >= GATEWAY_REGISTER_MAX) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node replied with unknown registers space: %d\n"), data_register);
+
+            break;
+        }
+
+        position = position + 1 + _gatewayRegistersStoreReceivedRange(nodeIndex, data_register, (payload + position + 1), (payloadLength - position - 1));
+    }
+
+    gatewayCommunicationResetAttempts(nodeIndex);
 }
 
 // -----------------------------------------------------------------------------
 
-void gatewayRegistersResetReading(
-    const uint8_t nodeIndex
+/**
+ * Store received changes list, returns false when list is broken
+ *
+ * 0-n  => Changes: registers space, high byte of address, low byte of address, value (DI & DO: 1 byte, AI & AO & EV: 4 bytes)
+ */
+bool _gatewayRegistersStoreReceivedChanges(
+    const uint8_t nodeIndex,
+    const uint8_t changesCount,
+    uint8_t * block,
+    const uint8_t blockLength
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    uint8_t position = 0;
+
+    for (uint8_t i = 0; i < changesCount; i++) {
+        // Change header have to be in packet
+        if ((position + 3) > blockLength) {
+            return false;
+        }
+
+        uint8_t data_register = block[position];
+
+        // Validate register type index
+        if (data_register >= GATEWAY_REGISTER_MAX) {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node replied with unknown registers space: %d\n"), data_register);
+
+            return false;
+        }
+
+        word address = (word) block[position + 1] << 8 | (word) block[position + 2];
+
+        uint8_t value_length = (data_register == GATEWAY_REGISTER_DI || data_register == GATEWAY_REGISTER_DO) ? 1 : GATEWAY_REGISTER_ANALOG_VALUE_SIZE;
+
+        // Value could not be read behind packet end
+        if ((position + 3 + value_length) > blockLength) {
+            return false;
+        }
+
+        if (address < gatewayRegistersSize(nodeIndex, data_register)) {
+            if (value_length == 1) {
+                _gatewayRegistersStoreReceivedBits(nodeIndex, data_register, address, 1, (block + position + 3));
+
+            } else {
+                _gatewayRegistersStoreReceivedValues(
+                    nodeIndex,
+                    data_register,
+                    _gatewayRegistersGetRegisterDataType(nodeIndex, data_register, address),
+                    address,
+                    1,
+                    (block + position + 3),
+                    GATEWAY_REGISTER_ANALOG_VALUE_SIZE
+                );
+            }
+
+        } else {
+            DEBUG_MSG(
+                PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined register: %d address\n"),
+                data_register
+            );
+        }
+
+        position = position + 3 + value_length;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Parse received payload - Changed registers reading
+ *
+ * 0    => Received packet identifier   => GATEWAY_PACKET_READ_CHANGES
+ * 1    => High byte of node change sequence
+ * 2    => Low byte of node change sequence
+ * 3    => Count of changes             => GATEWAY_DELTA_READING_RESYNC or count with GATEWAY_DELTA_READING_MORE flag
+ * 4-n  => Changes
+ */
+void _gatewayRegistersReadChangesHandler(
+    const uint8_t nodeIndex,
+    uint8_t * payload,
+    const uint8_t payloadLength
+) {
+    if (payloadLength < 4) {
         return;
     }
 
-    _gateway_nodes_registers_reading[nodeIndex].register_type = GATEWAY_REGISTER_NONE;
-    _gateway_nodes_registers_reading[nodeIndex].start = 0;
+    _gateway_nodes_details[nodeIndex]->reading.delta = GATEWAY_READING_SUPPORTED;
+    _gateway_nodes_details[nodeIndex]->reading.delta_probes = 0;
+
+    gatewayCommunicationResetAttempts(nodeIndex);
+
+    uint16_t sequence = (uint16_t) payload[1] << 8 | (uint16_t) payload[2];
+
+    // Node could not provide changes, all spaces are read again from received sequence
+    if (payload[3] == GATEWAY_DELTA_READING_RESYNC) {
+        _gateway_nodes_details[nodeIndex]->reading.synchronized = true;
+        _gateway_nodes_details[nodeIndex]->reading.sequence = sequence;
+
+        for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+            if (gatewayRegistersSize(nodeIndex, i) > 0) {
+                gatewaySchedulerQueryRegister(nodeIndex, i);
+            }
+        }
+
+        return;
+    }
+
+    if (!_gatewayRegistersStoreReceivedChanges(nodeIndex, (payload[3] & GATEWAY_DELTA_READING_COUNT), (payload + 4), (payloadLength - 4))) {
+        return;
+    }
+
+    _gateway_nodes_details[nodeIndex]->reading.sequence = sequence;
+
+    // Remaining changes are requested immediately, spaces stay due
+    if ((payload[3] & GATEWAY_DELTA_READING_MORE) == 0) {
+        for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+            // Events queue is drained by its own reading
+            if (i == GATEWAY_REGISTER_EV && _gateway_nodes_details[nodeIndex]->events.support == GATEWAY_READING_SUPPORTED) {
+                continue;
+            }
+
+            if (gatewayRegistersSize(nodeIndex, i) > 0) {
+                gatewaySchedulerMarkRegisterPolled(nodeIndex, i);
+                gatewaySchedulerMarkRegisterRead(nodeIndex, i);
+            }
+        }
+    }
 }
 
 // -----------------------------------------------------------------------------
 
-void gatewayRegistersInitialize(
+/**
+ * Parse received payload - Changed registers pushed by node in reporting window
+ *
+ * 0    => Received packet identifier   => GATEWAY_PACKET_REPORT_CHANGES
+ * 1    => High byte of change sequence which is report following
+ * 2    => Low byte of change sequence which is report following
+ * 3    => High byte of node change sequence
+ * 4    => Low byte of node change sequence
+ * 5    => Count of changes             => count with GATEWAY_DELTA_READING_MORE flag
+ * 6-n  => Changes
+ */
+void _gatewayRegistersReportChangesHandler(
     const uint8_t nodeIndex,
-    const uint8_t dataRegister,
-    const uint8_t size
+    uint8_t * payload,
+    const uint8_t payloadLength
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    if (
+        payloadLength < 6
+        // Node have to be initialized
+        || _gateway_nodes[nodeIndex].initialization.state == false
+        // Reported changes are following last read values
+        || _gateway_nodes_details[nodeIndex]->reading.synchronized == false
+    ) {
         return;
     }
 
-    switch (dataRegister)
+    uint16_t previous_sequence = (uint16_t) payload[1] << 8 | (uint16_t) payload[2];
+    uint16_t sequence = (uint16_t) payload[3] << 8 | (uint16_t) payload[4];
+
+    // Reported values are always the latest ones & they are stored immediately
+    if (!_gatewayRegistersStoreReceivedChanges(nodeIndex, (payload[5] & GATEWAY_DELTA_READING_COUNT), (payload + 6), (payloadLength - 6))) {
+        return;
+    }
+
+    // Sequence is moved only when no change was missed, otherwise missed changes are read with next changes reading
+    if (
+        previous_sequence == _gateway_nodes_details[nodeIndex]->reading.sequence
+        && (payload[5] & GATEWAY_DELTA_READING_MORE) == 0
+    ) {
+        _gateway_nodes_details[nodeIndex]->reading.sequence = sequence;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Parse received payload - Events queue reading
+ *
+ * 0    => Received packet identifier   => GATEWAY_PACKET_READ_EVENTS
+ * 1    => Sequence of first event
+ * 2    => Count of events              => count with GATEWAY_EVENTS_READING_MORE flag
+ * 3-n  => Events in occurrence order: register address, event code, high byte of event age, low byte of event age
+ *
+ * Event age is count of ms elapsed from event until reply was sent
+ */
+void _gatewayRegistersReadEventsHandler(
+    const uint8_t nodeIndex,
+    uint8_t * payload,
+    const uint8_t payloadLength
+) {
+    if (payloadLength < 3) {
+        return;
+    }
+
+    uint32_t time = millis();
+
+    _gateway_nodes_details[nodeIndex]->events.support = GATEWAY_READING_SUPPORTED;
+    _gateway_nodes_details[nodeIndex]->events.probes = 0;
+
+    gatewayCommunicationResetAttempts(nodeIndex);
+
+    uint8_t sequence = payload[1];
+    uint8_t events_count = payload[2] & GATEWAY_EVENTS_READING_COUNT;
+
+    if (
+        _gateway_nodes_details[nodeIndex]->events.synchronized
+        && (int8_t) (sequence - _gateway_nodes_details[nodeIndex]->events.sequence) > 0
+    ) {
+        DEBUG_MSG(
+            PSTR("[ERR][GATEWAY][REGISTERS] Node dropped: %d events from its queue\n"),
+            (uint8_t) (sequence - _gateway_nodes_details[nodeIndex]->events.sequence)
+        );
+    }
+
+    char value[GATEWAY_REGISTER_VALUE_FORMAT_LENGTH];
+
+    for (uint8_t i = 0; i < events_count && (3 + (i * 4) + 4) <= payloadLength; i++) {
+        uint8_t * event = payload + 3 + (i * 4);
+
+        // Event was received in previous reply which was not acknowledged
+        if (
+            _gateway_nodes_details[nodeIndex]->events.synchronized
+            && (int8_t) ((uint8_t) (sequence + i) - _gateway_nodes_details[nodeIndex]->events.sequence) < 0
+        ) {
+            continue;
+        }
+
+        uint8_t address = event[0];
+        uint8_t code = event[1];
+        uint16_t age = (uint16_t) event[2] << 8 | (uint16_t) event[3];
+
+        if (_gatewayRegistersWriteValue(nodeIndex, GATEWAY_REGISTER_EV, address, code)) {
+            gatewaySchedulerMarkRegisterChanged(nodeIndex, GATEWAY_REGISTER_EV);
+
+            gateway_data_type_traits_t<GATEWAY_DATA_TYPE_UINT8>::format(code, value);
+
+            // Event time is reconstructed on gateway clock
+            gatewayModulesRegisterEventReceived(nodeIndex, address, value, (time - age));
+
+        } else {
+            DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined register: %d address\n"), GATEWAY_REGISTER_EV);
+        }
+    }
+
+    _gateway_nodes_details[nodeIndex]->events.synchronized = true;
+    _gateway_nodes_details[nodeIndex]->events.sequence = sequence + events_count;
+
+    // Remaining events are requested immediately, space stays due
+    if ((payload[2] & GATEWAY_EVENTS_READING_MORE) == 0) {
+        gatewaySchedulerMarkRegisterPolled(nodeIndex, GATEWAY_REGISTER_EV);
+        gatewaySchedulerMarkRegisterRead(nodeIndex, GATEWAY_REGISTER_EV);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// WRITING HANDLERS
+// -----------------------------------------------------------------------------
+
+void _gatewayRegistersWriteSingleRegisterHandler(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    uint8_t * payload
+) {
+    word register_address = (word) payload[1] << 8 | (word) payload[2];
+
+    if (
+        // Write address must be between <0, register.size()>
+        register_address < _gateway_nodes_details[nodeIndex]->registers.size[dataRegister]
+    ) {
+        _gatewayRegistersFinishWriting(nodeIndex, dataRegister, register_address, 1);
+
+    } else {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined register address\n"));
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewayRegistersWriteMultipleRegistersHandler(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    uint8_t * payload
+) {
+    word register_address = (word) payload[1] << 8 | (word) payload[2];
+    word write_length = (word) payload[3] << 8 | (word) payload[4];
+
+    if (
+        // Write start address mus be between <0, register.size()>
+        register_address < _gateway_nodes_details[nodeIndex]->registers.size[dataRegister]
+        // Write length have to be same or smaller as registers size
+        && (register_address + write_length) <= _gateway_nodes_details[nodeIndex]->registers.size[dataRegister]
+    ) {
+        _gatewayRegistersFinishWriting(nodeIndex, dataRegister, register_address, write_length);
+
+    } else {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Node is trying to write to undefined registers range\n"));
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool _gatewayRegistersContinueInProcess(
+    uint8_t nodeIndex
+) {
+    if (
+        // Node have to be initialized
+        _gateway_nodes[nodeIndex].initialization.state == false
+        // Check if node is not lost
+        || _gateway_nodes[nodeIndex].lost > 0
+        // Check if node is ready to communicate
+        || _gateway_nodes[nodeIndex].ready == false
+    ) {
+        return false;
+    }
+
+    // Node is confirming previous writing, other values are sent after confirmation
+    if (_gatewayRegistersIsWaitingForWriting(nodeIndex)) {
+        return true;
+    }
+
+    // Node did not confirm last writing, its values are written again
+    _gatewayRegistersReleaseUnconfirmedWrites(nodeIndex);
+
+    // Requested writes are sent before registers reading
+    if (gatewayRegistersIsWriting(nodeIndex)) {
+        _gatewayRegistersRequestWriting(nodeIndex);
+
+        return true;
+    }
+
+    uint8_t register_type = _gateway_nodes_details[nodeIndex]->reading.register_type;
+
+    // Node did not answer optional reading packets, they are probably not supported by its firmware
+    if (
+        _gateway_nodes_details[nodeIndex]->reading.combined == GATEWAY_READING_SUPPORT_UNKNOWN
+        && _gateway_nodes_details[nodeIndex]->reading.combined_probes >= FB_GATEWAY_READING_PROBES
+    ) {
+        _gateway_nodes_details[nodeIndex]->reading.combined = GATEWAY_READING_UNSUPPORTED;
+    }
+
+    if (
+        _gateway_nodes_details[nodeIndex]->reading.delta == GATEWAY_READING_SUPPORT_UNKNOWN
+        && _gateway_nodes_details[nodeIndex]->reading.delta_probes >= FB_GATEWAY_READING_PROBES
+    ) {
+        _gateway_nodes_details[nodeIndex]->reading.delta = GATEWAY_READING_UNSUPPORTED;
+    }
+
+    if (
+        _gateway_nodes_details[nodeIndex]->events.support == GATEWAY_READING_SUPPORT_UNKNOWN
+        && _gateway_nodes_details[nodeIndex]->events.probes >= FB_GATEWAY_READING_PROBES
+    ) {
+        _gateway_nodes_details[nodeIndex]->events.support = GATEWAY_READING_UNSUPPORTED;
+    }
+
+    // Events queue is drained before other spaces, queued events are not overwritten by last value
+    if (
+        register_type == GATEWAY_REGISTER_NONE
+        && _gateway_nodes_details[nodeIndex]->events.support != GATEWAY_READING_UNSUPPORTED
+        && gatewaySchedulerIsRegisterDue(nodeIndex, GATEWAY_REGISTER_EV, millis())
+    ) {
+        _gatewayRegistersRequestReadingEvents(nodeIndex);
+
+        return true;
+    }
+
+#if FB_GATEWAY_DELTA_READING
+    // Only changed registers are requested when no space was queried out of polling order
+    if (
+        register_type == GATEWAY_REGISTER_NONE
+        && _gateway_nodes_details[nodeIndex]->reading.delta != GATEWAY_READING_UNSUPPORTED
+        && _gateway_nodes[nodeIndex].polling.requested == 0
+        && gatewaySchedulerGetDueRegister(nodeIndex, millis()) != GATEWAY_REGISTER_NONE
+    ) {
+        _gatewayRegistersRequestReadingChanges(nodeIndex);
+
+        return true;
+    }
+#endif
+
+    // All due spaces are requested in one round trip when they fit into one reply
+    if (
+        register_type == GATEWAY_REGISTER_NONE
+        && _gateway_nodes_details[nodeIndex]->reading.combined != GATEWAY_READING_UNSUPPORTED
+        && _gatewayRegistersRequestReadingCombined(nodeIndex)
+    ) {
+        return true;
+    }
+
+    // Registers space reading is not in progress, pick the most overdue one
+    if (register_type == GATEWAY_REGISTER_NONE) {
+        register_type = gatewaySchedulerGetDueRegister(nodeIndex, millis());
+
+        if (register_type == GATEWAY_REGISTER_NONE) {
+            return false;
+        }
+
+        _gateway_nodes_details[nodeIndex]->reading.register_type = register_type;
+        _gateway_nodes_details[nodeIndex]->reading.start = 0;
+    }
+
+    switch (register_type)
     {
         case GATEWAY_REGISTER_DI:
-            _gateway_nodes_registers[nodeIndex].digital_inputs.clear();
-
-            for (uint8_t i = 0; i < size; i++) {
-                _gateway_nodes_registers[nodeIndex].digital_inputs.push_back((gateway_register_t) {
-                    GATEWAY_DATA_TYPE_BOOL,     // datatype
-                    1                           // value size
-                });
-            }
+            _gatewayRegistersRequestReadingMultipleDigitalInputRegisters(nodeIndex);
             break;
-            
-        case GATEWAY_REGISTER_DO:
-            _gateway_nodes_registers[nodeIndex].digital_outputs.clear();
 
-            for (uint8_t i = 0; i < size; i++) {
-                _gateway_nodes_registers[nodeIndex].digital_outputs.push_back((gateway_register_t) {
-                    GATEWAY_DATA_TYPE_BOOL,     // datatype
-                    1                           // value size
-                });
-            }
+        case GATEWAY_REGISTER_DO:
+            _gatewayRegistersRequestReadingMultipleDigitalOutputRegisters(nodeIndex);
             break;
 
         case GATEWAY_REGISTER_AI:
-            _gateway_nodes_registers[nodeIndex].analog_inputs.clear();
-
-            for (uint8_t i = 0; i < size; i++) {
-                _gateway_nodes_registers[nodeIndex].analog_inputs.push_back((gateway_register_t) {
-                    GATEWAY_DATA_TYPE_UNKNOWN,  // datatype
-                    0                           // value size
-                });
-            }
+            _gatewayRegistersRequestReadingMultipleAnalogInputRegisters(nodeIndex);
             break;
-            
-        case GATEWAY_REGISTER_AO:
-            _gateway_nodes_registers[nodeIndex].analog_outputs.clear();
 
-            for (uint8_t i = 0; i < size; i++) {
-                _gateway_nodes_registers[nodeIndex].analog_outputs.push_back((gateway_register_t) {
-                    GATEWAY_DATA_TYPE_UNKNOWN,  // datatype
-                    0                           // value size
-                });
-            }
+        case GATEWAY_REGISTER_AO:
+            _gatewayRegistersRequestReadingMultipleAnalogOutputRegisters(nodeIndex);
             break;
-            
+
         case GATEWAY_REGISTER_EV:
-            _gateway_nodes_registers[nodeIndex].event_inputs.clear();
+            _gatewayRegistersRequestReadingMultipleEventRegisters(nodeIndex);
+            break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// MODULE API
+// -----------------------------------------------------------------------------
+
+void gatewayRegistersReset(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
+
+    // Release registers arena
+    if (registers.arena != NULL) {
+        delete[] registers.arena;
+
+        registers.arena = NULL;
+    }
+
+    gatewayDeadbandsReset(nodeIndex);
+
+    for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+        registers.size[i] = 0;
+        registers.offset[i] = 0;
+    }
 
-            for (uint8_t i = 0; i < size; i++) {
-                _gateway_nodes_registers[nodeIndex].event_inputs.push_back((gateway_register_t) {
-                    GATEWAY_DATA_TYPE_UINT8,    // datatype
-                    1                           // value size
-                });
-            }
-            break;
+    // Waiting values belong to previous registers structure
+    for (uint8_t i = 0; i < FB_GATEWAY_WRITE_QUEUE_SIZE; i++) {
+        _gateway_nodes_details[nodeIndex]->writing[i].register_type = GATEWAY_REGISTER_NONE;
+        _gateway_nodes_details[nodeIndex]->writing[i].sending = false;
     }
 }
 
 // -----------------------------------------------------------------------------
 
-void gatewayRegistersInitializeDigitalInputs(
-    const uint8_t nodeIndex,
-    const uint8_t size
+void gatewayRegistersResetReading(
+    const uint8_t nodeIndex
 ) {
-    gatewayRegistersInitialize(nodeIndex, GATEWAY_REGISTER_DI, size);
+    // Not used slot shares details placeholder
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
+        return;
+    }
+
+    _gateway_nodes_details[nodeIndex]->reading.register_type = GATEWAY_REGISTER_NONE;
+    _gateway_nodes_details[nodeIndex]->reading.start = 0;
+    _gateway_nodes_details[nodeIndex]->reading.combined = GATEWAY_READING_SUPPORT_UNKNOWN;
+    _gateway_nodes_details[nodeIndex]->reading.combined_probes = 0;
+    _gateway_nodes_details[nodeIndex]->reading.delta = GATEWAY_READING_SUPPORT_UNKNOWN;
+    _gateway_nodes_details[nodeIndex]->reading.delta_probes = 0;
+    _gateway_nodes_details[nodeIndex]->reading.synchronized = false;
+    _gateway_nodes_details[nodeIndex]->reading.sequence = 0;
+    _gateway_nodes_details[nodeIndex]->events.support = GATEWAY_READING_SUPPORT_UNKNOWN;
+    _gateway_nodes_details[nodeIndex]->events.probes = 0;
+    _gateway_nodes_details[nodeIndex]->events.synchronized = false;
+    _gateway_nodes_details[nodeIndex]->events.sequence = 0;
 }
 
 // -----------------------------------------------------------------------------
 
-void gatewayRegistersInitializeDigitalOutputs(
+void gatewayRegistersInitialize(
     const uint8_t nodeIndex,
-    const uint8_t size
+    const uint8_t digitalInputs,
+    const uint8_t digitalOutputs,
+    const uint8_t analogInputs,
+    const uint8_t analogOutputs,
+    const uint8_t eventInputs
 ) {
-    gatewayRegistersInitialize(nodeIndex, GATEWAY_REGISTER_DO, size);
-}
+    // Not used slot registers could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
+        return;
+    }
 
-// -----------------------------------------------------------------------------
+    // Release previous registers structure
+    gatewayRegistersReset(nodeIndex);
 
-void gatewayRegistersInitializeAnalogInputs(
-    const uint8_t nodeIndex,
-    const uint8_t size
-) {
-    gatewayRegistersInitialize(nodeIndex, GATEWAY_REGISTER_AI, size);
-}
+    gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
 
-// -----------------------------------------------------------------------------
+    registers.size[GATEWAY_REGISTER_DI] = digitalInputs;
+    registers.size[GATEWAY_REGISTER_DO] = digitalOutputs;
+    registers.size[GATEWAY_REGISTER_AI] = analogInputs;
+    registers.size[GATEWAY_REGISTER_AO] = analogOutputs;
+    registers.size[GATEWAY_REGISTER_EV] = eventInputs;
 
-void gatewayRegistersInitializeAnalogOutputs(
-    const uint8_t nodeIndex,
-    const uint8_t size
-) {
-    gatewayRegistersInitialize(nodeIndex, GATEWAY_REGISTER_AO, size);
-}
+    uint16_t length = 0;
 
-// -----------------------------------------------------------------------------
+    for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+        registers.offset[i] = length;
 
-void gatewayRegistersInitializeEventInputs(
-    const uint8_t nodeIndex,
-    const uint8_t size
-) {
-    gatewayRegistersInitialize(nodeIndex, GATEWAY_REGISTER_EV, size);
+        length = length + _gatewayRegistersSpaceLength(i, registers.size[i]);
+    }
+
+    if (length == 0) {
+        return;
+    }
+
+    registers.arena = new uint8_t[length]();
+
+    if (registers.arena == NULL) {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Not enough memory for node registers\n"));
+
+        gatewayRegistersReset(nodeIndex);
+
+        return;
+    }
+
+    // Analog registers datatypes are received in next initialization steps
+    memset(registers.arena + registers.offset[GATEWAY_REGISTER_AI], GATEWAY_DATA_TYPE_UNKNOWN, registers.size[GATEWAY_REGISTER_AI]);
+    memset(registers.arena + registers.offset[GATEWAY_REGISTER_AO], GATEWAY_DATA_TYPE_UNKNOWN, registers.size[GATEWAY_REGISTER_AO]);
+
+    gatewayDeadbandsInitialize(nodeIndex);
 }
 
 // -----------------------------------------------------------------------------
@@ -1392,25 +1969,12 @@ uint8_t gatewayRegistersSize(
         return 0;
     }
 
-    switch (dataRegister)
-    {
-        case GATEWAY_REGISTER_DI:
-            return _gateway_nodes_registers[nodeIndex].digital_inputs.size();
-            
-        case GATEWAY_REGISTER_DO:
-            return _gateway_nodes_registers[nodeIndex].digital_outputs.size();
-
-        case GATEWAY_REGISTER_AI:
-            return _gateway_nodes_registers[nodeIndex].analog_inputs.size();
-            
-        case GATEWAY_REGISTER_AO:
-            return _gateway_nodes_registers[nodeIndex].analog_outputs.size();
-            
-        case GATEWAY_REGISTER_EV:
-            return _gateway_nodes_registers[nodeIndex].event_inputs.size();
+    // Validate register type index
+    if (dataRegister >= GATEWAY_REGISTER_MAX) {
+        return 0;
     }
 
-    return 0;
+    return _gateway_nodes_details[nodeIndex]->registers.size[dataRegister];
 }
 
 // -----------------------------------------------------------------------------
@@ -1461,79 +2025,29 @@ void gatewayRegistersSetDataType(
     const uint8_t address,
     const uint8_t datatype
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+    // Not used slot registers could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
         return;
     }
 
-    uint8_t size = 0;
-
-    switch (datatype)
-    {
-        case GATEWAY_DATA_TYPE_UINT8:
-            size = 1;
-            break;
-
-        case GATEWAY_DATA_TYPE_INT8:
-            size = 1;
-            break;
-
-        case GATEWAY_DATA_TYPE_UINT16:
-            size = 2;
-            break;
-
-        case GATEWAY_DATA_TYPE_INT16:
-            size = 2;
-            break;
-
-        case GATEWAY_DATA_TYPE_UINT32:
-            size = 4;
-            break;
-
-        case GATEWAY_DATA_TYPE_INT32:
-            size = 4;
-            break;
-
-        case GATEWAY_DATA_TYPE_FLOAT32:
-            size = 4;
-            break;
-
-        default:
-            return; 
+    // Check for valid analog datatype
+    if (
+        datatype == GATEWAY_DATA_TYPE_BOOL
+        || _gatewayRegistersDataTypeSize(datatype) == 0
+    ) {
+        return;
     }
 
-    // Check for valid datatype size    
-    if (size == 0) {
+    // Only analog registers have configurable datatype
+    if (dataRegister != GATEWAY_REGISTER_AI && dataRegister != GATEWAY_REGISTER_AO) {
         return;
     }
 
-    switch (dataRegister)
-    {
-        case GATEWAY_REGISTER_DI:
-            _gateway_nodes_registers[nodeIndex].digital_inputs[address].datatype = datatype;
-            _gateway_nodes_registers[nodeIndex].digital_inputs[address].size = size;
-            break;
-
-        case GATEWAY_REGISTER_DO:
-            _gateway_nodes_registers[nodeIndex].digital_outputs[address].datatype = datatype;
-            _gateway_nodes_registers[nodeIndex].digital_outputs[address].size = size;
-            break;
-
-        case GATEWAY_REGISTER_AI:
-            _gateway_nodes_registers[nodeIndex].analog_inputs[address].datatype = datatype;
-            _gateway_nodes_registers[nodeIndex].analog_inputs[address].size = size;
-            break;
-            
-        case GATEWAY_REGISTER_AO:
-            _gateway_nodes_registers[nodeIndex].analog_outputs[address].datatype = datatype;
-            _gateway_nodes_registers[nodeIndex].analog_outputs[address].size = size;
-            break;
-            
-        case GATEWAY_REGISTER_EV:
-            _gateway_nodes_registers[nodeIndex].event_inputs[address].datatype = datatype;
-            _gateway_nodes_registers[nodeIndex].event_inputs[address].size = size;
-            break;
+    if (_gatewayRegistersIsAddressCorrect(nodeIndex, dataRegister, address) == false) {
+        return;
     }
+
+    _gateway_nodes_details[nodeIndex]->registers.arena[_gateway_nodes_details[nodeIndex]->registers.offset[dataRegister] + address] = datatype;
 }
 
 // -----------------------------------------------------------------------------
@@ -1565,29 +2079,14 @@ void gatewayRegistersReadValue(
     void * value,
     const uint8_t size
 ) {
-    // Validate node index
-    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
-        return;
-    }
-
-    if (
-        _gatewayRegistersIsAddressCorrect(nodeIndex, dataRegister, address)
-        && _gatewayRegistersIsSizeCorrect(nodeIndex, dataRegister, address, size)
-    ) {
-        if (dataRegister == GATEWAY_REGISTER_DI) {
-            memcpy(value, _gateway_nodes_registers[nodeIndex].digital_inputs[address].value, size);
-
-        } else if (dataRegister == GATEWAY_REGISTER_DO) {
-            memcpy(value, _gateway_nodes_registers[nodeIndex].digital_outputs[address].value, size);
-
-        } else if (dataRegister == GATEWAY_REGISTER_AI) {
-            memcpy(value, _gateway_nodes_registers[nodeIndex].analog_inputs[address].value, size);
+    if (_gatewayRegistersIsSizeCorrect(nodeIndex, dataRegister, address, size)) {
+        gateway_registers_t & registers = _gateway_nodes_details[nodeIndex]->registers;
 
-        } else if (dataRegister == GATEWAY_REGISTER_AO) {
-            memcpy(value, _gateway_nodes_registers[nodeIndex].analog_outputs[address].value, size);
+        if (dataRegister == GATEWAY_REGISTER_DI || dataRegister == GATEWAY_REGISTER_DO) {
+            *((bool *) value) = (registers.arena[registers.offset[dataRegister] + (address / 8)] >> (address % 8)) & 0x01;
 
-        } else if (dataRegister == GATEWAY_REGISTER_EV) {
-            memcpy(value, _gateway_nodes_registers[nodeIndex].event_inputs[address].value, size);
+        } else {
+            memcpy(value, _gatewayRegistersValuePointer(nodeIndex, dataRegister, address), size);
         }
 
         return;
@@ -1612,9 +2111,180 @@ void gatewayRegistersReadValue(const uint8_t nodeIndex, const uint8_t dataRegist
 
 // -----------------------------------------------------------------------------
 
-bool gatewayRegistersHandler(
-    const uint8_t packetId,
+/**
+ * Queue value for writing into DO or AO register, waiting value of same register is replaced
+ */
+bool gatewayRegistersWrite(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address,
+    const char * payload
+) {
+    // Only output registers could be written
+    if (dataRegister != GATEWAY_REGISTER_DO && dataRegister != GATEWAY_REGISTER_AO) {
+        return false;
+    }
+
+    if (!gatewayIsNodeAllocated(nodeIndex) || !_gatewayRegistersIsAddressCorrect(nodeIndex, dataRegister, address)) {
+        return false;
+    }
+
+    uint8_t value[GATEWAY_REGISTER_ANALOG_VALUE_SIZE] = { 0 };
+
+    if (!_gatewayRegistersParsePayload(nodeIndex, dataRegister, address, payload, value)) {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Provided unknown data type for writing into register\n"));
+
+        return false;
+    }
+
+    uint8_t position = _gatewayRegistersFindWrite(nodeIndex, dataRegister, address, false);
+
+    // Register has no waiting value, take free entry
+    if (position == INDEX_NONE) {
+        for (uint8_t i = 0; i < FB_GATEWAY_WRITE_QUEUE_SIZE && position == INDEX_NONE; i++) {
+            if (_gateway_nodes_details[nodeIndex]->writing[i].register_type == GATEWAY_REGISTER_NONE) {
+                position = i;
+            }
+        }
+    }
+
+    if (position == INDEX_NONE) {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY][REGISTERS] Writing queue of node is full\n"));
+
+        return false;
+    }
+
+    gateway_register_write_t & write = _gateway_nodes_details[nodeIndex]->writing[position];
+
+    write.register_type = dataRegister;
+    write.address = address;
+    write.sending = false;
+
+    memcpy(write.value, value, GATEWAY_REGISTER_ANALOG_VALUE_SIZE);
+
+    return gatewaySchedulerRequest(nodeIndex, GATEWAY_PRIORITY_CONTROL);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if node has values waiting for writing
+ */
+bool gatewayRegistersIsWriting(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < FB_GATEWAY_WRITE_QUEUE_SIZE; i++) {
+        if (
+            _gateway_nodes_details[nodeIndex]->writing[i].register_type != GATEWAY_REGISTER_NONE
+            && _gateway_nodes_details[nodeIndex]->writing[i].sending == false
+        ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Format register value as text, returns false when register datatype is not known
+ */
+bool gatewayRegistersFormatValue(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
     const uint8_t address,
+    char * buffer
+) {
+    switch (_gatewayRegistersGetRegisterDataType(nodeIndex, dataRegister, address))
+    {
+        case GATEWAY_DATA_TYPE_BOOL:
+            _gatewayRegistersFormatStoredValue<GATEWAY_DATA_TYPE_BOOL>(nodeIndex, dataRegister, address, buffer);
+            return true;
+
+        case GATEWAY_DATA_TYPE_UINT8:
+            _gatewayRegistersFormatStoredValue<GATEWAY_DATA_TYPE_UINT8>(nodeIndex, dataRegister, address, buffer);
+            return true;
+
+        case GATEWAY_DATA_TYPE_UINT16:
+            _gatewayRegistersFormatStoredValue<GATEWAY_DATA_TYPE_UINT16>(nodeIndex, dataRegister, address, buffer);
+            return true;
+
+        case GATEWAY_DATA_TYPE_UINT32:
+            _gatewayRegistersFormatStoredValue<GATEWAY_DATA_TYPE_UINT32>(nodeIndex, dataRegister, address, buffer);
+            return true;
+
+        case GATEWAY_DATA_TYPE_INT8:
+            _gatewayRegistersFormatStoredValue<GATEWAY_DATA_TYPE_INT8>(nodeIndex, dataRegister, address, buffer);
+            return true;
+
+        case GATEWAY_DATA_TYPE_INT16:
+            _gatewayRegistersFormatStoredValue<GATEWAY_DATA_TYPE_INT16>(nodeIndex, dataRegister, address, buffer);
+            return true;
+
+        case GATEWAY_DATA_TYPE_INT32:
+            _gatewayRegistersFormatStoredValue<GATEWAY_DATA_TYPE_INT32>(nodeIndex, dataRegister, address, buffer);
+            return true;
+
+        case GATEWAY_DATA_TYPE_FLOAT32:
+            _gatewayRegistersFormatStoredValue<GATEWAY_DATA_TYPE_FLOAT32>(nodeIndex, dataRegister, address, buffer);
+            return true;
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Stored register value converted to number, 0 when register datatype is not known
+ */
+float gatewayRegistersReadNumericValue(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint8_t address
+) {
+    switch (_gatewayRegistersGetRegisterDataType(nodeIndex, dataRegister, address))
+    {
+        case GATEWAY_DATA_TYPE_BOOL:
+            return _gatewayRegistersStoredNumericValue<GATEWAY_DATA_TYPE_BOOL>(nodeIndex, dataRegister, address);
+
+        case GATEWAY_DATA_TYPE_UINT8:
+            return _gatewayRegistersStoredNumericValue<GATEWAY_DATA_TYPE_UINT8>(nodeIndex, dataRegister, address);
+
+        case GATEWAY_DATA_TYPE_UINT16:
+            return _gatewayRegistersStoredNumericValue<GATEWAY_DATA_TYPE_UINT16>(nodeIndex, dataRegister, address);
+
+        case GATEWAY_DATA_TYPE_UINT32:
+            return _gatewayRegistersStoredNumericValue<GATEWAY_DATA_TYPE_UINT32>(nodeIndex, dataRegister, address);
+
+        case GATEWAY_DATA_TYPE_INT8:
+            return _gatewayRegistersStoredNumericValue<GATEWAY_DATA_TYPE_INT8>(nodeIndex, dataRegister, address);
+
+        case GATEWAY_DATA_TYPE_INT16:
+            return _gatewayRegistersStoredNumericValue<GATEWAY_DATA_TYPE_INT16>(nodeIndex, dataRegister, address);
+
+        case GATEWAY_DATA_TYPE_INT32:
+            return _gatewayRegistersStoredNumericValue<GATEWAY_DATA_TYPE_INT32>(nodeIndex, dataRegister, address);
+
+        case GATEWAY_DATA_TYPE_FLOAT32:
+            return _gatewayRegistersStoredNumericValue<GATEWAY_DATA_TYPE_FLOAT32>(nodeIndex, dataRegister, address);
+    }
+
+    return 0;
+}
+
+// -----------------------------------------------------------------------------
+
+void gatewayRegistersHandler(
+    const uint8_t packetId,
+    const uint8_t nodeIndex,
+    const uint8_t senderAddress,
     uint8_t * payload,
     const uint8_t payloadLength
 ) {
@@ -1630,7 +2300,7 @@ bool gatewayRegistersHandler(
             break;
 
         case GATEWAY_PACKET_READ_MULTI_DI:
-            _gatewayRegistersReadMultipleRegisterAddressesHandler((address - 1), GATEWAY_REGISTER_DI, payload);
+            _gatewayRegistersReadMultipleRegisterAddressesHandler(nodeIndex, GATEWAY_REGISTER_DI, payload, payloadLength);
             break;
 
         case GATEWAY_PACKET_READ_SINGLE_DO:
@@ -1638,7 +2308,7 @@ bool gatewayRegistersHandler(
             break;
 
         case GATEWAY_PACKET_READ_MULTI_DO:
-            _gatewayRegistersReadMultipleRegisterAddressesHandler((address - 1), GATEWAY_REGISTER_DO, payload);
+            _gatewayRegistersReadMultipleRegisterAddressesHandler(nodeIndex, GATEWAY_REGISTER_DO, payload, payloadLength);
             break;
 
     /**
@@ -1650,7 +2320,7 @@ bool gatewayRegistersHandler(
             break;
 
         case GATEWAY_PACKET_READ_MULTI_AI:
-            _gatewayRegistersReadMultipleRegisterAddressesHandler((address - 1), GATEWAY_REGISTER_AI, payload);
+            _gatewayRegistersReadMultipleRegisterAddressesHandler(nodeIndex, GATEWAY_REGISTER_AI, payload, payloadLength);
             break;
 
         case GATEWAY_PACKET_READ_SINGLE_AO:
@@ -1658,7 +2328,7 @@ bool gatewayRegistersHandler(
             break;
 
         case GATEWAY_PACKET_READ_MULTI_AO:
-            _gatewayRegistersReadMultipleRegisterAddressesHandler((address - 1), GATEWAY_REGISTER_AO, payload);
+            _gatewayRegistersReadMultipleRegisterAddressesHandler(nodeIndex, GATEWAY_REGISTER_AO, payload, payloadLength);
             break;
 
     /**
@@ -1670,7 +2340,35 @@ bool gatewayRegistersHandler(
             break;
 
         case GATEWAY_PACKET_READ_MULTI_EV:
-            _gatewayRegistersReadMultipleRegisterAddressesHandler((address - 1), GATEWAY_REGISTER_EV, payload);
+            _gatewayRegistersReadMultipleRegisterAddressesHandler(nodeIndex, GATEWAY_REGISTER_EV, payload, payloadLength);
+            break;
+
+    /**
+     * COMBINED REGISTERS READING
+     */
+
+        case GATEWAY_PACKET_READ_COMBINED:
+            _gatewayRegistersReadCombinedHandler(nodeIndex, payload, payloadLength);
+            break;
+
+        case GATEWAY_PACKET_READ_CHANGES:
+            _gatewayRegistersReadChangesHandler(nodeIndex, payload, payloadLength);
+            break;
+
+    /**
+     * REGISTERS REPORTING
+     */
+
+        case GATEWAY_PACKET_REPORT_CHANGES:
+            _gatewayRegistersReportChangesHandler(nodeIndex, payload, payloadLength);
+            break;
+
+    /**
+     * EVENTS QUEUE READING
+     */
+
+        case GATEWAY_PACKET_READ_EVENTS:
+            _gatewayRegistersReadEventsHandler(nodeIndex, payload, payloadLength);
             break;
 
     /**
@@ -1678,11 +2376,11 @@ bool gatewayRegistersHandler(
      */
 
         case GATEWAY_PACKET_WRITE_ONE_DO:
-            _gatewayRegistersWriteSingleDigitalOutputHandler((address - 1), payload);
+            _gatewayRegistersWriteSingleRegisterHandler(nodeIndex, GATEWAY_REGISTER_DO, payload);
             break;
 
         case GATEWAY_PACKET_WRITE_MULTI_DO:
-            _gatewayRegistersWriteMultipleDigitalOutputHandler((address - 1), payload);
+            _gatewayRegistersWriteMultipleRegistersHandler(nodeIndex, GATEWAY_REGISTER_DO, payload);
             break;
 
     /**
@@ -1690,18 +2388,13 @@ bool gatewayRegistersHandler(
      */
 
         case GATEWAY_PACKET_WRITE_ONE_AO:
-            _gatewayRegistersWriteSingleAnalogOutputHandler((address - 1), payload);
+            _gatewayRegistersWriteSingleRegisterHandler(nodeIndex, GATEWAY_REGISTER_AO, payload);
             break;
 
         case GATEWAY_PACKET_WRITE_MULTI_AO:
-            _gatewayRegistersWriteMultipleAnalogOutputHandler((address - 1), payload);
+            _gatewayRegistersWriteMultipleRegistersHandler(nodeIndex, GATEWAY_REGISTER_AO, payload);
             break;
-
-        default:
-            return false;
     }
-
-    return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,173 @@
+/*
+
+GATEWAY MODULE - NODES REPORTING
+
+Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
+
+Communication sequence:
+-----------------------
+ 1. Gateway send broadcast packet GATEWAY_PACKET_REPORT_WINDOW with list of nodes addresses
+ 2. Node with changed registers send GATEWAY_PACKET_REPORT_CHANGES in its slot
+ 3. Gateway store reported values immediately, node without changes stays silent
+
+Bus arbitration:
+----------------
+Nodes are not allowed to transmit on their own. Window is opened only when no
+request is waiting for reply and timed jobs are not sent until window is
+closed. Slot of node is given by position of its address in window broadcast,
+so reports of listed nodes could not collide.
+
+Only nodes which are answering changes reading are listed, reports are using
+the same change sequence. When there are more such nodes than slots, next
+window continues with nodes which were not listed.
+
+*/
+
+#if FB_GATEWAY_SUPPORT
+
+uint8_t _gateway_reporting_state = GATEWAY_REPORT_STATE_IDLE;
+uint32_t _gateway_reporting_window = 0;
+
+uint8_t _gateway_reporting_slots = 0;
+uint8_t _gateway_reporting_cursor = 0;
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE PRIVATE
+// -----------------------------------------------------------------------------
+
+bool _gatewayReportingIsReporter(
+    const uint8_t nodeIndex
+) {
+    return (
+        // Check if node has finished addressing procedure
+        _gateway_nodes[nodeIndex].addressing.address != PJON_NOT_ASSIGNED
+        // Node have to be initialized
+        && _gateway_nodes[nodeIndex].initialization.state == true
+        // Check if node is not lost
+        && _gateway_nodes[nodeIndex].lost == 0
+        // Check if node is ready to communicate
+        && _gateway_nodes[nodeIndex].ready == true
+        // Reports are applied on synchronized changes sequence only
+        && _gateway_nodes_details[nodeIndex]->reading.delta == GATEWAY_READING_SUPPORTED
+        && _gateway_nodes_details[nodeIndex]->reading.synchronized == true
+    );
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Gateway opening slots for nodes reports
+ *
+ * PAYLOAD:
+ * 0    => Packet identifier    => GATEWAY_PACKET_REPORT_WINDOW
+ * 1    => Slot length          => 0-255 ms
+ * 2    => Slots count          => 1-FB_GATEWAY_REPORT_SLOTS_MAX
+ * 3-n  => Nodes addresses in slots order
+ */
+void _gatewayReportingOpenWindow()
+{
+    char output_content[3 + FB_GATEWAY_REPORT_SLOTS_MAX];
+
+    output_content[0] = GATEWAY_PACKET_REPORT_WINDOW;
+    output_content[1] = (uint8_t) FB_GATEWAY_REPORT_SLOT_LENGTH;
+
+    uint8_t slots = 0;
+    uint8_t node_index = _gateway_reporting_cursor;
+
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES && slots < FB_GATEWAY_REPORT_SLOTS_MAX; i++) {
+        if (_gatewayReportingIsReporter(node_index)) {
+            output_content[3 + slots] = (char) _gateway_nodes[node_index].addressing.address;
+
+            slots++;
+        }
+
+        node_index = (node_index + 1) % FB_GATEWAY_MAX_NODES;
+    }
+
+    // Nobody could report
+    if (slots == 0) {
+        _gateway_reporting_window = millis();
+
+        return;
+    }
+
+    output_content[2] = (char) slots;
+
+    if (gatewayBroadcastPacket(output_content, (3 + slots), _gatewayReportingWindowSentCallback)) {
+        _gateway_reporting_slots = slots;
+        _gateway_reporting_cursor = node_index;
+        _gateway_reporting_window = millis();
+        _gateway_reporting_state = GATEWAY_REPORT_STATE_COLLECTING;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Window broadcast left bus queue, reports slots start now
+ */
+void _gatewayReportingWindowSentCallback(
+    const uint8_t nodeIndex,
+    const uint8_t packetId,
+    const uint8_t result
+) {
+    if (_gateway_reporting_state != GATEWAY_REPORT_STATE_COLLECTING) {
+        return;
+    }
+
+    _gateway_reporting_window = millis();
+
+    if (result != GATEWAY_SEND_SUCCESS) {
+        // Broadcast was not transmitted, nodes could not report
+        _gateway_reporting_state = GATEWAY_REPORT_STATE_IDLE;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE API
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if gateway is collecting nodes reports
+ */
+bool gatewayReportingIsCollecting()
+{
+    return _gateway_reporting_state == GATEWAY_REPORT_STATE_COLLECTING;
+}
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE CORE
+// -----------------------------------------------------------------------------
+
+void gatewayReportingLoop()
+{
+    #if FB_GATEWAY_REPORT_INTERVAL > 0
+        switch (_gateway_reporting_state)
+        {
+            // Open window when bus is quiet & no requested job is waiting
+            case GATEWAY_REPORT_STATE_IDLE:
+                if (
+                    (millis() - _gateway_reporting_window) >= FB_GATEWAY_REPORT_INTERVAL
+                    && !gatewaySchedulerHasRequests()
+                    && !gatewayCommunicationHasInFlight()
+                    && !gatewayAddressingIsCollecting()
+                ) {
+                    _gatewayReportingOpenWindow();
+                }
+                break;
+
+            // Nodes reports are processed by standard receive handler
+            case GATEWAY_REPORT_STATE_COLLECTING:
+                if ((millis() - _gateway_reporting_window) >= ((uint32_t) _gateway_reporting_slots * FB_GATEWAY_REPORT_SLOT_LENGTH + FB_GATEWAY_RESPONSE_TIMEOUT)) {
+                    _gateway_reporting_window = millis();
+                    _gateway_reporting_state = GATEWAY_REPORT_STATE_IDLE;
+                }
+                break;
+
+            default:
+                break;
+        }
+    #endif
+}
+
+#endif // FB_GATEWAY_SUPPORT
@@ -0,0 +1,640 @@
+/*
+
+GATEWAY MODULE - NODES SCHEDULER
+
+Copyright (C) 2018 FastyBird Ltd. <info@fastybird.com>
+
+Every node slot is stored in min-heap ordered by timestamp when the node has
+to be processed next time. Gateway loop is processing only the most overdue
+node, so node processing rate does not depend on its slot position or on
+activity of other nodes.
+
+Priority classes:
+-----------------
+Control writes & queries requested by user are not waiting in heap. Requested
+nodes are queued in FIFO of their class and served before any timed job, control
+class strictly before queries. Timed jobs (polling, checking, initialization)
+could occupy only part of requests in flight table, rest is reserved for
+requested jobs. Discovery is the lowest class, new searching round is started
+only when no requested job is waiting.
+
+Adaptive polling:
+-----------------
+Each registers space starts with its default interval, which is also the
+fastest one. Every polling without value change makes the interval longer
+up to FB_GATEWAY_POLL_INTERVAL_MAX. Any change snaps the space back to its
+fastest interval immediately, so busy spaces get most of the bus.
+
+*/
+
+#if FB_GATEWAY_SUPPORT
+
+gateway_scheduler_job_t _gateway_scheduler_heap[FB_GATEWAY_MAX_NODES];
+
+// Position of node job in heap, used for rescheduling
+uint8_t _gateway_scheduler_heap_position[FB_GATEWAY_MAX_NODES];
+
+// Nodes with requested jobs, FIFO for each requested priority class
+uint8_t _gateway_scheduler_requests[GATEWAY_PRIORITY_REQUESTED][FB_GATEWAY_REQUESTS_QUEUE_SIZE];
+uint8_t _gateway_scheduler_requests_head[GATEWAY_PRIORITY_REQUESTED] = { 0 };
+uint8_t _gateway_scheduler_requests_count[GATEWAY_PRIORITY_REQUESTED] = { 0 };
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE PRIVATE
+// -----------------------------------------------------------------------------
+
+/**
+ * Compare two timestamps with millis() overflow in mind
+ */
+bool _gatewaySchedulerIsBefore(
+    const uint32_t time,
+    const uint32_t compareTime
+) {
+    return (int32_t) (time - compareTime) < 0;
+}
+
+// -----------------------------------------------------------------------------
+
+uint16_t _gatewaySchedulerDefaultPollInterval(
+    const uint8_t dataRegister
+) {
+    switch (dataRegister)
+    {
+        case GATEWAY_REGISTER_DI:
+            return FB_GATEWAY_POLL_INTERVAL_DI;
+
+        case GATEWAY_REGISTER_DO:
+            return FB_GATEWAY_POLL_INTERVAL_DO;
+
+        case GATEWAY_REGISTER_AI:
+            return FB_GATEWAY_POLL_INTERVAL_AI;
+
+        case GATEWAY_REGISTER_AO:
+            return FB_GATEWAY_POLL_INTERVAL_AO;
+
+        case GATEWAY_REGISTER_EV:
+            return FB_GATEWAY_POLL_INTERVAL_EV;
+    }
+
+    return FB_GATEWAY_IDLE_INTERVAL;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Learn next polling interval of registers space from last polling result
+ */
+void _gatewaySchedulerAdaptPollInterval(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister
+) {
+    uint16_t fastest = _gatewaySchedulerDefaultPollInterval(dataRegister);
+
+    if (_gateway_nodes[nodeIndex].polling.changed & (1 << dataRegister)) {
+        _gateway_nodes_details[nodeIndex]->poll_interval[dataRegister] = fastest;
+
+    } else {
+        uint32_t interval = _gateway_nodes_details[nodeIndex]->poll_interval[dataRegister];
+
+        interval = interval + ((interval * FB_GATEWAY_POLL_INTERVAL_GROWTH) / 100);
+
+        if (interval > FB_GATEWAY_POLL_INTERVAL_MAX) {
+            interval = FB_GATEWAY_POLL_INTERVAL_MAX;
+        }
+
+        if (interval < fastest) {
+            interval = fastest;
+        }
+
+        _gateway_nodes_details[nodeIndex]->poll_interval[dataRegister] = (uint16_t) interval;
+    }
+
+    _gateway_nodes[nodeIndex].polling.changed &= ~(1 << dataRegister);
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewaySchedulerSwap(
+    const uint8_t position,
+    const uint8_t swapPosition
+) {
+    gateway_scheduler_job_t job = _gateway_scheduler_heap[position];
+
+    _gateway_scheduler_heap[position] = _gateway_scheduler_heap[swapPosition];
+    _gateway_scheduler_heap[swapPosition] = job;
+
+    _gateway_scheduler_heap_position[_gateway_scheduler_heap[position].node_index] = position;
+    _gateway_scheduler_heap_position[_gateway_scheduler_heap[swapPosition].node_index] = swapPosition;
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewaySchedulerSiftUp(
+    uint8_t position
+) {
+    while (position > 0) {
+        uint8_t parent = (position - 1) / 2;
+
+        if (!_gatewaySchedulerIsBefore(_gateway_scheduler_heap[position].due, _gateway_scheduler_heap[parent].due)) {
+            return;
+        }
+
+        _gatewaySchedulerSwap(position, parent);
+
+        position = parent;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void _gatewaySchedulerSiftDown(
+    uint8_t position
+) {
+    while (true) {
+        uint8_t smallest = position;
+        uint16_t left = (2 * position) + 1;
+        uint16_t right = (2 * position) + 2;
+
+        if (
+            left < FB_GATEWAY_MAX_NODES
+            && _gatewaySchedulerIsBefore(_gateway_scheduler_heap[left].due, _gateway_scheduler_heap[smallest].due)
+        ) {
+            smallest = left;
+        }
+
+        if (
+            right < FB_GATEWAY_MAX_NODES
+            && _gatewaySchedulerIsBefore(_gateway_scheduler_heap[right].due, _gateway_scheduler_heap[smallest].due)
+        ) {
+            smallest = right;
+        }
+
+        if (smallest == position) {
+            return;
+        }
+
+        _gatewaySchedulerSwap(position, smallest);
+
+        position = smallest;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE API
+// -----------------------------------------------------------------------------
+
+/**
+ * Update timestamp when node have to be processed
+ */
+void gatewaySchedulerSchedule(
+    const uint8_t nodeIndex,
+    const uint32_t due
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    uint8_t position = _gateway_scheduler_heap_position[nodeIndex];
+
+    bool earlier = _gatewaySchedulerIsBefore(due, _gateway_scheduler_heap[position].due);
+
+    _gateway_scheduler_heap[position].due = due;
+
+    if (earlier) {
+        _gatewaySchedulerSiftUp(position);
+
+    } else {
+        _gatewaySchedulerSiftDown(position);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Node have to be processed as soon as possible, eg. node replied to request
+ */
+void gatewaySchedulerWake(
+    const uint8_t nodeIndex
+) {
+    gatewaySchedulerSchedule(nodeIndex, millis());
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Get index of the most overdue node or INDEX_NONE when no node is due
+ */
+uint8_t gatewaySchedulerGetDueNode(
+    const uint32_t time
+) {
+    if (_gatewaySchedulerIsBefore(time, _gateway_scheduler_heap[0].due)) {
+        return INDEX_NONE;
+    }
+
+    return _gateway_scheduler_heap[0].node_index;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Queue node for requested job of given priority class
+ */
+bool gatewaySchedulerRequest(
+    const uint8_t nodeIndex,
+    const uint8_t priority
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return false;
+    }
+
+    // Timed classes are served by heap
+    if (priority >= GATEWAY_PRIORITY_REQUESTED) {
+        gatewaySchedulerWake(nodeIndex);
+
+        return true;
+    }
+
+    for (uint8_t i = 0; i < _gateway_scheduler_requests_count[priority]; i++) {
+        // Node is already waiting, its job will be served with pending one
+        if (_gateway_scheduler_requests[priority][(_gateway_scheduler_requests_head[priority] + i) % FB_GATEWAY_REQUESTS_QUEUE_SIZE] == nodeIndex) {
+            return true;
+        }
+    }
+
+    if (_gateway_scheduler_requests_count[priority] >= FB_GATEWAY_REQUESTS_QUEUE_SIZE) {
+        DEBUG_MSG(PSTR("[ERR][GATEWAY][SCHEDULER] Requests queue of priority: %d is full\n"), priority);
+
+        return false;
+    }
+
+    _gateway_scheduler_requests[priority][(_gateway_scheduler_requests_head[priority] + _gateway_scheduler_requests_count[priority]) % FB_GATEWAY_REQUESTS_QUEUE_SIZE] = nodeIndex;
+    _gateway_scheduler_requests_count[priority]++;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Get the first node waiting in requested priority class or INDEX_NONE
+ */
+uint8_t gatewaySchedulerGetRequestedNode(
+    const uint8_t priority
+) {
+    // Validate priority class
+    if (priority >= GATEWAY_PRIORITY_REQUESTED) {
+        return INDEX_NONE;
+    }
+
+    if (_gateway_scheduler_requests_count[priority] == 0) {
+        return INDEX_NONE;
+    }
+
+    uint8_t node_index = _gateway_scheduler_requests[priority][_gateway_scheduler_requests_head[priority]];
+
+    _gateway_scheduler_requests_head[priority] = (_gateway_scheduler_requests_head[priority] + 1) % FB_GATEWAY_REQUESTS_QUEUE_SIZE;
+    _gateway_scheduler_requests_count[priority]--;
+
+    return node_index;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if some node is waiting for requested job
+ */
+bool gatewaySchedulerHasRequests()
+{
+    for (uint8_t i = 0; i < GATEWAY_PRIORITY_REQUESTED; i++) {
+        if (_gateway_scheduler_requests_count[i] > 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Registers space have to be read out of polling order
+ */
+bool gatewaySchedulerQueryRegister(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return false;
+    }
+
+    // Validate register type index
+    if (dataRegister >= GATEWAY_REGISTER_MAX) {
+        return false;
+    }
+
+    _gateway_nodes[nodeIndex].polling.requested |= (1 << dataRegister);
+
+    return gatewaySchedulerRequest(nodeIndex, GATEWAY_PRIORITY_QUERY);
+}
+
+// -----------------------------------------------------------------------------
+
+void gatewaySchedulerSetPollInterval(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint16_t interval
+) {
+    // Not used slot could not be changed
+    if (!gatewayIsNodeAllocated(nodeIndex)) {
+        return;
+    }
+
+    // Validate register type index
+    if (dataRegister >= GATEWAY_REGISTER_MAX) {
+        return;
+    }
+
+    _gateway_nodes_details[nodeIndex]->poll_interval[dataRegister] = interval;
+}
+
+// -----------------------------------------------------------------------------
+
+uint16_t gatewaySchedulerGetPollInterval(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return FB_GATEWAY_IDLE_INTERVAL;
+    }
+
+    // Validate register type index
+    if (dataRegister >= GATEWAY_REGISTER_MAX) {
+        return FB_GATEWAY_IDLE_INTERVAL;
+    }
+
+    return _gateway_nodes_details[nodeIndex]->poll_interval[dataRegister];
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Whole registers space was requested, plan its next reading
+ */
+void gatewaySchedulerMarkRegisterPolled(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    // Validate register type index
+    if (dataRegister >= GATEWAY_REGISTER_MAX) {
+        return;
+    }
+
+    _gateway_nodes[nodeIndex].polling.due[dataRegister] = millis() + _gateway_nodes_details[nodeIndex]->poll_interval[dataRegister];
+    _gateway_nodes[nodeIndex].polling.requested &= ~(1 << dataRegister);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Node replied with whole registers space, its polling interval is adapted by changes found in reply
+ */
+void gatewaySchedulerMarkRegisterRead(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister
+) {
+    #if FB_GATEWAY_POLL_ADAPTIVE
+        // Not used slot has no polling
+        if (!gatewayIsNodeAllocated(nodeIndex)) {
+            return;
+        }
+
+        // Validate register type index
+        if (dataRegister >= GATEWAY_REGISTER_MAX) {
+            return;
+        }
+
+        _gatewaySchedulerAdaptPollInterval(nodeIndex, dataRegister);
+
+        // Next reading is planned with adapted interval
+        _gateway_nodes[nodeIndex].polling.due[dataRegister] = millis() + _gateway_nodes_details[nodeIndex]->poll_interval[dataRegister];
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Value in registers space was changed, space is polled with the fastest interval again
+ */
+void gatewaySchedulerMarkRegisterChanged(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    // Validate register type index
+    if (dataRegister >= GATEWAY_REGISTER_MAX) {
+        return;
+    }
+
+    _gateway_nodes[nodeIndex].polling.changed |= (1 << dataRegister);
+
+    #if FB_GATEWAY_POLL_ADAPTIVE
+        uint16_t fastest = _gatewaySchedulerDefaultPollInterval(dataRegister);
+
+        if (_gateway_nodes_details[nodeIndex]->poll_interval[dataRegister] <= fastest) {
+            return;
+        }
+
+        _gateway_nodes_details[nodeIndex]->poll_interval[dataRegister] = fastest;
+
+        uint32_t due = millis() + fastest;
+
+        if (!_gatewaySchedulerIsBefore(due, _gateway_nodes[nodeIndex].polling.due[dataRegister])) {
+            return;
+        }
+
+        _gateway_nodes[nodeIndex].polling.due[dataRegister] = due;
+
+        // Node waiting in heap for slower space is planned earlier, node waiting for reply is planned by reply
+        if (
+            gatewayCommunicationGetPacketWaitingFor(nodeIndex) == GATEWAY_PACKET_NONE
+            && _gatewaySchedulerIsBefore(due, _gateway_scheduler_heap[_gateway_scheduler_heap_position[nodeIndex]].due)
+        ) {
+            gatewaySchedulerSchedule(nodeIndex, due);
+        }
+    #endif
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Get the most overdue registers space of node or GATEWAY_REGISTER_NONE when no space is due
+ */
+uint8_t gatewaySchedulerGetDueRegister(
+    const uint8_t nodeIndex,
+    const uint32_t time
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return GATEWAY_REGISTER_NONE;
+    }
+
+    uint8_t result = GATEWAY_REGISTER_NONE;
+
+    // Queried spaces are read before polled ones
+    for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+        if (
+            gatewayRegistersSize(nodeIndex, i) > 0
+            && (_gateway_nodes[nodeIndex].polling.requested & (1 << i))
+        ) {
+            return i;
+        }
+    }
+
+    for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+        if (
+            gatewayRegistersSize(nodeIndex, i) > 0
+            && !_gatewaySchedulerIsBefore(time, _gateway_nodes[nodeIndex].polling.due[i])
+            && (
+                result == GATEWAY_REGISTER_NONE
+                || _gatewaySchedulerIsBefore(_gateway_nodes[nodeIndex].polling.due[i], _gateway_nodes[nodeIndex].polling.due[result])
+            )
+        ) {
+            result = i;
+        }
+    }
+
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Check if registers space of node is queried or its polling is due
+ */
+bool gatewaySchedulerIsRegisterDue(
+    const uint8_t nodeIndex,
+    const uint8_t dataRegister,
+    const uint32_t time
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return false;
+    }
+
+    // Validate register type index
+    if (dataRegister >= GATEWAY_REGISTER_MAX || gatewayRegistersSize(nodeIndex, dataRegister) == 0) {
+        return false;
+    }
+
+    return (_gateway_nodes[nodeIndex].polling.requested & (1 << dataRegister))
+        || !_gatewaySchedulerIsBefore(time, _gateway_nodes[nodeIndex].polling.due[dataRegister]);
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Get timestamp when the first registers space of node have to be polled
+ */
+uint32_t gatewaySchedulerGetNextPollingDue(
+    const uint8_t nodeIndex,
+    const uint32_t time
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return time + FB_GATEWAY_IDLE_INTERVAL;
+    }
+
+    uint32_t due = time + FB_GATEWAY_IDLE_INTERVAL;
+
+    if (
+        gatewayInitializationIsNodeInitialized(nodeIndex) == false
+        || gatewayIsNodeReady(nodeIndex) == false
+    ) {
+        return due;
+    }
+
+    // Queried spaces are waiting for reading
+    if (_gateway_nodes[nodeIndex].polling.requested != 0) {
+        return time;
+    }
+
+    for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+        if (
+            gatewayRegistersSize(nodeIndex, i) > 0
+            && _gatewaySchedulerIsBefore(_gateway_nodes[nodeIndex].polling.due[i], due)
+        ) {
+            due = _gateway_nodes[nodeIndex].polling.due[i];
+        }
+    }
+
+    // Overdue spaces are processed immediately
+    if (_gatewaySchedulerIsBefore(due, time)) {
+        return time;
+    }
+
+    return due;
+}
+
+// -----------------------------------------------------------------------------
+
+void gatewaySchedulerReset(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    uint32_t time = millis();
+
+    for (uint8_t i = 0; i < GATEWAY_REGISTER_MAX; i++) {
+        _gateway_nodes[nodeIndex].polling.due[i] = time;
+
+        // Not used slot shares details placeholder
+        if (gatewayIsNodeAllocated(nodeIndex)) {
+            _gateway_nodes_details[nodeIndex]->poll_interval[i] = _gatewaySchedulerDefaultPollInterval(i);
+        }
+    }
+
+    _gateway_nodes[nodeIndex].polling.requested = 0;
+    _gateway_nodes[nodeIndex].polling.changed = 0;
+
+    gatewaySchedulerSchedule(nodeIndex, time);
+}
+
+// -----------------------------------------------------------------------------
+// MODULE: SUB-MODULE CORE
+// -----------------------------------------------------------------------------
+
+void gatewaySchedulerSetup()
+{
+    uint32_t time = millis();
+
+    // All node slots are due at once, heap property is satisfied
+    for (uint8_t i = 0; i < FB_GATEWAY_MAX_NODES; i++) {
+        _gateway_scheduler_heap[i].due = time;
+        _gateway_scheduler_heap[i].node_index = i;
+
+        _gateway_scheduler_heap_position[i] = i;
+
+        // Polling intervals are set when node is allocated into slot
+        for (uint8_t j = 0; j < GATEWAY_REGISTER_MAX; j++) {
+            _gateway_nodes[i].polling.due[j] = time;
+        }
+    }
+}
+
+#endif // FB_GATEWAY_SUPPORT
@@ -49,17 +49,28 @@ void gatewayStorageAddNode(
 
     uint8_t index = 0;
 
-    gateway_node_t node = gatewayGetNode(nodeIndex);
+    const gateway_node_details_t & node = gatewayGetNodeDetails(nodeIndex);
+
+    JsonObject * previous_node = NULL;
 
     for (JsonObject& stored_node : registered_nodes) {
-        if (stored_node["address"] == (nodeIndex + 1)) {
-            registered_nodes.remove(index);
+        if (stored_node["address"] == gatewayAddressingGet(nodeIndex)) {
+            // Registers settings are kept only for the same node
+            if (
+                stored_node.containsKey("serial_number")
+                && strcmp(stored_node["serial_number"].as<const char *>(), node.serial_number) == 0
+            ) {
+                previous_node = &stored_node;
+
+            } else {
+                registered_nodes.remove(index);
+            }
         }
 
         index++;
     }
 
-    JsonObject& storage_node = registered_nodes.createNestedObject();
+    JsonObject& storage_node = previous_node != NULL ? *previous_node : registered_nodes.createNestedObject();
 
     if (!storage_node.success()) {
         DEBUG_MSG(PSTR("[ERR][GATEWAY][STORAGE] Could not create configuration schema for storing.\n"));
@@ -67,7 +78,7 @@ void gatewayStorageAddNode(
         return;
     }
 
-    storage_node["address"] = nodeIndex + 1;
+    storage_node["address"] = gatewayAddressingGet(nodeIndex);
     storage_node["serial_number"] = node.serial_number;
 
     JsonObject& hardware_info = storage_node.createNestedObject("hardware");
@@ -108,7 +119,7 @@ void gatewayStorageRemoveNode(
     uint8_t index = 0;
 
     for (JsonObject& stored_node : registered_nodes) {
-        if (stored_node["address"] == (nodeIndex + 1)) {
+        if (stored_node["address"] == gatewayAddressingGet(nodeIndex)) {
             registered_nodes.remove(index);
 
             removed = true;
@@ -128,6 +139,98 @@ void gatewayStorageRemoveNode(
 
 // -----------------------------------------------------------------------------
 
+/**
+ * Store registers own deadbands into node entry
+ */
+void gatewayStorageStoreDeadbands(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    DynamicJsonBuffer jsonBuffer;
+
+    JsonArray& registered_nodes = jsonBuffer.parseArray(gatewayStorageReadConfiguration().c_str());
+
+    for (JsonObject& stored_node : registered_nodes) {
+        if (stored_node["address"] != gatewayAddressingGet(nodeIndex)) {
+            continue;
+        }
+
+        JsonArray& deadbands = stored_node.createNestedArray("deadbands");
+
+        for (uint8_t data_register = GATEWAY_REGISTER_AI; data_register <= GATEWAY_REGISTER_AO; data_register++) {
+            for (uint8_t address = 0; address < gatewayRegistersSize(nodeIndex, data_register); address++) {
+                if (!gatewayDeadbandsIsOverridden(nodeIndex, data_register, address)) {
+                    continue;
+                }
+
+                const gateway_register_deadband_t * settings = gatewayDeadbandsGet(nodeIndex, data_register, address);
+
+                JsonObject& deadband = deadbands.createNestedObject();
+
+                deadband["register"] = data_register;
+                deadband["address"] = address;
+                deadband["absolute"] = settings->absolute;
+                deadband["percent"] = settings->percent;
+                deadband["min_interval"] = settings->min_interval;
+                deadband["max_interval"] = settings->max_interval;
+            }
+        }
+
+        String output;
+
+        registered_nodes.printTo(output);
+
+        storageWriteConfiguration(_gateway_storage_config_filename, output);
+
+        return;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/**
+ * Apply registers own deadbands stored in node entry
+ */
+void gatewayStorageLoadDeadbands(
+    const uint8_t nodeIndex
+) {
+    // Validate node index
+    if (nodeIndex >= FB_GATEWAY_MAX_NODES) {
+        return;
+    }
+
+    DynamicJsonBuffer jsonBuffer;
+
+    JsonArray& registered_nodes = jsonBuffer.parseArray(gatewayStorageReadConfiguration().c_str());
+
+    for (JsonObject& stored_node : registered_nodes) {
+        if (stored_node["address"] != gatewayAddressingGet(nodeIndex) || !stored_node.containsKey("deadbands")) {
+            continue;
+        }
+
+        for (JsonObject& deadband : stored_node["deadbands"].as<JsonArray&>()) {
+            gateway_register_deadband_t settings;
+
+            settings.absolute = deadband["absolute"].as<float>();
+            settings.percent = deadband["percent"].as<uint8_t>();
+            settings.min_interval = deadband["min_interval"].as<uint16_t>();
+            settings.max_interval = deadband["max_interval"].as<uint32_t>();
+
+            if (!gatewayDeadbandsSet(nodeIndex, deadband["register"].as<uint8_t>(), deadband["address"].as<uint8_t>(), settings)) {
+                DEBUG_MSG(PSTR("[WARN][GATEWAY][STORAGE] Stored deadband for register: %d is not valid\n"), deadband["address"].as<uint8_t>());
+            }
+        }
+
+        return;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 bool gatewayStorageRestoreFromJson(
     JsonObject& data
 ) {
@@ -176,7 +279,26 @@ void gatewayStorageSetup()
 
     // Load all nodes definition stored in memory
     for (JsonObject& stored_node : registered_nodes) {
-        uint8_t nodeIndex = (stored_node["address"].as<unsigned int>() - 1);
+        unsigned int address = stored_node["address"].as<unsigned int>();
+
+        // Validate stored address
+        if (
+            address == PJON_NOT_ASSIGNED
+            || address > FB_GATEWAY_MAX_ADDRESS
+            || gatewayAddressingGetNodeIndex(address) != INDEX_NONE
+        ) {
+            DEBUG_MSG(PSTR("[WARN][GATEWAY][STORAGE] Stored node address: %d is not valid\n"), address);
+
+            continue;
+        }
+
+        uint8_t nodeIndex = gatewayAllocateNode();
+
+        if (nodeIndex == INDEX_NONE) {
+            DEBUG_MSG(PSTR("[WARN][GATEWAY][STORAGE] Nodes registry is full. Other stored nodes could not be loaded.\n"));
+
+            break;
+        }
 
         gatewaySetSerialNumber(nodeIndex, stored_node["serial_number"].as<char *>());
 
@@ -194,7 +316,7 @@ void gatewayStorageSetup()
         gatewaySetFirmwareManufacturer(nodeIndex, firmware["manufacturer"].as<char *>());
         gatewaySetFirmwareVersion(nodeIndex, firmware["version"].as<char *>());
 
-        gatewayAddressingSet(nodeIndex, stored_node["address"].as<unsigned int>());
+        gatewayAddressingSet(nodeIndex, address);
         gatewayInitializationReset(nodeIndex);
         gatewayCommunicationReset(nodeIndex);
         gatewayRegistersReset(nodeIndex);
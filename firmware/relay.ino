@@ -535,7 +535,7 @@ uint8_t _relayParsePayload(
 
                                     fastybirdCallReportChannelConfiguration(_relays[i].channel_index, configuration);
 
-                                    fastybird_channel_t channel = fastybirdGetChannel(_relays[i].channel_index);
+                                    const fastybird_channel_t & channel = fastybirdGetChannel(_relays[i].channel_index);
 
                                     if (configuration.size() > 0) {
                                         fastybirdApiPropagateChannelConfiguration(channel.name.c_str(), configuration);
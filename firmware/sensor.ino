@@ -837,7 +837,7 @@ bool _sensorHasMagnitude(
         const uint8_t channelIndex,
         const uint8_t propertyIndex
     ) {
-        fastybird_property_t property = fastybirdGetProperty(propertyIndex);
+        const fastybird_property_t & property = fastybirdGetProperty(propertyIndex);
 
         for (uint8_t i = 0; i < _sensors.size(); i++) {
             // Get sensor info from register
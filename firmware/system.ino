@@ -11,6 +11,9 @@ uint32_t _system_loop_delay = 0;
 // Calculated load average 0 to 100;
 uint16_t _system_load_average = 100;
 
+// Calculated main loop iterations per second
+uint32_t _system_loop_rate = 0;
+
 extern "C" uint32_t _SPIFFS_start;
 extern "C" uint32_t _SPIFFS_end;
 
@@ -94,6 +97,7 @@ void _systemInfoOnHeartbeat()
 
     DEBUG_MSG(PSTR("[INFO][SYSTEM] Uptime: %lu seconds\n"), uptime_seconds);
     DEBUG_MSG(PSTR("[INFO][SYSTEM] Free heap: %lu bytes\n"), free_heap);
+    DEBUG_MSG(PSTR("[INFO][SYSTEM] Loop rate: %lu loops/s\n"), systemLoopRate());
 
     #if ADC_MODE_VALUE == ADC_VCC
         DEBUG_MSG(PSTR("[INFO][SYSTEM] Power: %lu mV\n"), ESP.getVcc());
@@ -110,6 +114,7 @@ void _systemInfoOnHeartbeat()
         root["uptime"] = getUptime();
         root["rssi"] = WiFi.RSSI();
         root["load_average"] = systemLoadAverage();
+        root["loop_rate"] = systemLoopRate();
 
         #if ADC_MODE_VALUE == ADC_VCC
             root["vcc"] = ESP.getVcc();
@@ -396,6 +401,13 @@ uint32_t systemLoadAverage()
     return _system_load_average;
 }
 
+// -----------------------------------------------------------------------------
+
+uint32_t systemLoopRate()
+{
+    return _system_loop_rate;
+}
+
 // -----------------------------------------------------------------------------
 // MODULE CORE
 // -----------------------------------------------------------------------------
@@ -489,6 +501,21 @@ void systemLoop()
         last_loadcheck = millis();
     }
 
+    // -------------------------------------------------------------------------
+    // Loop rate calculation
+    // -------------------------------------------------------------------------
+
+    static uint32_t last_ratecheck = 0;
+    static uint32_t rate_counter = 0;
+    rate_counter++;
+
+    if (millis() - last_ratecheck >= LOOPRATE_INTERVAL) {
+        _system_loop_rate = (1000 * rate_counter) / (millis() - last_ratecheck);
+
+        rate_counter = 0;
+        last_ratecheck = millis();
+    }
+
     // -------------------------------------------------------------------------
     // Power saving delay
     // -------------------------------------------------------------------------